@@ -0,0 +1,168 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Botnet-hullám tiltása: egyenkénti bpf_map_update_elem vs. BlockQueue (bpf_map_update_batch)
+//
+// Használat: block_queue_bench [burst=10000] [deadline_ms=5]
+//
+// A blacklist_map / blacklist6_map mintájára létrehozott LRU_HASH mapeken (a BPF objektum nem kell):
+// 1. "előtte": burst darab IPv4 egyenként, hívásonként egy syscall.
+// 2. "utána": ugyanennyi cím a BlockQueue-n át (10% ismétlődéssel, ahogy a VisualMemory
+//    strike-jai is többször jelezhetnek); az idő a kiírás befejezéséig mérve.
+//    Golden: minden cím a mapben, applied + coalesced = a bejegyzések, flush-enként ceil(k / MAX_BATCH) syscall.
+// 3. feloldás: a felét unblock() (plusz sosem tiltott címek, ENOENT), a map pontosan a másik felét tartja.
+// 4. IPv6: burst / 10 cím a blacklist6_map mintájú mapbe.
+// Root (CAP_BPF / CAP_SYS_ADMIN) kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <bpf/bpf.h>
+
+#include "veth_frames.hpp"
+#include "core/NetAddress.hpp"
+#include "core/ebpf/BlockQueue.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    // 10.x.y.z, a sorszámból (hálózati bájtsorrend)
+    uint32_t botV4(size_t i) {
+        return htonl(0x0a000000u | static_cast<uint32_t>(i + 1));
+    }
+
+    NetAddress botV6(size_t i) {
+        uint8_t raw[16] = {0x20, 0x01, 0x0d, 0xb8};
+        uint32_t n = htonl(static_cast<uint32_t>(i + 1));
+        std::memcpy(raw + 12, &n, 4);
+        return NetAddress::fromV6(raw);
+    }
+
+    size_t countEntries(int fd, size_t keySize) {
+        std::vector<uint8_t> key(keySize), next(keySize);
+        size_t n = 0;
+        const void* cur = nullptr;
+        while (bpf_map_get_next_key(fd, cur, next.data()) == 0) {
+            key.swap(next);
+            cur = key.data();
+            n++;
+        }
+        return n;
+    }
+
+    bool contains4(int fd, uint32_t ip) {
+        uint8_t v = 0;
+        return bpf_map_lookup_elem(fd, &ip, &v) == 0 && v == 1;
+    }
+
+    double usSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t burst = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    auto deadline = std::chrono::milliseconds((argc > 2) ? std::atoi(argv[2]) : 5);
+    if (burst == 0 || burst > VENOM_BLACKLIST_MAX) burst = 10000;
+
+    auto makeMaps = [](int& fd4, int& fd6) {
+        fd4 = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "blacklist_map", sizeof(uint32_t), sizeof(uint8_t),
+                             VENOM_BLACKLIST_MAX, nullptr);
+        fd6 = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "blacklist6_map", sizeof(venom_in6), sizeof(uint8_t),
+                             VENOM_BLACKLIST6_MAX, nullptr);
+        return fd4 >= 0 && fd6 >= 0;
+    };
+
+    int fd4 = -1, fd6 = -1;
+    if (!makeMaps(fd4, fd6)) {
+        std::printf("block_queue_bench: skipped (BPF map nem hozható létre: root kell)\n");
+        return 0;
+    }
+    int failures = 0;
+
+    // --- 1. előtte: egyenkénti update ---
+    auto t0 = Clock::now();
+    uint8_t one = 1;
+    for (size_t i = 0; i < burst; ++i) {
+        uint32_t ip = botV4(i);
+        bpf_map_update_elem(fd4, &ip, &one, BPF_ANY);
+    }
+    double elemUs = usSince(t0);
+    size_t elemEntries = countEntries(fd4, sizeof(uint32_t));
+    close(fd4);
+    close(fd6);
+
+    // --- 2. utána: BlockQueue ---
+    if (!makeMaps(fd4, fd6)) return 1;
+    BlockQueue queue;
+    queue.start(fd4, fd6, deadline);
+
+    const size_t repeats = burst / 10;
+    t0 = Clock::now();
+    for (size_t i = 0; i < burst; ++i) queue.block(NetAddress::fromV4(botV4(i)));
+    for (size_t i = 0; i < repeats; ++i) queue.block(NetAddress::fromV4(botV4(i * 7 % burst)));
+    double enqueueUs = usSince(t0);
+    waitFor([&] { return queue.pending() == 0 && queue.stats().applied >= burst; });
+    double batchUs = usSince(t0);
+    BlockQueueStats st = queue.stats();
+
+    // Flush-enként ceil(k / MAX_BATCH) batch hívás
+    const uint64_t maxSyscalls = st.flushes + burst / BlockQueue::MAX_BATCH;
+    std::printf("%zu IPv4 tiltás (határidő %lld ms):\n", burst, static_cast<long long>(deadline.count()));
+    std::printf("  %-34s %10.0f us  %8zu syscall\n", "előtte: bpf_map_update_elem", elemUs, burst);
+    std::printf("  %-34s %10.0f us  %8llu syscall (%llu flush)\n", "utána: BlockQueue, kiírásig", batchUs,
+                static_cast<unsigned long long>(st.syscalls), static_cast<unsigned long long>(st.flushes));
+    std::printf("  %-34s %10.0f us  (%.0f ns/cím, a hívó oldalon)\n", "ebből bejegyzés", enqueueUs,
+                enqueueUs * 1000.0 / static_cast<double>(burst + repeats));
+
+    size_t missing = 0;
+    for (size_t i = 0; i < burst; ++i) missing += contains4(fd4, botV4(i)) ? 0 : 1;
+    std::printf("golden:\n");
+    failures += check("per-elem entries", elemEntries, burst);
+    failures += check("batch entries", countEntries(fd4, sizeof(uint32_t)), burst);
+    failures += check("missing", missing, 0);
+    failures += check("queued", st.queued, burst + repeats);
+    // Az ismétlés vagy még a sorban vonódik össze, vagy egy későbbi flush írja újra
+    failures += check("applied + coalesced", st.applied + st.coalesced, burst + repeats);
+    failures += check("failed", st.failed, 0);
+    bool fewSyscalls = st.syscalls <= maxSyscalls;
+    std::printf("  %-22s %8llu  (<= %llu)%s\n", "syscalls", static_cast<unsigned long long>(st.syscalls),
+                static_cast<unsigned long long>(maxSyscalls), fewSyscalls ? "" : "  MISMATCH");
+    if (!fewSyscalls) failures++;
+
+    // --- 3. feloldás: páros sorszámok + sosem tiltott címek (ENOENT a batch közepén) ---
+    BlockQueueStats before = queue.stats();
+    for (size_t i = 0; i < burst; i += 2) queue.unblock(NetAddress::fromV4(botV4(i)));
+    for (size_t i = 0; i < 16; ++i) queue.unblock(NetAddress::fromV4(htonl(0xc0a80000u | static_cast<uint32_t>(i))));
+    queue.flush();
+    BlockQueueStats after = queue.stats();
+    size_t wrong = 0;
+    for (size_t i = 0; i < burst; ++i) wrong += contains4(fd4, botV4(i)) == (i % 2 == 1) ? 0 : 1;
+    std::printf("feloldás (%zu + 16 ismeretlen): %llu syscall\n", (burst + 1) / 2,
+                static_cast<unsigned long long>(after.syscalls - before.syscalls));
+    failures += check("remaining entries", countEntries(fd4, sizeof(uint32_t)), burst / 2);
+    failures += check("wrong state", wrong, 0);
+    failures += check("unblocked", after.applied - before.applied, (burst + 1) / 2);
+    failures += check("failed", after.failed, 0);
+
+    // --- 4. IPv6 ---
+    const size_t burst6 = burst / 10 ? burst / 10 : 1;
+    before = queue.stats();
+    for (size_t i = 0; i < burst6; ++i) queue.block(botV6(i));
+    queue.flush();
+    after = queue.stats();
+    std::printf("IPv6: %zu cím, %llu syscall\n", burst6,
+                static_cast<unsigned long long>(after.syscalls - before.syscalls));
+    failures += check("v6 entries", countEntries(fd6, sizeof(venom_in6)), burst6);
+
+    queue.stop();
+    close(fd4);
+    close(fd6);
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Wanted-szűrő: 1M std::atomic<bool> + két polinomiális string-hash (a régi VisualMemory) vs. BloomFilter
+//
+// Használat: bloom_filter_bench [items=100000] [fpr=0.01] [queries=1000000]
+//
+// 1. hamis pozitív arány: items cím bekerül (90% IPv4, 10% IPv6), majd queries soha be
+//    nem tett cím lekérdezése. A régi út a pontozott szöveget hash-eli (ahogy a hívók
+//    adták), az új a NetAddress 16 bájtját. Golden: nincs hamis negatív, az új szűrő
+//    mért aránya <= 1.5 * fpr.
+// 2. lekérdezés ns/op tagokra és nem tagokra (5 menet legjobbja), illetve a törlés ideje.
+// 3. forgatás: items kapacitás mellett A, majd B halmaz (items-items cím). Golden: A után
+//    A mind bent van; B után B mind bent van, A a hamis pozitív szintre esik; clear után
+//    B is.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "veth_frames.hpp"
+#include "core/BloomFilter.hpp"
+#include "core/NetAddress.hpp"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    // A régi VisualMemory szűrője változatlanul (szöveges kulccsal, ahogy a user-019 előtt)
+    struct LegacyBloom {
+        static const size_t BIT_SIZE = 1024 * 1024;
+        std::vector<std::atomic<bool>> bit_array;
+
+        LegacyBloom() : bit_array(BIT_SIZE) {
+            for (size_t i = 0; i < BIT_SIZE; ++i) bit_array[i].store(false);
+        }
+        static size_t hash1(const std::string& key) {
+            size_t h = 0;
+            for (char c : key) h = h * 31 + c;
+            return h % BIT_SIZE;
+        }
+        static size_t hash2(const std::string& key) {
+            size_t h = 7;
+            for (char c : key) h = h * 37 + c;
+            return h % BIT_SIZE;
+        }
+        void insert(const std::string& ip) {
+            bit_array[hash1(ip)].store(true, std::memory_order_release);
+            bit_array[hash2(ip)].store(true, std::memory_order_release);
+        }
+        bool contains(const std::string& ip) const {
+            if (!bit_array[hash1(ip)].load(std::memory_order_acquire)) return false;
+            if (!bit_array[hash2(ip)].load(std::memory_order_acquire)) return false;
+            return true;
+        }
+        void clear() {
+            for (size_t i = 0; i < BIT_SIZE; ++i) bit_array[i].store(false);
+        }
+    };
+
+    // Minden 10. cím IPv6 (2001:db8::/64 alatt), a többi 10.x.y.z
+    NetAddress source(size_t i) {
+        if (i % 10 == 9) {
+            uint8_t raw[16] = {0x20, 0x01, 0x0d, 0xb8};
+            uint64_t n = i + 1;
+            std::memcpy(raw + 8, &n, 8);
+            return NetAddress::fromV6(raw);
+        }
+        return NetAddress::fromV4(htonl(0x0a000000u | static_cast<uint32_t>(i + 1)));
+    }
+
+    double nsSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    }
+
+    template <typename Set, typename Key>
+    size_t countHits(const Set& set, const std::vector<Key>& keys) {
+        size_t hits = 0;
+        for (const auto& k : keys) hits += set.contains(k) ? 1 : 0;
+        return hits;
+    }
+
+    constexpr int LOOKUP_PASSES = 5;
+
+    // Lekérdezés ns/op, a legjobb menet (a VM zajos); a találatok számát a fordító nem dobhatja el
+    template <typename Set, typename Key>
+    double lookupNs(const Set& set, const std::vector<Key>& keys, size_t& sink) {
+        double best = 0;
+        for (int pass = 0; pass < LOOKUP_PASSES; ++pass) {
+            auto t0 = Clock::now();
+            sink += countHits(set, keys);
+            const double ns = nsSince(t0) / static_cast<double>(keys.size());
+            if (pass == 0 || ns < best) best = ns;
+        }
+        return best;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t items = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    double fpr = (argc > 2) ? std::atof(argv[2]) : 0.01;
+    size_t queries = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+    if (items == 0) items = 100000;
+    if (!(fpr > 0 && fpr < 1)) fpr = 0.01;
+    if (queries == 0) queries = 1000000;
+    int failures = 0;
+    size_t sink = 0;
+
+    std::vector<NetAddress> members(items), strangers(queries);
+    std::vector<std::string> memberTexts(items), strangerTexts(queries);
+    for (size_t i = 0; i < items; ++i) {
+        members[i] = source(i);
+        memberTexts[i] = members[i].toString();
+    }
+    for (size_t i = 0; i < queries; ++i) {
+        strangers[i] = source(items + i);
+        strangerTexts[i] = strangers[i].toString();
+    }
+
+    // --- 1. hamis pozitív arány ---
+    LegacyBloom legacy;
+    for (const auto& t : memberTexts) legacy.insert(t);
+    // Kapacitás items + 1: a mérés alatt ne forgasson
+    BloomFilter bloom(items + 1, fpr);
+    for (const auto& a : members) bloom.insert(a);
+
+    const size_t legacyFalseNeg = items - countHits(legacy, memberTexts);
+    const size_t bloomFalseNeg = items - countHits(bloom, members);
+    const size_t legacyFalsePos = countHits(legacy, strangerTexts);
+    const size_t bloomFalsePos = countHits(bloom, strangers);
+    const double legacyFpr = static_cast<double>(legacyFalsePos) / queries;
+    const double bloomFpr = static_cast<double>(bloomFalsePos) / queries;
+
+    std::printf("%zu cím a szűrőben, %zu idegen lekérdezés, cél fpr %.4f:\n", items, queries, fpr);
+    std::printf("  %-44s fpr %.5f  %8.2f MiB\n", "előtte: 1M atomic<bool>, h*31 / h*37 szövegen", legacyFpr,
+                LegacyBloom::BIT_SIZE / (1024.0 * 1024));
+    std::printf("  %-44s fpr %.5f  %8.2f MiB  (k=%u, %zu blokk, 2 generáció)\n", "utána: BloomFilter", bloomFpr,
+                bloom.memoryBytes() / (1024.0 * 1024), bloom.hashCount(), bloom.blockCount());
+
+    // --- 2. lekérdezés és törlés ---
+    const double legacyHitNs = lookupNs(legacy, memberTexts, sink);
+    const double legacyMissNs = lookupNs(legacy, strangerTexts, sink);
+    const double bloomHitNs = lookupNs(bloom, members, sink);
+    const double bloomMissNs = lookupNs(bloom, strangers, sink);
+    std::printf("lekérdezés (ns/op):            tag      idegen\n");
+    std::printf("  %-28s %7.1f  %9.1f\n", "előtte", legacyHitNs, legacyMissNs);
+    std::printf("  %-28s %7.1f  %9.1f\n", "utána", bloomHitNs, bloomMissNs);
+
+    auto t0 = Clock::now();
+    legacy.clear();
+    const double legacyClearUs = nsSince(t0) / 1000;
+    t0 = Clock::now();
+    bloom.clear();
+    const double bloomClearUs = nsSince(t0) / 1000;
+    std::printf("törlés: előtte %.0f us, utána %.0f us\n", legacyClearUs, bloomClearUs);
+
+    std::printf("golden:\n");
+    failures += check("legacy false negatives", legacyFalseNeg, 0);
+    failures += check("bloom false negatives", bloomFalseNeg, 0);
+    failures += check("bloom fpr <= 1.5 * target", bloomFpr <= 1.5 * fpr ? 1 : 0, 1);
+    failures += check("timed lookup hits", sink, LOOKUP_PASSES * (2 * items + legacyFalsePos + bloomFalsePos));
+    failures += check("bloom empty after clear", countHits(bloom, members) <= 1.5 * fpr * items ? 1 : 0, 1);
+
+    // --- 3. forgatás ---
+    BloomFilter rotating(items, fpr);
+    std::vector<NetAddress> setB(items);
+    for (size_t i = 0; i < items; ++i) setB[i] = source(items + queries + i);
+    const size_t falseLimit = static_cast<size_t>(1.5 * fpr * items) + 1;
+
+    for (const auto& a : members) rotating.insert(a);
+    std::printf("forgatás (kapacitás %zu):\n", items);
+    failures += check("rotations after A", rotating.rotations(), 1);
+    failures += check("A kept", countHits(rotating, members), items);
+    for (const auto& b : setB) rotating.insert(b);
+    failures += check("rotations after B", rotating.rotations(), 2);
+    failures += check("B kept", countHits(rotating, setB), items);
+    failures += check("A expired", countHits(rotating, members) <= falseLimit ? 1 : 0, 1);
+    rotating.clear();
+    failures += check("B cleared", countHits(rotating, setB) <= falseLimit ? 1 : 0, 1);
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Kézzel összerakott BPF programok a benchmarkokhoz (clang nélkül is betölthető kernelek)
+//
+// Az Asm címkékkel kezeli az előre ugrásokat; a map hivatkozás ld_imm64 + BPF_PSEUDO_MAP_FD.
+
+#ifndef VENOM_BENCH_BPF_ASM_HPP
+#define VENOM_BENCH_BPF_ASM_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <linux/bpf.h>
+
+namespace VenomBench {
+
+    inline bpf_insn insn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+        bpf_insn i{};
+        i.code = code;
+        i.dst_reg = dst & 0xf;
+        i.src_reg = src & 0xf;
+        i.off = off;
+        i.imm = imm;
+        return i;
+    }
+
+    struct Asm {
+        std::vector<bpf_insn> code;
+        std::map<std::string, size_t> labels;
+        std::vector<std::pair<size_t, std::string>> fixups;
+
+        void emit(bpf_insn i) { code.push_back(i); }
+        void label(const std::string& name) { labels[name] = code.size(); }
+        // op: BPF_JEQ | BPF_K stb. (a BPF_JMP osztályt ez teszi hozzá)
+        void jump(uint8_t op, uint8_t dst, uint8_t src, int32_t imm, const std::string& target) {
+            fixups.emplace_back(code.size(), target);
+            code.push_back(insn(BPF_JMP | op, dst, src, 0, imm));
+        }
+        void loadMap(uint8_t dst, int mapFd) {
+            code.push_back(insn(BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, mapFd));
+            code.push_back(insn(0, 0, 0, 0, 0));
+        }
+        // dst = fp + off
+        void stackPtr(uint8_t dst, int16_t off) {
+            emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, dst, BPF_REG_10, 0, 0));
+            emit(insn(BPF_ALU64 | BPF_ADD | BPF_K, dst, 0, 0, off));
+        }
+        void call(int32_t helper) { emit(insn(BPF_JMP | BPF_CALL, 0, 0, 0, helper)); }
+        // PERCPU számláló: map[slotReg]++ (slotReg értéke a fp-off helyre kerül)
+        void countSlot(int mapFd, uint8_t slotReg, int16_t off, const std::string& skip) {
+            emit(insn(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, slotReg, off, 0));
+            loadMap(BPF_REG_1, mapFd);
+            stackPtr(BPF_REG_2, off);
+            call(BPF_FUNC_map_lookup_elem);
+            jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, skip);
+            emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_0, 0, 0));
+            emit(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_1, 0, 0, 1));
+            emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_0, BPF_REG_1, 0, 0));
+            label(skip);
+        }
+        std::vector<bpf_insn> finish() {
+            for (auto& [at, target] : fixups) {
+                code[at].off = static_cast<int16_t>(labels.at(target) - at - 1);
+            }
+            return code;
+        }
+    };
+}
+
+#endif // VENOM_BENCH_BPF_ASM_HPP
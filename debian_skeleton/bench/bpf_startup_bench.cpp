@@ -0,0 +1,303 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Indulási idő: az XDP pajzs megnyitása / betöltése / csatolása (fájl vs. beágyazott skeleton)
+//
+// Használat: bpf_startup_bench [rounds=20] [bpf_obj=obj/core/ebpf/venom_shield.bpf.o]
+//
+// A "vb" veth végen, SKB módban, körönként a medián:
+// 1. kernel oldal: a venom_shield 13 mapje (típus, méret, max_entries az objektum szerint),
+//    egy kézzel összerakott XDP program betöltése és a bpf_link csatolása. Ez minden
+//    betöltési útnál ugyanaz; clang nélkül is mérhető.
+// 2. fájlból: bpf_object__open(útvonal) -> bpf_object__load -> attachXdpLink, majd ugyanez a
+//    BpfLoader::deploy() egészére. Golden: a fds() minden leírója él és megegyezik a
+//    név szerinti kereséssel (get_map_fd / get_prog_fd).
+// 3. beágyazva (csak skeletonnal épült benchnél): venom_shield__open -> __load -> attach,
+//    majd BpfLoader::deployEmbedded(); golden mint a 2.-nál.
+// 4. leíró-feloldás: 13 név szerinti keresés vs. a fds() mezői.
+// Root és veth kell; e nélkül "skipped" és 0-s kilépés. A 2. / 3. szakasz objektum, ill.
+// skeleton nélkül kimarad.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <sys/stat.h>
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "bpf_asm.hpp"
+#include "veth_frames.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+#ifdef VENOM_BPF_SKELETON
+#include "venom_shield.skel.h"
+#endif
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    struct MapDef {
+        const char* name;
+        bpf_map_type type;
+        uint32_t keySize;
+        uint32_t valueSize;
+        uint32_t maxEntries;
+        uint32_t flags;
+    };
+
+    // A venom_shield.bpf.c map-definíciói (a kernel ugyanezeket hozza létre betöltéskor)
+    const MapDef SHIELD_MAPS[] = {
+        {"blacklist_map", BPF_MAP_TYPE_LRU_HASH, 4, 1, VENOM_BLACKLIST_MAX, 0},
+        {"cidr_blacklist_map", BPF_MAP_TYPE_LPM_TRIE, sizeof(venom_lpm_v4), 1, VENOM_CIDR_MAX, BPF_F_NO_PREALLOC},
+        {"stats_map", BPF_MAP_TYPE_PERCPU_ARRAY, 4, 8, VENOM_STAT_SLOTS, 0},
+        {"blacklist6_map", BPF_MAP_TYPE_LRU_HASH, sizeof(venom_in6), 1, VENOM_BLACKLIST6_MAX, 0},
+        {"cidr6_blacklist_map", BPF_MAP_TYPE_LPM_TRIE, sizeof(venom_lpm_v6), 1, VENOM_CIDR6_MAX, BPF_F_NO_PREALLOC},
+        {"router_identity_map", BPF_MAP_TYPE_ARRAY, 4, sizeof(Venom::Core::router_identity), 1, 0},
+        {"watch_map", BPF_MAP_TYPE_HASH, 4, 1, 1024, 0},
+        {"xsks_map", BPF_MAP_TYPE_XSKMAP, 4, 4, VENOM_XSK_MAX_QUEUES, 0},
+        {"xsk_config_map", BPF_MAP_TYPE_ARRAY, 4, 4, 1, 0},
+        {"events_rb", BPF_MAP_TYPE_RINGBUF, 0, 0, VENOM_EVENTS_RB_BYTES, 0},
+        {"event_config_map", BPF_MAP_TYPE_ARRAY, 4, sizeof(venom_event_config), 1, 0},
+        {"rate_map", BPF_MAP_TYPE_LRU_PERCPU_HASH, sizeof(venom_in6), sizeof(venom_rate_bucket), VENOM_RATE_MAX, 0},
+        {"rate_config_map", BPF_MAP_TYPE_ARRAY, 4, sizeof(venom_rate_config), 1, 0},
+    };
+    constexpr size_t SHIELD_MAP_COUNT = sizeof(SHIELD_MAPS) / sizeof(SHIELD_MAPS[0]);
+
+    // Forrás IPv4 -> blacklist_map lookup -> DROP / PASS (a verifier munkájához elég valódi program)
+    int loadGuard(int blacklistFd) {
+        Asm a;
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, 0, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_1, 4, 0));
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, 30));
+        a.jump(BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0, "pass");
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_5, BPF_REG_2, 26, 0));
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_5, -4, 0));
+        a.loadMap(BPF_REG_1, blacklistFd);
+        a.stackPtr(BPF_REG_2, -4);
+        a.call(BPF_FUNC_map_lookup_elem);
+        a.jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, "pass");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_DROP));
+        a.emit(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        a.label("pass");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+        a.emit(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        std::vector<bpf_insn> prog = a.finish();
+        return bpf_prog_load(BPF_PROG_TYPE_XDP, "venom_guard", "GPL", prog.data(), prog.size(), nullptr);
+    }
+
+    double usSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    }
+
+    double median(std::vector<double> v) {
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    }
+
+    struct Phases {
+        std::vector<double> open, load, attach;
+    };
+
+    void printPhases(const char* what, const Phases& p) {
+        double o = median(p.open), l = median(p.load), a = median(p.attach);
+        std::printf("  %-30s open %8.0f us  load %8.0f us  attach %6.0f us  = %8.0f us\n",
+                    what, o, l, a, o + l + a);
+    }
+
+    // A fds() mezői élnek és ugyanazok, mint a név szerinti keresés eredménye
+    int checkFds(BpfLoader& loader) {
+        const ShieldFds& f = loader.fds();
+        const std::pair<const char*, int> typed[] = {
+            {"blacklist_map", f.blacklist}, {"blacklist6_map", f.blacklist6},
+            {"cidr_blacklist_map", f.cidr}, {"cidr6_blacklist_map", f.cidr6},
+            {"router_identity_map", f.routerIdentity}, {"watch_map", f.watch},
+            {"xsks_map", f.xsks}, {"xsk_config_map", f.xskConfig},
+            {"event_config_map", f.eventConfig}, {"events_rb", f.events},
+            {"stats_map", f.stats}, {"rate_map", f.rate}, {"rate_config_map", f.rateConfig},
+        };
+        size_t bad = 0;
+        for (const auto& [name, fd] : typed) bad += (fd < 0 || fd != loader.get_map_fd(name)) ? 1 : 0;
+        bad += (f.guardProg < 0 || f.guardProg != loader.get_prog_fd("venom_router_guard")) ? 1 : 0;
+        return check("fds() mismatches", bad, 0);
+    }
+
+    // BpfLoader::deploy egésze körönként (a detach a mérésen kívül)
+    template <typename Deploy>
+    int timeDeploy(const char* what, int rounds, Deploy deploy, double& medianUs) {
+        std::vector<double> t;
+        int failures = 0;
+        for (int r = 0; r < rounds; ++r) {
+            BpfLoader loader;
+            auto t0 = Clock::now();
+            bool ok = deploy(loader);
+            t.push_back(usSince(t0));
+            if (!ok) return check(what, 0, 1);
+            if (r == 0) failures += checkFds(loader);
+            loader.detach();
+        }
+        medianUs = median(t);
+        return failures;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc > 1) ? std::atoi(argv[1]) : 20;
+    std::string objPath = (argc > 2) ? argv[2] : "obj/core/ebpf/venom_shield.bpf.o";
+    if (rounds <= 0) rounds = 20;
+
+    if (!setupVeth()) {
+        std::printf("bpf_startup_bench: skipped (netns/veth nem hozható létre: root kell)\n");
+        return 0;
+    }
+    const int ifindex = static_cast<int>(if_nametoindex("vb"));
+    int failures = 0;
+
+    // --- 1. kernel oldal: mapek, program, link ---
+    Phases kernel;
+    std::vector<double> perMap[SHIELD_MAP_COUNT];
+    size_t attachedRounds = 0;
+    for (int r = 0; r < rounds; ++r) {
+        int fds[SHIELD_MAP_COUNT];
+        auto t0 = Clock::now();
+        size_t created = 0;
+        for (const MapDef& m : SHIELD_MAPS) {
+            LIBBPF_OPTS(bpf_map_create_opts, opts, .map_flags = m.flags);
+            auto tm = Clock::now();
+            int fd = bpf_map_create(m.type, m.name, m.keySize, m.valueSize, m.maxEntries, &opts);
+            perMap[created].push_back(usSince(tm));
+            if (fd < 0) {
+                std::printf("  %s: %s\n", m.name, std::strerror(errno));
+                break;
+            }
+            fds[created++] = fd;
+        }
+        kernel.open.push_back(usSince(t0));
+        int progFd = -1, linkFd = -1;
+        if (created == SHIELD_MAP_COUNT) {
+            t0 = Clock::now();
+            progFd = loadGuard(fds[0]);
+            kernel.load.push_back(usSince(t0));
+            t0 = Clock::now();
+            if (progFd >= 0) linkFd = attachXdpLink(progFd, ifindex, XdpAttachMode::GENERIC);
+            kernel.attach.push_back(usSince(t0));
+        }
+        if (linkFd >= 0) attachedRounds++;
+        if (linkFd >= 0) close(linkFd);
+        if (progFd >= 0) close(progFd);
+        for (size_t i = 0; i < created; ++i) close(fds[i]);
+    }
+    std::printf("indulás (%d kör, medián):\n", rounds);
+    printPhases("kernel: 13 map + program", kernel);
+    std::printf("    (az \"open\" itt a mapek létrehozása: ezt a libbpf a load lépésben végzi)\n");
+    for (size_t i = 0; i < SHIELD_MAP_COUNT; ++i) {
+        double us = median(perMap[i]);
+        if (us >= 1000.0) std::printf("    %-26s %8.0f us\n", SHIELD_MAPS[i].name, us);
+    }
+    failures += check("attached rounds", attachedRounds, static_cast<uint64_t>(rounds));
+
+    // --- 2. fájlból ---
+    double fileDeployUs = 0.0;
+    bool haveFile = access(objPath.c_str(), R_OK) == 0;
+    if (haveFile) {
+        Phases file;
+        for (int r = 0; r < rounds; ++r) {
+            auto t0 = Clock::now();
+            bpf_object* obj = bpf_object__open(objPath.c_str());
+            file.open.push_back(usSince(t0));
+            if (!obj) { failures += check("bpf_object__open", 0, 1); break; }
+            t0 = Clock::now();
+            int err = bpf_object__load(obj);
+            file.load.push_back(usSince(t0));
+            bpf_program* prog = err ? nullptr : bpf_object__find_program_by_name(obj, "venom_router_guard");
+            t0 = Clock::now();
+            int linkFd = prog ? attachXdpLink(bpf_program__fd(prog), ifindex, XdpAttachMode::GENERIC) : -1;
+            file.attach.push_back(usSince(t0));
+            if (linkFd < 0) { failures += check("file attach", 0, 1); bpf_object__close(obj); break; }
+            close(linkFd);
+            bpf_object__close(obj);
+        }
+        printPhases("fájlból (libbpf)", file);
+        failures += timeDeploy("deploy(objPath)", rounds, [&](BpfLoader& l) {
+            return l.deploy(objPath, "vb", XdpAttachMode::GENERIC);
+        }, fileDeployUs);
+        std::printf("  %-30s %8.0f us\n", "BpfLoader::deploy(objPath)", fileDeployUs);
+    } else {
+        std::printf("  fájlból: kimarad (%s nincs meg; clang kell)\n", objPath.c_str());
+    }
+
+    // --- 3. beágyazva ---
+#ifdef VENOM_BPF_SKELETON
+    Phases embedded;
+    for (int r = 0; r < rounds; ++r) {
+        auto t0 = Clock::now();
+        venom_shield* skel = venom_shield__open();
+        embedded.open.push_back(usSince(t0));
+        if (!skel) { failures += check("venom_shield__open", 0, 1); break; }
+        t0 = Clock::now();
+        int err = venom_shield__load(skel);
+        embedded.load.push_back(usSince(t0));
+        t0 = Clock::now();
+        int linkFd = err ? -1 : attachXdpLink(bpf_program__fd(skel->progs.venom_router_guard), ifindex,
+                                              XdpAttachMode::GENERIC);
+        embedded.attach.push_back(usSince(t0));
+        if (linkFd < 0) { failures += check("embedded attach", 0, 1); venom_shield__destroy(skel); break; }
+        close(linkFd);
+        venom_shield__destroy(skel);
+    }
+    size_t elfSize = 0;
+    venom_shield__elf_bytes(&elfSize);
+    printPhases("beágyazva (skeleton)", embedded);
+    std::printf("    (a binárisba ágyazott ELF: %zu bájt)\n", elfSize);
+    double embeddedDeployUs = 0.0;
+    failures += timeDeploy("deployEmbedded", rounds, [](BpfLoader& l) {
+        return l.deployEmbedded("vb", XdpAttachMode::GENERIC);
+    }, embeddedDeployUs);
+    std::printf("  %-30s %8.0f us\n", "BpfLoader::deployEmbedded", embeddedDeployUs);
+#else
+    std::printf("  beágyazva: kimarad (a bench venom_shield.skel.h nélkül épült; bpftool kell)\n");
+    failures += check("hasEmbeddedObject", BpfLoader::hasEmbeddedObject() ? 1 : 0, 0);
+#endif
+
+    // --- 4. leíró-feloldás ---
+    if (haveFile || BpfLoader::hasEmbeddedObject()) {
+        BpfLoader loader;
+        bool ok = haveFile ? loader.deploy(objPath, "vb", XdpAttachMode::GENERIC)
+                           : loader.deployEmbedded("vb", XdpAttachMode::GENERIC);
+        if (ok) {
+            constexpr int LOOKUPS = 10000;
+            const char* names[SHIELD_MAP_COUNT];
+            for (size_t i = 0; i < SHIELD_MAP_COUNT; ++i) names[i] = SHIELD_MAPS[i].name;
+            long sink = 0;
+            auto t0 = Clock::now();
+            for (int i = 0; i < LOOKUPS; ++i) {
+                for (const char* n : names) sink += loader.get_map_fd(n);
+            }
+            double byName = usSince(t0) * 1000.0 / (LOOKUPS * SHIELD_MAP_COUNT);
+            t0 = Clock::now();
+            for (int i = 0; i < LOOKUPS; ++i) {
+                const ShieldFds& f = loader.fds();
+                sink += f.blacklist + f.blacklist6 + f.cidr + f.cidr6 + f.routerIdentity + f.watch + f.xsks +
+                        f.xskConfig + f.eventConfig + f.events + f.stats + f.rate + f.rateConfig;
+            }
+            double typed = usSince(t0) * 1000.0 / (LOOKUPS * SHIELD_MAP_COUNT);
+            std::printf("leíró-feloldás: név szerint %.1f ns, fds() %.2f ns / map (sink %ld)\n",
+                        byName, typed, sink);
+            loader.detach();
+        } else {
+            failures += check("deploy for lookups", 0, 1);
+        }
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Mikro-benchmark: VenomBus::pushEvent (MPSC ingress) – events/sec és p99 push latencia
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    struct RunResult {
+        double eventsPerSec;
+        double p50Ns;
+        double p99Ns;
+        TelemetrySnapshot snap;
+    };
+
+    RunResult runProducers(int producers, size_t totalEvents) {
+        Venom::Core::Scheduler scheduler;
+        Venom::Core::VenomBus bus;
+        // A push utat mérjük: a túlterhelés-vezérlő ne mintázza a löketet (dropped_events)
+        bus.setOverloadPolicy(Venom::Core::OverloadPolicy::disabled());
+        rxcpp::composite_subscription lifetime;
+        bus.startReactive(lifetime, scheduler);
+
+        const Venom::Core::SourceId src = bus.registerSource("NET_SOCKET_8888");
+        const size_t perThread = totalEvents / producers;
+        const std::string payload = "GET / HTTP/1.1\r\nHost: venom\r\n\r\n";
+        std::vector<std::vector<uint32_t>> samples(producers);
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < producers; ++t) {
+            samples[t].reserve(perThread);
+            threads.emplace_back([&, t] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (size_t i = 0; i < perThread; ++i) {
+                    auto t0 = Clock::now();
+                    bus.pushEvent(src, Venom::Core::EventOrigin::NETWORK, payload);
+                    auto t1 = Clock::now();
+                    samples[t].push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+                }
+            });
+        }
+
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& th : threads) th.join();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // A gyűrűben maradt események még pontozódnak: a sor összege a beküldött szám
+        const auto settle0 = Clock::now();
+        for (;;) {
+            const TelemetrySnapshot s = bus.getTelemetrySnapshot();
+            if (s.accepted + s.null_routed + s.dropped >= s.total) break;
+            if (Clock::now() - settle0 > std::chrono::seconds(2)) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        lifetime.unsubscribe();
+        bus.stop();
+
+        std::vector<uint32_t> all;
+        all.reserve(perThread * producers);
+        for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+        std::sort(all.begin(), all.end());
+
+        RunResult r{};
+        r.eventsPerSec = static_cast<double>(all.size()) / seconds;
+        r.p50Ns = all.empty() ? 0.0 : all[all.size() / 2];
+        r.p99Ns = all.empty() ? 0.0 : all[(all.size() * 99) / 100];
+        r.snap = bus.getTelemetrySnapshot();
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t totalEvents = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::printf("%-10s %14s %10s %10s %12s %12s %10s\n",
+                "producers", "events/sec", "p50(ns)", "p99(ns)", "accepted", "null_routed", "dropped");
+    for (int producers : {1, 8, 32}) {
+        RunResult r = runProducers(producers, totalEvents);
+        std::printf("%-10d %14.0f %10.0f %10.0f %12llu %12llu %10llu\n",
+                    producers, r.eventsPerSec, r.p50Ns, r.p99Ns,
+                    static_cast<unsigned long long>(r.snap.accepted),
+                    static_cast<unsigned long long>(r.snap.null_routed),
+                    static_cast<unsigned long long>(r.snap.dropped));
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Forráscím szerinti partíciók: sorrendtartás forrásonként, forrás-affinitás, tiltáskérés, skálázás
+//
+// Használat: bus_partition_bench [events=400000] [sources=512] [attackers=16]
+//
+// 1, 2 és 4 partícióval ugyanaz a terhelés: 4 producer, mindegyik a saját forrásait küldi
+// (forrásonként növekvő sorszámmal a payloadban); a támadó források ARP-jelzős eseményeket.
+// A partitionStream feliratkozói partíciónként saját, zár nélküli táblát vezetnek.
+// Golden:
+//   - egyetlen forrás sorszáma sem csökken (sorrendtartás forrásonként)
+//   - egyetlen forrás sem jelenik meg két partícióban
+//   - a feliratkozók által látott események = a partíciók eseményszámlálóinak összege
+//     (a tele ingress gyűrűn null-route-olt esemény nem jut el a partíciókig)
+//   - accepted + null_routed + dropped = total
+//   - minden támadó forrásra pontosan egy tiltáskérés érkezik
+// Riport: események/s (fal-idő), folyamat CPU / esemény, partíció-egyenetlenség (max / átlag).
+// Egy magon a skálázás nem látszik: ott a partíciók csak a szálváltás költségét mutatják.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "load_client.hpp"
+#include "veth_frames.hpp"
+#include "core/Scheduler.hpp"
+#include "core/VenomBus.hpp"
+
+using namespace Venom::Core;
+using VenomBench::cpuSeconds;
+
+namespace {
+
+    constexpr int PRODUCERS = 4;
+    constexpr uint32_t SOURCE_BASE = 0x0a010000u;   // 10.1.0.0/16
+
+    NetAddress sourceAddress(uint32_t s) { return NetAddress::fromV4(htonl(SOURCE_BASE | s)); }
+
+    uint32_t sourceIndex(const NetAddress& peer) {
+        return (static_cast<uint32_t>(peer.bytes[14]) << 8) | peer.bytes[15];
+    }
+
+    // Partíciónként: csak a partíció szála írja, a mérés végén olvassuk
+    struct PartitionView {
+        std::vector<uint32_t> lastSeq;     // forrásonként (0 = még nem látott; a sorszám 1-től)
+        uint64_t delivered = 0;
+        uint64_t orderViolations = 0;
+    };
+
+    struct Result {
+        double eventsPerSec = 0;
+        double cpuNsPerEvent = 0;
+        double imbalance = 0;
+        uint64_t orderViolations = 0;
+        uint64_t sharedSources = 0;
+        uint64_t delivered = 0;
+        uint64_t reactive = 0;
+        uint64_t partitioned = 0;
+        uint64_t dropped = 0;
+        uint64_t total = 0;
+        uint64_t attackersBlocked = 0;
+        uint64_t duplicateBlocks = 0;
+        uint64_t legitBlocks = 0;
+    };
+
+    Result run(unsigned partitionCount, size_t total, uint32_t sources, uint32_t attackers) {
+        Scheduler scheduler;
+        VenomBus bus;
+        // A partícionálást mérjük: a túlterhelés-vezérlő ne mintázza a támadók eseményeit
+        bus.setOverloadPolicy(OverloadPolicy::disabled());
+        bus.setPartitions(partitionCount);
+        const unsigned n = bus.getPartitionCount();
+
+        std::unique_ptr<std::atomic<uint32_t>[]> blocks(new std::atomic<uint32_t>[sources]);
+        for (uint32_t s = 0; s < sources; ++s) blocks[s].store(0);
+        bus.setSourceBlockCallback([&](const NetAddress& peer) {
+            const uint32_t s = sourceIndex(peer);
+            if (s < sources) blocks[s].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        rxcpp::composite_subscription lifetime;
+        std::vector<PartitionView> views(n);
+        for (unsigned p = 0; p < n; ++p) {
+            PartitionView* view = &views[p];
+            view->lastSeq.assign(sources, 0);
+            bus.partitionStream(p).subscribe(lifetime, [view, sources](const VentWindow& window) {
+                for (const VentEvent& ev : window) {
+                    const uint32_t s = sourceIndex(ev.header.peer);
+                    if (s >= sources) continue;
+                    char buf[32] = {};
+                    const std::string_view data = ev.data();
+                    std::memcpy(buf, data.data(), std::min(data.size(), sizeof(buf) - 1));
+                    unsigned src = 0, seq = 0;
+                    if (std::sscanf(buf, "s=%u q=%u", &src, &seq) != 2) continue;
+                    if (seq <= view->lastSeq[s]) view->orderViolations++;
+                    view->lastSeq[s] = seq;
+                    view->delivered++;
+                }
+            });
+        }
+        bus.startReactive(lifetime, scheduler);
+        const SourceId src = bus.registerSource("NET_SOCKET_8888");
+
+        const double cpu0 = cpuSeconds(RUSAGE_SELF);
+        const auto w0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < PRODUCERS; ++t) {
+            threads.emplace_back([&, t] {
+                // A producer csak a saját forrásait küldi: forrásonként egyetlen, rendezett küldő
+                std::vector<uint32_t> mine;
+                for (uint32_t s = t; s < sources; s += PRODUCERS) mine.push_back(s);
+                if (mine.empty()) return;
+                std::vector<uint32_t> seq(mine.size(), 0);
+                std::vector<NetAddress> peers;
+                for (uint32_t s : mine) peers.push_back(sourceAddress(s));
+                const IngressLane lane = bus.openLane();
+                char buf[32];
+                for (size_t i = t; i < total; i += PRODUCERS) {
+                    const size_t k = (i / PRODUCERS) % mine.size();
+                    const uint32_t s = mine[k];
+                    const int len = std::snprintf(buf, sizeof(buf), "s=%u q=%u", s, ++seq[k]);
+                    const uint8_t flags = s < attackers ? EVENT_FLAG_ARP : EVENT_FLAG_NONE;
+                    bus.pushEvent(lane, src, EventOrigin::NETWORK, std::string_view(buf, static_cast<size_t>(len)),
+                                  flags, &peers[k]);
+                    if ((i & 63) == 0) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        while (bus.getTelemetrySnapshot().queue_current > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+        const double cpu = cpuSeconds(RUSAGE_SELF) - cpu0;
+        lifetime.unsubscribe();
+        bus.stop();
+
+        const TelemetrySnapshot snap = bus.getTelemetrySnapshot();
+        Result r;
+        r.total = snap.total;
+        r.reactive = snap.accepted + snap.null_routed;
+        r.dropped = snap.dropped;
+        r.eventsPerSec = static_cast<double>(r.reactive) / wall;   // ítélet / s (ingress null-route-tal)
+        r.cpuNsPerEvent = cpu * 1e9 / static_cast<double>(std::max<uint64_t>(snap.total, 1));
+        r.imbalance = snap.partition_imbalance;
+        for (unsigned p = 0; p < snap.partition_count; ++p) r.partitioned += snap.partition_events[p];
+        for (uint32_t s = 0; s < sources; ++s) {
+            unsigned seenIn = 0;
+            for (const PartitionView& v : views) seenIn += v.lastSeq[s] != 0;
+            if (seenIn > 1) r.sharedSources++;
+            const uint32_t b = blocks[s].load();
+            if (s < attackers) {
+                r.attackersBlocked += b > 0;
+                r.duplicateBlocks += b > 1 ? b - 1 : 0;
+            } else {
+                r.legitBlocks += b;
+            }
+        }
+        for (const PartitionView& v : views) {
+            r.delivered += v.delivered;
+            r.orderViolations += v.orderViolations;
+        }
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 400000;
+    uint32_t sources = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 512;
+    uint32_t attackers = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 16;
+    if (total == 0) total = 400000;
+    sources = std::clamp<uint32_t>(sources, 1, 1u << 16);
+    attackers = std::min(attackers, sources);
+    int failures = 0;
+
+    std::printf("%zu esemény, %u forrás (%u támadó), %d producer, %u mag:\n", total, sources, attackers, PRODUCERS,
+                std::thread::hardware_concurrency());
+    std::printf("  %-10s %12s %12s %12s %12s %10s\n", "partíció", "esemény/s", "cpu ns/ev", "egyenetlen",
+                "ingress null", "tiltás");
+    for (unsigned partitions : {1u, 2u, 4u}) {
+        const Result r = run(partitions, total, sources, attackers);
+        std::printf("  %-10u %12.0f %12.1f %12.2f %12llu %10llu\n", partitions, r.eventsPerSec, r.cpuNsPerEvent,
+                    r.imbalance, static_cast<unsigned long long>(r.reactive - r.partitioned),
+                    static_cast<unsigned long long>(r.attackersBlocked + r.legitBlocks));
+        failures += VenomBench::check("  order violations", r.orderViolations, 0);
+        failures += VenomBench::check("  sources in two partitions", r.sharedSources, 0);
+        failures += VenomBench::check("  delivered == partition events", r.delivered, r.partitioned);
+        failures += VenomBench::check("  accepted + null_routed + dropped", r.reactive + r.dropped, r.total);
+        // Egy támadónak akkor is jut SOURCE_STRIKE_LIMIT esemény, ha a tele ingress párat eldob
+        if (total / sources > 4 * VenomBus::SOURCE_STRIKE_LIMIT) {
+            failures += VenomBench::check("  attackers blocked", r.attackersBlocked, attackers);
+        }
+        failures += VenomBench::check("  duplicate block requests", r.duplicateBlocks, 0);
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
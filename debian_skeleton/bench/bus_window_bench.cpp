@@ -0,0 +1,330 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Reaktív lánc: eseményenkénti feliratkozó (metabolizmus + classify + ip_mutex) vs. ablakos pontozás
+//
+// Használat: bus_window_bench [events=400000] [window=256] [workers=3]
+//
+// 1. Ugyanazok az ablakok (4096 előre gyártott esemény: szöveg, véletlen bináris, ARP,
+//    stream-entrópiás) mindkét úton, szál-CPU idő / esemény és zárolások száma:
+//    - előtte: a régi startReactive feliratkozója változatlanul, eseményenként
+//    - utána: WindowScorer + a VenomBus::processWindow egymenetes könyvelése
+//    Két küszöb: "pontozó" (metabolizmus ~5.0 bit/bájt küszöbre hangolva) és "áradás"
+//    (sok esemény rövid idő alatt: a küszöb 8 bit/bájt fölé megy, entrópia nem számolódik).
+//    Golden: a két út ítéletszámai egyeznek.
+// 2. parallel-for: workers segédszál egy 4096-os ablakon; golden: bitre azonos ítéletek.
+// 3. végponttól végpontig: 4 producer a VenomBus-on, folyamat CPU / esemény és ablakméret;
+//    golden: accepted + null_routed + dropped = total.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+#include "load_client.hpp"
+#include "veth_frames.hpp"
+#include "core/NullScheduler.hpp"
+#include "core/Scheduler.hpp"
+#include "core/StreamProbe.hpp"
+#include "core/VenomBus.hpp"
+#include "core/WindowScorer.hpp"
+
+using namespace Venom::Core;
+using VenomBench::cpuSeconds;
+
+namespace {
+
+    constexpr size_t POOL_EVENTS = 4096;
+
+    double threadCpuNs() {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) * 1e9 + static_cast<double>(ts.tv_nsec);
+    }
+
+    struct Sample {
+        std::string payload;
+        uint8_t flags = EVENT_FLAG_NONE;
+        float streamEntropy = 0.0f;
+        NetAddress peer;
+    };
+
+    // 70% HTTP-szerű szöveg, 20% véletlen bináris, 5% ARP, 5% hosszú kapcsolat (stream-entrópia)
+    std::vector<Sample> makeSamples(size_t n) {
+        std::mt19937 rng(42);
+        std::vector<Sample> out(n);
+        for (size_t i = 0; i < n; ++i) {
+            Sample& s = out[i];
+            s.peer = NetAddress::fromV4(htonl(0x0a000000u | static_cast<uint32_t>(i + 1)));
+            const unsigned kind = rng() % 20;
+            if (kind < 14) {
+                s.payload = "GET /api/v1/items/" + std::to_string(rng() % 100000) +
+                            " HTTP/1.1\r\nHost: venom\r\nUser-Agent: probe/" + std::to_string(rng() % 10) + "\r\n\r\n";
+            } else if (kind < 18) {
+                s.payload.resize(192 + rng() % 64);
+                for (auto& c : s.payload) c = static_cast<char>(rng());
+            } else if (kind == 18) {
+                s.payload = "ARP who-has 10.0.0.1 tell 10.0.0.2";
+                s.flags = EVENT_FLAG_ARP;
+            } else {
+                s.payload = "keep-alive chunk " + std::to_string(i);
+                s.flags = EVENT_FLAG_STREAM;
+                s.streamEntropy = 6.5f;
+            }
+        }
+        return out;
+    }
+
+    std::vector<VentEvent> makeEvents(PayloadPool& pool, const std::vector<Sample>& samples) {
+        std::vector<VentEvent> events(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            events[i].header.origin = EventOrigin::NETWORK;
+            events[i].header.flags = samples[i].flags;
+            events[i].header.peer = samples[i].peer;
+            events[i].header.streamEntropy = samples[i].streamEntropy;
+            events[i].payload = pool.acquire({samples[i].payload});
+        }
+        return events;
+    }
+
+    // A küszöb: 6.8 / (loadFactor + 0.11), loadFactor = (eltelt ms / események) / 100
+    void tuneTelemetry(BusTelemetry& tel, double tickMs, uint64_t events) {
+        tel.total_events.store(events);
+        tel.window_start = std::chrono::steady_clock::now() -
+                           std::chrono::milliseconds(static_cast<int64_t>(tickMs * static_cast<double>(events)));
+    }
+
+    // A régi startReactive feliratkozója változatlanul (a zárolásokat számolva)
+    struct LegacySubscriber {
+        explicit LegacySubscriber(BusTelemetry& telemetry) : telemetry(telemetry) {}
+
+        BusTelemetry& telemetry;
+        std::mutex ip_mutex;
+        NetAddress last_filtered_peer;
+        uint64_t locks = 0;
+
+        void onNext(const VentEvent& ev) {
+            auto meta = telemetry.get_metabolism();
+            double dynamicThreshold = 6.8 * (1.0 / (meta.loadFactor + 0.11));
+            StreamVerdict verdict = StreamProbe::classify(ev.data(), telemetry.current_profile.load());
+            double entropy = verdict.features.entropy;
+            if (ev.header.flags & EVENT_FLAG_STREAM) {
+                entropy = std::max(entropy, static_cast<double>(ev.header.streamEntropy));
+            }
+
+            if (entropy > dynamicThreshold || ev.isArp()) {
+                NullScheduler::absorb(ev);
+                telemetry.null_routed_events++;
+
+                std::lock_guard<std::mutex> lock(ip_mutex);
+                locks++;
+                if (!ev.header.peer.empty()) last_filtered_peer = ev.header.peer;
+            } else {
+                telemetry.accepted_events++;
+            }
+
+            if (telemetry.queue_depth > 0) telemetry.queue_depth--;
+        }
+    };
+
+    // A VenomBus::processWindow lépései (a pontozó a valódi WindowScorer; a partíció
+    // forrásonkénti strike-lépése nélkül, az a bus_partition_bench mérése)
+    struct WindowSubscriber {
+        WindowSubscriber(BusTelemetry& telemetry, WindowScorer& scorer) : telemetry(telemetry), scorer(scorer) {}
+
+        BusTelemetry& telemetry;
+        WindowScorer& scorer;
+        std::mutex ip_mutex;
+        NetAddress last_filtered_peer;
+        uint64_t locks = 0;
+
+        void onNext(const VentWindow& window) {
+            auto meta = telemetry.get_metabolism();
+            double dynamicThreshold = 6.8 * (1.0 / (meta.loadFactor + 0.11));
+            const uint8_t* nullRoute = scorer.score(window, dynamicThreshold);
+
+            uint64_t filtered = 0;
+            const NetAddress* lastPeer = nullptr;
+            for (size_t i = 0; i < window.size(); ++i) {
+                if (!nullRoute[i]) continue;
+                NullScheduler::absorb(window[i]);
+                filtered++;
+                if (!window[i].header.peer.empty()) lastPeer = &window[i].header.peer;
+            }
+            telemetry.null_routed_events.fetch_add(filtered, std::memory_order_relaxed);
+            telemetry.accepted_events.fetch_add(window.size() - filtered, std::memory_order_relaxed);
+            if (lastPeer) {
+                std::lock_guard<std::mutex> lock(ip_mutex);
+                locks++;
+                last_filtered_peer = *lastPeer;
+            }
+            const uint32_t done = static_cast<uint32_t>(window.size());
+            uint32_t depth = telemetry.queue_depth.load(std::memory_order_relaxed);
+            while (!telemetry.queue_depth.compare_exchange_weak(depth, depth - std::min(depth, done),
+                                                                std::memory_order_relaxed)) {
+            }
+        }
+    };
+
+    struct PathResult {
+        double cpuNsPerEvent = 0;
+        uint64_t accepted = 0;
+        uint64_t nullRouted = 0;
+        uint64_t locks = 0;
+    };
+
+    // Az eseménytömböt window méretű szeletekben ismétli, amíg total esemény el nem fogy
+    template <typename Fn>
+    double runWindows(const std::vector<VentEvent>& events, size_t window, size_t total, Fn fn) {
+        size_t done = 0;
+        const double t0 = threadCpuNs();
+        while (done < total) {
+            for (size_t off = 0; off < events.size() && done < total; off += window) {
+                const size_t n = std::min({window, events.size() - off, total - done});
+                fn(VentWindow{events.data() + off, n});
+                done += n;
+            }
+        }
+        return (threadCpuNs() - t0) / static_cast<double>(total);
+    }
+
+    PathResult runLegacy(const std::vector<VentEvent>& events, size_t window, size_t total,
+                         double tickMs, uint64_t seen) {
+        BusTelemetry tel;
+        tuneTelemetry(tel, tickMs, seen);
+        LegacySubscriber sub(tel);
+        PathResult r;
+        r.cpuNsPerEvent = runWindows(events, window, total, [&](const VentWindow& w) {
+            for (const VentEvent& ev : w) sub.onNext(ev);
+        });
+        r.accepted = tel.accepted_events.load();
+        r.nullRouted = tel.null_routed_events.load();
+        r.locks = sub.locks;
+        return r;
+    }
+
+    PathResult runBatch(const std::vector<VentEvent>& events, size_t window, size_t total,
+                        double tickMs, uint64_t seen) {
+        BusTelemetry tel;
+        tuneTelemetry(tel, tickMs, seen);
+        WindowScorer scorer;
+        WindowSubscriber sub(tel, scorer);
+        PathResult r;
+        r.cpuNsPerEvent = runWindows(events, window, total, [&](const VentWindow& w) { sub.onNext(w); });
+        r.accepted = tel.accepted_events.load();
+        r.nullRouted = tel.null_routed_events.load();
+        r.locks = sub.locks;
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 400000;
+    size_t window = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 256;
+    unsigned workers = (argc > 3) ? static_cast<unsigned>(std::atoi(argv[3])) : 3;
+    if (total == 0) total = 400000;
+    if (window == 0) window = 256;
+    int failures = 0;
+
+    PayloadPool pool;
+    const std::vector<Sample> samples = makeSamples(POOL_EVENTS);
+    const std::vector<VentEvent> events = makeEvents(pool, samples);
+
+    // --- 1. eseményenként vs. ablakonként ---
+    struct Mode {
+        const char* name;
+        double tickMs;      // Átlagos "tick" az eddigi eseményekre
+        uint64_t seen;      // Eddigi események
+    };
+    const Mode modes[] = {
+        {"pontozó (küszöb ~5.0)", 125.0, 1000},
+        {"áradás (küszöb > 8)", 0.01, 1000000},
+    };
+    std::printf("%zu esemény, %zu-es ablakok:\n", total, window);
+    std::printf("  %-24s %-10s %12s %12s %12s %10s\n", "mód", "út", "cpu ns/ev", "accepted", "null_routed",
+                "zárolás");
+    for (const Mode& m : modes) {
+        PathResult legacy = runLegacy(events, window, total, m.tickMs, m.seen);
+        PathResult batch = runBatch(events, window, total, m.tickMs, m.seen);
+        std::printf("  %-24s %-10s %12.1f %12llu %12llu %10llu\n", m.name, "előtte", legacy.cpuNsPerEvent,
+                    static_cast<unsigned long long>(legacy.accepted),
+                    static_cast<unsigned long long>(legacy.nullRouted),
+                    static_cast<unsigned long long>(legacy.locks));
+        std::printf("  %-24s %-10s %12.1f %12llu %12llu %10llu\n", "", "utána", batch.cpuNsPerEvent,
+                    static_cast<unsigned long long>(batch.accepted),
+                    static_cast<unsigned long long>(batch.nullRouted),
+                    static_cast<unsigned long long>(batch.locks));
+        failures += VenomBench::check("  accepted equal", batch.accepted, legacy.accepted);
+        failures += VenomBench::check("  null_routed equal", batch.nullRouted, legacy.nullRouted);
+    }
+
+    // --- 2. parallel-for ---
+    {
+        WindowScorer serial;
+        WindowScorer parallel(workers);
+        const VentWindow all{events.data(), events.size()};
+        const uint8_t* ref = serial.score(all, 5.0);
+        const std::vector<uint8_t> expect(ref, ref + all.size());
+        constexpr int REPS = 50;
+        auto w0 = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPS; ++r) serial.score(all, 5.0);
+        const double serialNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - w0).count();
+        w0 = std::chrono::steady_clock::now();
+        size_t mismatches = 0;
+        for (int r = 0; r < REPS; ++r) {
+            const uint8_t* got = parallel.score(all, 5.0);
+            mismatches += std::memcmp(got, expect.data(), all.size()) == 0 ? 0 : 1;
+        }
+        const double parallelNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - w0).count();
+        const double per = static_cast<double>(REPS) * all.size();
+        std::printf("parallel-for (%zu-es ablak, %u segédszál, %u mag): soros %.1f ns/ev, párhuzamos %.1f ns/ev (fal-idő)\n",
+                    all.size(), workers, std::thread::hardware_concurrency(), serialNs / per, parallelNs / per);
+        failures += VenomBench::check("  parallel verdict mismatches", mismatches, 0);
+        failures += VenomBench::check("  parallel windows", parallel.parallelWindows(), workers ? REPS : 0);
+    }
+
+    // --- 3. végponttól végpontig ---
+    {
+        Scheduler scheduler;
+        VenomBus bus;
+        // Teljes pontozási út: a túlterhelés-vezérlő nem mintázza a hálózati eseményeket
+        bus.setOverloadPolicy(OverloadPolicy::disabled());
+        rxcpp::composite_subscription lifetime;
+        bus.startReactive(lifetime, scheduler);
+        const SourceId src = bus.registerSource("NET_SOCKET_8888");
+        constexpr int PRODUCERS = 4;
+        const double cpu0 = cpuSeconds(RUSAGE_SELF);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < PRODUCERS; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = t; i < total; i += PRODUCERS) {
+                    const Sample& s = samples[i % samples.size()];
+                    bus.pushEvent(src, EventOrigin::NETWORK, s.payload, s.flags, &s.peer, s.streamEntropy);
+                    if ((i & 63) == 0) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        while (bus.getTelemetrySnapshot().queue_current > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const double cpu = cpuSeconds(RUSAGE_SELF) - cpu0;
+        lifetime.unsubscribe();
+        bus.stop();
+
+        TelemetrySnapshot snap = bus.getTelemetrySnapshot();
+        const uint64_t reactive = snap.accepted + snap.null_routed;
+        std::printf("végponttól végpontig (%d producer): %.0f ns CPU/esemény, %llu ablak, átlag %.1f esemény/ablak\n",
+                    PRODUCERS, cpu * 1e9 / static_cast<double>(snap.total),
+                    static_cast<unsigned long long>(snap.windows),
+                    snap.windows ? static_cast<double>(reactive) / snap.windows : 0.0);
+        failures += VenomBench::check("  accepted + null_routed + dropped", reactive + snap.dropped, snap.total);
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
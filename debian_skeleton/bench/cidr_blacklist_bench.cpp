@@ -0,0 +1,302 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Tiltólista-lookup költsége: LRU hash (hostok) és LPM trie (prefixek) 100k bejegyzésig, IPv4 és IPv6
+//
+// Használat: cidr_blacklist_bench [entries=100000] [repeat=1000000] [bpf_obj=obj/core/ebpf/venom_shield.bpf.o]
+//
+// 1. lookup-kernelek: kézzel összerakott XDP programok, amelyek a forrás IP-t a
+//    venom_router_guard-dal azonos kulccsal keresik ki (host: __be32 / venom_in6,
+//    prefix: venom_lpm_v4 /32-vel / venom_lpm_v6 /128-cal). ns/csomag BPF_PROG_TEST_RUN-nal találatra és tévesztésre,
+//    1k / 10k / N bejegyzéssel; a verdiktnek egyeznie kell (golden).
+// 2. venom_router_guard: N prefix a blockCIDR-rel, IPv4 és IPv6 verdiktek, a
+//    cidr_drops / blacklist_drops számlálók, unblock után átengedés. Csak ha az objektum betölthető.
+// Root (CAP_BPF / CAP_SYS_ADMIN) kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <bpf/bpf.h>
+
+#include "veth_frames.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    using Program = std::vector<bpf_insn>;
+
+    bpf_insn insn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+        bpf_insn i{};
+        i.code = code;
+        i.dst_reg = dst & 0xf;
+        i.src_reg = src & 0xf;
+        i.off = off;
+        i.imm = imm;
+        return i;
+    }
+
+    enum class Lookup { HOST, PREFIX, HOST6, PREFIX6 };
+
+    bool isV6(Lookup kind) { return kind == Lookup::HOST6 || kind == Lookup::PREFIX6; }
+    bool isPrefix(Lookup kind) { return kind == Lookup::PREFIX || kind == Lookup::PREFIX6; }
+
+    const char* mapName(Lookup kind) {
+        switch (kind) {
+            case Lookup::HOST: return "LRU_HASH v4";
+            case Lookup::PREFIX: return "LPM_TRIE v4";
+            case Lookup::HOST6: return "LRU_HASH v6";
+            default: return "LPM_TRIE v6";
+        }
+    }
+
+    /**
+     * @brief Ethernet + IP forrás cím -> map lookup; találat XDP_DROP, egyébként XDP_PASS.
+     * A kulcs a veremben: [prefixlen (csak LPM)] + cím, közvetlenül az r10 alatt.
+     */
+    Program lookupKernel(int mapFd, Lookup kind) {
+        Program p;
+        std::vector<size_t> toPass;
+        const bool v6 = isV6(kind);
+        const int addrLen = v6 ? 16 : 4;
+        const int srcOff = v6 ? 14 + 8 : 14 + 12;
+        p.push_back(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, 0, 0));   // data
+        p.push_back(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_1, 4, 0));   // data_end
+        p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+        p.push_back(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, v6 ? 54 : 34));  // eth + IP fejléc
+        toPass.push_back(p.size());
+        p.push_back(insn(BPF_JMP | BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0, 0));
+
+        // Cím a verembe: [-addrLen, 0)
+        for (int o = 0; o < addrLen; o += 4) {
+            p.push_back(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_5, BPF_REG_2, static_cast<int16_t>(srcOff + o), 0));
+            p.push_back(insn(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_5, static_cast<int16_t>(-addrLen + o), 0));
+        }
+        int keyOff = -addrLen;
+        if (isPrefix(kind)) {
+            keyOff -= 4;
+            p.push_back(insn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, static_cast<int16_t>(keyOff), addrLen * 8));
+        }
+        p.push_back(insn(BPF_LD | BPF_DW | BPF_IMM, BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, mapFd));
+        p.push_back(insn(0, 0, 0, 0, 0));
+        p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0));
+        p.push_back(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, keyOff));
+        p.push_back(insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem));
+        toPass.push_back(p.size());
+        p.push_back(insn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, 0));
+        p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_DROP));
+        p.push_back(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+        const size_t pass = p.size();
+        p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+        p.push_back(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        for (size_t j : toPass) p[j].off = static_cast<int16_t>(pass - j - 1);
+        return p;
+    }
+
+    double testRun(int progFd, const Frame& frame, int repeat, uint32_t& retval) {
+        LIBBPF_OPTS(bpf_test_run_opts, opts);
+        opts.data_in = frame.data();
+        opts.data_size_in = static_cast<uint32_t>(frame.size());
+        opts.repeat = repeat;
+        if (bpf_prog_test_run_opts(progFd, &opts) != 0) return -1.0;
+        retval = opts.retval;
+        return static_cast<double>(opts.duration);
+    }
+
+    // Determinisztikus "botnet": szétszórt /32 hostok és /16../28 prefixek (hálózati sorrend)
+    struct Lcg {
+        uint32_t state = 0x9e3779b9u;
+        uint32_t next() { return state = state * 1664525u + 1013904223u; }
+    };
+
+    std::string v4(uint32_t networkOrder) {
+        char buf[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &networkOrder, buf, sizeof(buf));
+        return buf;
+    }
+
+    struct Row {
+        double hitNs = -1.0;
+        double missNs = -1.0;
+        double insertsPerSec = 0.0;
+        bool verdictsOk = false;
+    };
+
+    // Véletlen cím: az első bájt 0x0a bitjei mindig állnak (a prefixekben is), így
+    // az 1.0.0.0/8 és a 2001::/16 (0x20) sosem kerül a táblába
+    void randomAddr(Lcg& rng, uint8_t* out, size_t len) {
+        for (size_t b = 0; b < len; b += 4) {
+            uint32_t r = rng.next();
+            std::memcpy(out + b, &r, 4);
+        }
+        out[0] |= 0x0a;
+    }
+
+    void maskPrefix(uint8_t* addr, size_t len, uint32_t prefixlen) {
+        for (size_t b = 0; b < len; ++b) {
+            size_t bit = b * 8;
+            if (bit >= prefixlen) addr[b] = 0;
+            else if (bit + 8 > prefixlen) addr[b] &= static_cast<uint8_t>(0xff << (8 - (prefixlen - bit)));
+        }
+    }
+
+    Row measure(Lookup kind, size_t entries, int repeat) {
+        Row row;
+        const bool v6 = isV6(kind);
+        const size_t addrLen = v6 ? 16 : 4;
+        const uint32_t keySize = static_cast<uint32_t>(isPrefix(kind) ? 4 + addrLen : addrLen);
+        int mapFd = -1;
+        if (!isPrefix(kind)) {
+            mapFd = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "blacklist_map", keySize, sizeof(uint8_t),
+                                   static_cast<uint32_t>(entries), nullptr);
+        } else {
+            LIBBPF_OPTS(bpf_map_create_opts, opts);
+            opts.map_flags = BPF_F_NO_PREALLOC;
+            mapFd = bpf_map_create(BPF_MAP_TYPE_LPM_TRIE, "cidr_blacklist", keySize, sizeof(uint8_t),
+                                   static_cast<uint32_t>(entries), &opts);
+        }
+        if (mapFd < 0) return row;
+
+        Lcg rng;
+        uint8_t hitAddr[16] = {};
+        const uint8_t one = 1;
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < entries; ++i) {
+            uint8_t key[20] = {};       // [prefixlen] + cím
+            uint8_t* addr = isPrefix(kind) ? key + 4 : key;
+            randomAddr(rng, addr, addrLen);
+            if (i == entries / 2) std::memcpy(hitAddr, addr, addrLen);
+            if (isPrefix(kind)) {
+                // Botnet-jellegű keverék: minden negyedik teljes hosszú, a többi /16../28 (v6: /32../64)
+                uint32_t len = (i % 4 == 0) ? static_cast<uint32_t>(addrLen * 8)
+                                            : (v6 ? 32 + rng.next() % 33 : 16 + rng.next() % 13);
+                std::memcpy(key, &len, 4);
+                maskPrefix(addr, addrLen, len);
+            }
+            bpf_map_update_elem(mapFd, key, &one, BPF_ANY);
+        }
+        // Az LRU a CPU-nkénti szabadlisták miatt telítődés előtt is üríthet: a mért host legyen friss
+        if (!isPrefix(kind)) bpf_map_update_elem(mapFd, hitAddr, &one, BPF_ANY);
+        row.insertsPerSec = static_cast<double>(entries) /
+                            std::chrono::duration<double>(Clock::now() - t0).count();
+
+        Program prog = lookupKernel(mapFd, kind);
+        int progFd = bpf_prog_load(BPF_PROG_TYPE_XDP, "venom_lookup", "GPL", prog.data(), prog.size(), nullptr);
+        if (progFd >= 0) {
+            char text[INET6_ADDRSTRLEN];
+            inet_ntop(v6 ? AF_INET6 : AF_INET, hitAddr, text, sizeof(text));
+            const Frame hit = v6 ? udp6(text, "fd00::bb", "x") : udp4(text, "10.0.0.187", "x");
+            const Frame miss = v6 ? udp6("2001:db8::1", "fd00::bb", "x") : udp4("1.2.3.4", "10.0.0.187", "x");
+            uint32_t hitVerdict = 0, missVerdict = 0;
+            row.hitNs = testRun(progFd, hit, repeat, hitVerdict);
+            row.missNs = testRun(progFd, miss, repeat, missVerdict);
+            row.verdictsOk = hitVerdict == XDP_DROP && missVerdict == XDP_PASS;
+            close(progFd);
+        }
+        close(mapFd);
+        return row;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t entries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    int repeat = (argc > 2) ? std::atoi(argv[2]) : 1000000;
+    std::string objPath = (argc > 3) ? argv[3] : "obj/core/ebpf/venom_shield.bpf.o";
+
+    int failures = 0;
+
+    // --- 1. lookup-kernelek ---
+    std::vector<size_t> sizes = {1000, 10000, entries};
+    bool header = false;
+    for (Lookup kind : {Lookup::HOST, Lookup::PREFIX, Lookup::HOST6, Lookup::PREFIX6}) {
+        for (size_t n : sizes) {
+            Row r = measure(kind, n, repeat);
+            if (r.hitNs < 0) {
+                if (!header) {
+                    std::printf("cidr_blacklist_bench: skipped (BPF map / program nem hozható létre: root kell)\n");
+                    return 0;
+                }
+                failures++;
+                continue;
+            }
+            if (!header) {
+                std::printf("lookup-kernelek (%d ismétlés):\n", repeat);
+                std::printf("  %-12s %8s %12s %12s %14s\n", "map", "entries", "találat ns", "tévesztés ns", "beszúrás/s");
+                header = true;
+            }
+            std::printf("  %-12s %8zu %12.1f %12.1f %14.0f%s\n", mapName(kind), n, r.hitNs, r.missNs, r.insertsPerSec, r.verdictsOk ? "" : "  VERDICT MISMATCH");
+            if (!r.verdictsOk) failures++;
+        }
+    }
+
+    // --- 2. venom_router_guard + BpfLoader::blockCIDR / unblock ---
+    BpfLoader loader;
+    if (setupVeth() && loader.deploy(objPath, "vb", XdpAttachMode::GENERIC)) {
+        Lcg rng;
+        size_t blocked = 0;
+        for (size_t i = 0; i < entries && i < VENOM_CIDR_MAX; ++i) {
+            std::string cidr = v4(rng.next() | 0x0a) + "/" + std::to_string(16 + rng.next() % 17);
+            blocked += loader.blockCIDR(cidr) ? 1 : 0;
+        }
+        loader.blockCIDR("203.0.113.0/24");
+        loader.blockIP("198.51.100.7");
+        loader.blockCIDR("2001:db8:bad::/48");
+        loader.blockIP("2001:db8::66");
+        loader.setRouterMAC("02:00:00:00:00:01");
+        int progFd = loader.fds().guardProg;
+
+        struct Case {
+            const char* name;
+            Frame frame;
+            uint32_t verdict;
+        };
+        const Case cases[] = {
+            {"v4 prefix találat", udp4("203.0.113.77", "10.0.0.187", "x"), XDP_DROP},
+            {"v4 host találat", udp4("198.51.100.7", "10.0.0.187", "x"), XDP_DROP},
+            {"v4 tiszta forrás", udp4("1.2.3.4", "10.0.0.187", "x"), XDP_PASS},
+            {"v6 prefix találat", udp6("2001:db8:bad::77", "fd00::bb", "x"), XDP_DROP},
+            {"v6 host (HbH + Frag)", udp6("2001:db8::66", "fd00::bb", "x", true, true), XDP_DROP},
+            {"v6 tiszta, HbH + Frag", udp6("2001:db8::1", "fd00::bb", "x", true, true), XDP_PASS},
+            {"v6 RA idegen MAC", routerAdvert(MAC_ATTACKER), XDP_PASS},
+            {"v6 RA router MAC", routerAdvert(MAC_ROUTER), XDP_PASS},
+        };
+
+        BpfStats st0 = loader.getStats();
+        std::printf("venom_router_guard (%zu prefix a blockCIDR-rel):\n", blocked);
+        for (const auto& c : cases) {
+            uint32_t verdict = 0;
+            double ns = testRun(progFd, c.frame, repeat, verdict);
+            std::printf("  %-22s %8.1f ns/csomag%s\n", c.name, ns, verdict == c.verdict ? "" : "  VERDICT MISMATCH");
+            if (ns < 0 || verdict != c.verdict) failures++;
+        }
+        BpfStats st = loader.getStats();
+
+        uint32_t afterV4 = 0, afterV6 = 0;
+        loader.unblock("203.0.113.0/24");
+        loader.unblock("2001:db8::66");
+        testRun(progFd, cases[0].frame, 1, afterV4);
+        testRun(progFd, cases[4].frame, 1, afterV6);
+
+        const uint64_t R = static_cast<uint64_t>(repeat);
+        failures += check("cidr drops", st.cidr_drops - st0.cidr_drops, 2 * R);
+        failures += check("blacklist drops", st.blacklist_drops - st0.blacklist_drops, 2 * R);
+        failures += check("ipv6", st.ipv6_packets - st0.ipv6_packets, 5 * R);
+        failures += check("v6 fragments", st.fragments - st0.fragments, R);
+        failures += check("untrusted RA", st.untrusted_ra - st0.untrusted_ra, R);
+        failures += check("unblock v4 után", afterV4, XDP_PASS);
+        failures += check("unblock v6 után", afterV6, XDP_PASS);
+        loader.detach();
+    } else {
+        std::printf("venom_router_guard: skipped (XDP program nem tölthető: %s)\n", objPath.c_str());
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Csúszóablakos entrópia: EntropyAccumulator vs. EntropyEngine::compute ugyanarra az ablakra
+//
+// Használat: entropy_accumulator_bench [megabytes=4]
+//
+// Minden update() után az akkumulátor entrópiáját összeveti az ablak tartalmára (az utolsó
+// windowSize() bájt, külön tükrözve) hívott EntropyEngine::compute-tal. Ablakméretek: 64,
+// 4096 (alapértelmezett) és 65536 (a c*log2(c) táblán túli számlálók). Fázisok:
+//   - fill:    az ablak feltöltése (nincs kilépő bájt)
+//   - evict:   változó méretű darabok (1 bájttól az ablak kétszereséig), szöveg / véletlen /
+//              egybájtos futam vegyesen – minden bájt egy régit tol ki
+//   - resync:  megabytes MiB folyam, így az S összeg többször is újraszámolódik a számlálókból
+//   - reset:   ugyanaz az objektum új kapcsolathoz, újra feltöltve
+// Riport fázisonként: összevetések száma, max |eltérés|, ns/darab (update vs. teljes újraszámolás).
+// Golden: minden fázisban 0 összevetés lépi túl a 1e-9 bit/bájt eltérést, és a resync fázis
+// legalább egy újraszámolási határt átlép.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "veth_frames.hpp"
+#include "core/EntropyAccumulator.hpp"
+#include "core/EntropyEngine.hpp"
+
+using Venom::Core::EntropyAccumulator;
+using Venom::Core::EntropyEngine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    constexpr double TOLERANCE = 1e-9;
+    constexpr uint64_t RESYNC_BYTES = 1u << 20;   // Az EntropyAccumulator::RESYNC_INTERVAL
+
+    struct PhaseResult {
+        uint64_t samples = 0;
+        uint64_t overTolerance = 0;
+        double maxErr = 0.0;
+        double accNs = 0.0;       // update() + entropy() összesen
+        double refNs = 0.0;       // compute() az ablakra összesen
+    };
+
+    // Darabgenerátor: HTTP-szerű szöveg, véletlen bináris, egybájtos futam
+    class ChunkSource {
+    public:
+        explicit ChunkSource(uint32_t seed) : rng(seed) {}
+
+        std::string next(size_t size) {
+            static const std::string text = "GET /index.html HTTP/1.1\r\nHost: white-venom\r\nUser-Agent: probe\r\n\r\n";
+            std::string s(size, '\0');
+            switch (rng() % 3) {
+                case 0:
+                    for (size_t j = 0; j < size; ++j) s[j] = text[(j + offset++) % text.size()];
+                    break;
+                case 1:
+                    for (auto& c : s) c = static_cast<char>(rng() & 0xff);
+                    break;
+                default:
+                    std::fill(s.begin(), s.end(), static_cast<char>(rng() & 0xff));
+                    break;
+            }
+            return s;
+        }
+
+        size_t size(size_t maxSize) { return 1 + rng() % maxSize; }
+
+    private:
+        std::mt19937 rng;
+        size_t offset = 0;
+    };
+
+    // Az akkumulátor és az ablak tükre együtt: minden darab után összevetés
+    class Harness {
+    public:
+        explicit Harness(size_t window) : acc(window) {}
+
+        void feed(const std::string& chunk, PhaseResult& r) {
+            auto t0 = Clock::now();
+            acc.update(chunk);
+            double got = acc.entropy();
+            auto t1 = Clock::now();
+
+            mirror += chunk;
+            if (mirror.size() > acc.windowSize()) mirror.erase(0, mirror.size() - acc.windowSize());
+
+            auto t2 = Clock::now();
+            double want = EntropyEngine::compute(mirror);
+            auto t3 = Clock::now();
+
+            double err = std::fabs(got - want);
+            r.samples++;
+            r.maxErr = std::max(r.maxErr, err);
+            if (err > TOLERANCE) r.overTolerance++;
+            r.accNs += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            r.refNs += std::chrono::duration<double, std::nano>(t3 - t2).count();
+        }
+
+        void reset() {
+            acc.reset();
+            mirror.clear();
+        }
+
+        const EntropyAccumulator& accumulator() const { return acc; }
+
+    private:
+        EntropyAccumulator acc;
+        std::string mirror;
+    };
+
+    void printPhase(size_t window, const char* phase, const PhaseResult& r) {
+        double n = static_cast<double>(r.samples ? r.samples : 1);
+        std::printf("%-8zu %-8s %10llu %12.2e %12.1f %12.1f\n", window, phase,
+                    static_cast<unsigned long long>(r.samples), r.maxErr, r.accNs / n, r.refNs / n);
+    }
+
+    int runWindow(size_t window, uint64_t streamBytes) {
+        Harness h(window);
+        ChunkSource src(static_cast<uint32_t>(0x5eed ^ window));
+        int failures = 0;
+
+        // fill: apró darabok, amíg az ablak meg nem telik
+        PhaseResult fill;
+        while (h.accumulator().filled() < window) {
+            size_t left = window - h.accumulator().filled();
+            h.feed(src.next(std::min(left, src.size(std::max<size_t>(1, window / 16)))), fill);
+        }
+        printPhase(window, "fill", fill);
+
+        // evict: az ablak kétszereséig terjedő darabok, minden bájt egy régit tol ki
+        PhaseResult evict;
+        for (int i = 0; i < 2000; ++i) h.feed(src.next(src.size(2 * window)), evict);
+        printPhase(window, "evict", evict);
+
+        // resync: hosszú folyam, MTU-közeli darabokban
+        PhaseResult resync;
+        uint64_t start = h.accumulator().totalBytes();
+        while (h.accumulator().totalBytes() - start < streamBytes) h.feed(src.next(src.size(1500)), resync);
+        uint64_t boundaries = h.accumulator().totalBytes() / RESYNC_BYTES;
+        printPhase(window, "resync", resync);
+
+        // reset: ugyanaz az objektum új kapcsolathoz
+        PhaseResult reused;
+        h.reset();
+        for (int i = 0; i < 500; ++i) h.feed(src.next(src.size(window)), reused);
+        printPhase(window, "reset", reused);
+
+        failures += VenomBench::check("    fill > 1e-9", fill.overTolerance, 0);
+        failures += VenomBench::check("    evict > 1e-9", evict.overTolerance, 0);
+        failures += VenomBench::check("    resync > 1e-9", resync.overTolerance, 0);
+        failures += VenomBench::check("    resync boundaries >= 2", boundaries >= 2 ? 1 : 0, 1);
+        failures += VenomBench::check("    reset > 1e-9", reused.overTolerance, 0);
+        return failures;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint64_t megabytes = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4;
+    if (megabytes < 2) megabytes = 2;
+
+    const size_t windows[] = {64, EntropyAccumulator::DEFAULT_WINDOW, 65536};
+    int failures = 0;
+
+    std::printf("%-8s %-8s %10s %12s %12s %12s\n", "window", "phase", "samples", "max|err|", "acc(ns)", "compute(ns)");
+    for (size_t window : windows) failures += runWindow(window, megabytes << 20);
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
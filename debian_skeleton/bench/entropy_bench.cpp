@@ -0,0 +1,84 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Benchmark: StreamProbe entrópia – eredeti std::map implementáció vs. EntropyEngine
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/EntropyEngine.hpp"
+
+using Venom::Core::EntropyEngine;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    // Az eredeti (v2.1) StreamProbe::calculateEntropy, változatlanul – referencia
+    double legacyEntropy(const std::string& data) {
+        if (data.empty()) return 0.0;
+        std::map<unsigned char, size_t> frequencies;
+        for (unsigned char c : data) frequencies[c]++;
+        double entropy = 0.0;
+        for (auto const& [val, count] : frequencies) {
+            double p = static_cast<double>(count) / data.size();
+            entropy -= p * std::log2(p);
+        }
+        return entropy;
+    }
+
+    // Vegyes korpusz: HTTP-szerű szöveg és véletlen bináris (SocketProbe-jellegű olvasások)
+    std::vector<std::string> makeCorpus(size_t size, size_t count) {
+        std::mt19937 rng(0x5eed);
+        std::vector<std::string> out;
+        const std::string text = "GET /index.html HTTP/1.1\r\nHost: white-venom\r\nUser-Agent: probe\r\n\r\n";
+        for (size_t i = 0; i < count; ++i) {
+            std::string s(size, '\0');
+            if (i % 2 == 0) {
+                for (size_t j = 0; j < size; ++j) s[j] = text[(j + i) % text.size()];
+            } else {
+                for (auto& c : s) c = static_cast<char>(rng() & 0xff);
+            }
+            out.push_back(std::move(s));
+        }
+        return out;
+    }
+
+    template<typename F>
+    double nsPerCall(const std::vector<std::string>& corpus, size_t iterations, F&& fn, double& sink) {
+        auto t0 = Clock::now();
+        for (size_t it = 0; it < iterations; ++it) {
+            for (const auto& s : corpus) sink += fn(s);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        return ns / static_cast<double>(iterations * corpus.size());
+    }
+}
+
+int main() {
+    const size_t sizes[] = {16, 64, 256, 1024, 2048, 4096, 16384, 65536};
+    double sink = 0.0;
+
+    std::printf("%-8s %12s %12s %9s %10s\n", "size", "legacy(ns)", "engine(ns)", "speedup", "max|err|");
+
+    for (size_t size : sizes) {
+        auto corpus = makeCorpus(size, 16);
+        size_t iterations = std::max<size_t>(1, (4u << 20) / (size * corpus.size()));
+
+        double maxErr = 0.0;
+        for (const auto& s : corpus) {
+            maxErr = std::max(maxErr, std::fabs(legacyEntropy(s) - EntropyEngine::compute(s)));
+        }
+
+        double legacy = nsPerCall(corpus, iterations, legacyEntropy, sink);
+        double engine = nsPerCall(corpus, iterations,
+                                  [](const std::string& s) { return EntropyEngine::compute(s); }, sink);
+        std::printf("%-8zu %12.1f %12.1f %8.1fx %10.2e\n", size, legacy, engine, legacy / engine, maxErr);
+    }
+
+    return (sink == 42.0) ? 1 : 0; // ne optimalizálja ki a fordító
+}
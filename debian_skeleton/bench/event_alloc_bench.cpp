@@ -0,0 +1,96 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Allokáció-számláló stressz: 50k esemény a Vent Buson (STRESS_TEST_REPORT_v2.1 mintájára)
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+
+namespace {
+    std::atomic<uint64_t> g_allocs{0};
+}
+
+void* operator new(size_t size) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+    // 50 producer szál, összesen `events` esemény – a v2.1 "HEAVY_STRESS_BATCH" fázis alakja
+    void burst(Venom::Core::VenomBus& bus, Venom::Core::SourceId src, size_t events, int producers) {
+        const char text[] = "HEAVY_STRESS_BATCH payload line";
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+        for (int t = 0; t < producers; ++t) {
+            threads.emplace_back([&bus, src, events, producers, &text] {
+                Venom::Core::NetAddress peer = Venom::Core::NetAddress::fromV4(htonl(0x7f000001));
+                for (size_t i = 0; i < events / producers; ++i) {
+                    bus.pushEvent(src, Venom::Core::EventOrigin::NETWORK,
+                                  std::string_view(text, sizeof(text) - 1), Venom::Core::EVENT_FLAG_NONE, &peer);
+                    if ((i & 31) == 0) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        // Megvárjuk, amíg a drain kiüríti a gyűrűt
+        while (bus.getTelemetrySnapshot().queue_current > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t events = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    const int producers = 50;
+
+    Venom::Core::Scheduler scheduler;
+    Venom::Core::VenomBus bus;
+    // A löketek szándékosan telítik a sort: a tehermentesítés nélküli push/drain utat mérjük
+    bus.setOverloadPolicy(Venom::Core::OverloadPolicy::disabled());
+    rxcpp::composite_subscription lifetime;
+    bus.startReactive(lifetime, scheduler);
+    Venom::Core::SourceId src = bus.registerSource("NET_SOCKET_8888");
+
+    // Bemelegítés: a pool slabjai és a drain puffer itt foglalódnak le
+    burst(bus, src, events, producers);
+
+    auto before = bus.getTelemetrySnapshot();
+    // A szálindítás saját allokációit kivonjuk: csak a push/drain ciklust mérjük
+    uint64_t a0 = g_allocs.load();
+    {
+        std::vector<std::thread> probe;
+        probe.reserve(producers);
+        for (int t = 0; t < producers; ++t) probe.emplace_back([] {});
+        for (auto& th : probe) th.join();
+    }
+    uint64_t threadOverhead = g_allocs.load() - a0;
+
+    uint64_t start = g_allocs.load();
+    burst(bus, src, events, producers);
+    uint64_t used = g_allocs.load() - start - threadOverhead;
+    auto after = bus.getTelemetrySnapshot();
+
+    lifetime.unsubscribe();
+    bus.stop();
+
+    uint64_t delivered = after.total - before.total;
+    std::printf("events pushed      : %llu\n", static_cast<unsigned long long>(delivered));
+    std::printf("heap allocations   : %llu\n", static_cast<unsigned long long>(used));
+    std::printf("allocations/event  : %.4f\n", delivered ? static_cast<double>(used) / delivered : 0.0);
+    std::printf("null_routed/dropped: %llu / %llu\n",
+                static_cast<unsigned long long>(after.null_routed - before.null_routed),
+                static_cast<unsigned long long>(after.dropped - before.dropped));
+    return 0;
+}
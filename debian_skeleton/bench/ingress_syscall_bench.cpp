@@ -0,0 +1,250 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Ingress backend összehasonlítás: rendszerhívás/kapcsolat és kapcsolat/sec
+// (LEGACY_ACCEPT / EPOLL / IO_URING)
+//
+// Használat: ingress_syscall_bench [kapcsolatok=5000] [párhuzamos=500] [port=19888]
+//
+// A szerver (VenomBus + SocketProbe) külön folyamatban fut. Backendenként két menet:
+//  1. nyomkövetés nélkül: kapcsolat/sec a terhelő kliens szerint;
+//  2. ptrace alatt: a szerver összes szálának rendszerhívás-belépéseit számoljuk
+//     (PTRACE_GET_SYSCALL_INFO), csak a kliens mérési ablakában. A ptrace lassít,
+//     ezért ebből a menetből csak a darabszám számít, az idő nem.
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "load_client.hpp"
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+#include "core/SocketProbe.hpp"
+
+using Venom::Core::IngressBackend;
+using namespace VenomBench;
+
+namespace {
+
+    volatile sig_atomic_t g_terminate = 0;
+
+    void onTerminate(int) { g_terminate = 1; }
+
+    struct PassResult {
+        LoadResult load;
+        IngressBackend active = IngressBackend::LEGACY_ACCEPT;
+        uint64_t syscalls = 0;
+        std::map<uint64_t, uint64_t> byNumber;
+    };
+
+    const char* syscallName(uint64_t nr) {
+        switch (nr) {
+            case SYS_accept: return "accept";
+            case SYS_accept4: return "accept4";
+            case SYS_read: return "read";
+            case SYS_recvfrom: return "recvfrom";
+            case SYS_write: return "write";
+            case SYS_close: return "close";
+            case SYS_setsockopt: return "setsockopt";
+            case SYS_getpeername: return "getpeername";
+            case SYS_epoll_wait: return "epoll_wait";
+            case SYS_epoll_pwait: return "epoll_pwait";
+            case SYS_epoll_ctl: return "epoll_ctl";
+            case SYS_io_uring_enter: return "io_uring_enter";
+            case SYS_futex: return "futex";
+            case SYS_sched_yield: return "sched_yield";
+            case SYS_clock_nanosleep: return "clock_nanosleep";
+            case SYS_nanosleep: return "nanosleep";
+            case SYS_mmap: return "mmap";
+            case SYS_munmap: return "munmap";
+            case SYS_madvise: return "madvise";
+            case SYS_mprotect: return "mprotect";
+            default: return nullptr;
+        }
+    }
+
+    const char* backendName(IngressBackend b) {
+        switch (b) {
+            case IngressBackend::LEGACY_ACCEPT: return "legacy";
+            case IngressBackend::EPOLL: return "epoll";
+            case IngressBackend::EPOLL_REUSEPORT: return "reuseport";
+            case IngressBackend::IO_URING: return "io_uring";
+        }
+        return "?";
+    }
+
+    [[noreturn]] void serveChild(IngressBackend backend, int port, int readyFd, bool traced) {
+        if (traced) {
+            ptrace(PTRACE_TRACEME, 0, nullptr, nullptr);
+            raise(SIGSTOP);
+        }
+
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+
+        sigset_t block, old;
+        sigemptyset(&block);
+        sigaddset(&block, SIGTERM);
+        sigprocmask(SIG_BLOCK, &block, &old);
+        std::signal(SIGTERM, onTerminate);
+        raiseFdLimit();
+
+        {
+            Venom::Core::Scheduler scheduler;
+            Venom::Core::VenomBus bus;
+            rxcpp::composite_subscription lifetime;
+            bus.startReactive(lifetime, scheduler);
+
+            Venom::Core::SocketProbe probe(bus, port, Venom::Core::LogLevel::SILENT);
+            probe.setBackend(backend);
+            probe.setMaxConnections(65536);
+            probe.start();
+
+            uint8_t active = static_cast<uint8_t>(probe.activeBackend());
+            ssize_t ignored = write(readyFd, &active, 1);
+            (void)ignored;
+
+            // Alvás SIGTERM-ig, ébresztő rendszerhívások nélkül (nem torzítja a számlálást)
+            while (!g_terminate) sigsuspend(&old);
+
+            probe.stop();
+            lifetime.unsubscribe();
+            bus.stop();
+        }
+        _exit(0);
+    }
+
+    void traceUntilExit(pid_t child, const std::atomic<bool>& counting, PassResult& out) {
+        int status = 0;
+        waitpid(child, &status, __WALL); // A gyermek SIGSTOP-ja
+        ptrace(PTRACE_SETOPTIONS, child, nullptr,
+               PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_EXITKILL);
+        ptrace(PTRACE_SYSCALL, child, nullptr, nullptr);
+
+        std::set<pid_t> known{child};
+        for (;;) {
+            pid_t tid = waitpid(-1, &status, __WALL);
+            if (tid < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (WIFEXITED(status) || WIFSIGNALED(status)) {
+                known.erase(tid);
+                if (tid == child) break;
+                continue;
+            }
+            if (!WIFSTOPPED(status)) continue;
+
+            int sig = WSTOPSIG(status);
+            int deliver = 0;
+            if (sig == (SIGTRAP | 0x80)) {
+                if (counting.load(std::memory_order_relaxed)) {
+                    __ptrace_syscall_info info{};
+                    if (ptrace(PTRACE_GET_SYSCALL_INFO, tid, sizeof(info), &info) > 0 &&
+                        info.op == PTRACE_SYSCALL_INFO_ENTRY) {
+                        out.syscalls++;
+                        out.byNumber[info.entry.nr]++;
+                    }
+                }
+            } else if (sig == SIGTRAP) {
+                // PTRACE_EVENT_CLONE: az új szál automatikusan nyomkövetett
+            } else if (sig == SIGSTOP && !known.count(tid)) {
+                known.insert(tid); // Új szál induló SIGSTOP-ja: elnyeljük
+            } else {
+                deliver = sig;
+            }
+            ptrace(PTRACE_SYSCALL, tid, nullptr, reinterpret_cast<void*>(static_cast<intptr_t>(deliver)));
+        }
+    }
+
+    PassResult runPass(IngressBackend backend, int port, size_t total, size_t concurrency, bool traced) {
+        int ready[2];
+        if (pipe(ready) != 0) return {};
+
+        pid_t child = fork();
+        if (child == 0) {
+            close(ready[0]);
+            serveChild(backend, port, ready[1], traced);
+        }
+        close(ready[1]);
+
+        PassResult out;
+        std::atomic<bool> counting{false};
+        std::thread client([&] {
+            uint8_t active = 0;
+            if (read(ready[0], &active, 1) == 1) {
+                out.active = static_cast<IngressBackend>(active);
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                double clientCpu = 0.0;
+                counting.store(true);
+                out.load = drive(port, total, concurrency, clientCpu);
+                counting.store(false);
+            }
+            kill(child, SIGTERM);
+        });
+
+        if (traced) {
+            traceUntilExit(child, counting, out);
+        }
+        client.join();
+        if (!traced) {
+            int status = 0;
+            waitpid(child, &status, 0);
+        }
+        close(ready[0]);
+        return out;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 5000;
+    size_t concurrency = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 500;
+    int port = (argc > 3) ? std::atoi(argv[3]) : 19888;
+    concurrency = std::max<size_t>(1, std::min(concurrency, total));
+
+    raiseFdLimit();
+    if (concurrency > concurrencyBudget()) {
+        concurrency = concurrencyBudget();
+        std::printf("# RLIMIT_NOFILE: párhuzamosság %zu-ra korlátozva\n", concurrency);
+    }
+
+    std::printf("%-10s %-10s %8s %12s %14s  %s\n",
+                "requested", "active", "ok", "conn/sec", "syscalls/conn", "top syscalls (/conn)");
+
+    const IngressBackend cases[] = {IngressBackend::LEGACY_ACCEPT, IngressBackend::EPOLL, IngressBackend::IO_URING};
+    int p = port;
+    for (IngressBackend backend : cases) {
+        // Külön port menetenként: a TIME_WAIT socketek ne zavarják a következőt
+        PassResult timed = runPass(backend, p++, total, concurrency, false);
+        PassResult counted = runPass(backend, p++, total, concurrency, true);
+
+        double conns = static_cast<double>(std::max<size_t>(1, counted.load.completed));
+        std::printf("%-10s %-10s %8zu %12.0f %14.2f ",
+                    backendName(backend), backendName(timed.active), timed.load.completed,
+                    timed.load.seconds > 0 ? static_cast<double>(timed.load.completed) / timed.load.seconds : 0.0,
+                    static_cast<double>(counted.syscalls) / conns);
+
+        std::vector<std::pair<uint64_t, uint64_t>> top(counted.byNumber.begin(), counted.byNumber.end());
+        std::sort(top.begin(), top.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        for (size_t i = 0; i < top.size() && i < 5; ++i) {
+            const char* name = syscallName(top[i].first);
+            if (name) std::printf(" %s=%.2f", name, static_cast<double>(top[i].second) / conns);
+            else std::printf(" #%llu=%.2f", static_cast<unsigned long long>(top[i].first),
+                             static_cast<double>(top[i].second) / conns);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Közös terhelő kliens a SocketProbe benchmarkokhoz (egy szál, saját epoll hurok)
+//
+// A kliens nem blokkoló connect()-tel tartja nyitva a párhuzamos kapcsolatokat;
+// mindegyik egy rövid kérést küld, SHUT_WR-rel jelzi a végét, majd a szerver
+// oldali lezárásig mér (connect() -> EOF).
+
+#ifndef VENOM_BENCH_LOAD_CLIENT_HPP
+#define VENOM_BENCH_LOAD_CLIENT_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace VenomBench {
+
+    using Clock = std::chrono::steady_clock;
+
+    inline constexpr char PAYLOAD[] = "GET /healthz HTTP/1.1\r\nHost: venom\r\n\r\n";
+    inline constexpr auto CONN_TIMEOUT = std::chrono::seconds(10);
+
+    struct ClientConn {
+        int fd = -1;
+        bool sent = false;
+        Clock::time_point started;
+    };
+
+    struct LoadResult {
+        size_t completed = 0;
+        size_t failed = 0;
+        double seconds = 0.0;
+        double cpuUsPerConn = 0.0;
+        double p50Us = 0.0, p99Us = 0.0, p999Us = 0.0;
+        uint32_t shards = 0;
+        double imbalance = 1.0;
+    };
+
+    inline double cpuSeconds(int who) {
+        rusage ru{};
+        getrusage(who, &ru);
+        return static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+               static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+    }
+
+    inline void raiseFdLimit() {
+        rlimit rl{};
+        if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+            rl.rlim_cur = rl.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &rl);
+        }
+    }
+
+    // Kliens + szerver egy gépen: kapcsolatonként két leíró, plusz tartalék a folyamatoknak
+    inline size_t concurrencyBudget() {
+        rlimit rl{};
+        if (getrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur == RLIM_INFINITY) {
+            return std::numeric_limits<size_t>::max();
+        }
+        return rl.rlim_cur > 512 ? static_cast<size_t>(rl.rlim_cur - 512) / 2 : 1;
+    }
+
+    inline int openClient(const sockaddr_in& target) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        int rc = connect(fd, reinterpret_cast<const sockaddr*>(&target), sizeof(target));
+        if (rc < 0 && errno != EINPROGRESS) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // A kliens a hívó szálon fut; CPU-ja a RUSAGE_THREAD-del levonható a folyamatéból
+    inline LoadResult drive(int port, size_t total, size_t concurrency, double& clientCpu) {
+        sockaddr_in target{};
+        target.sin_family = AF_INET;
+        target.sin_port = htons(static_cast<uint16_t>(port));
+        target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int ep = epoll_create1(EPOLL_CLOEXEC);
+        std::vector<ClientConn> slots(concurrency);
+        std::vector<size_t> freeSlots;
+        for (size_t i = concurrency; i-- > 0;) freeSlots.push_back(i);
+        std::vector<uint32_t> latencies;
+        latencies.reserve(total);
+
+        LoadResult r{};
+        size_t launched = 0;
+        size_t inFlight = 0;
+        double cpu0 = cpuSeconds(RUSAGE_THREAD);
+        auto start = Clock::now();
+
+        auto finish = [&](size_t idx, bool ok) {
+            ClientConn& c = slots[idx];
+            if (ok) {
+                latencies.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - c.started).count()));
+                r.completed++;
+            } else {
+                r.failed++;
+            }
+            close(c.fd);
+            c.fd = -1;
+            freeSlots.push_back(idx);
+            inFlight--;
+        };
+
+        std::vector<epoll_event> events(1024);
+        auto lastReap = Clock::now();
+        while (r.completed + r.failed < total) {
+            while (launched < total && !freeSlots.empty()) {
+                size_t idx = freeSlots.back();
+                int fd = openClient(target);
+                launched++;
+                if (fd < 0) { r.failed++; continue; }
+                freeSlots.pop_back();
+                slots[idx] = ClientConn{fd, false, Clock::now()};
+                epoll_event ev{};
+                ev.events = EPOLLOUT | EPOLLIN | EPOLLRDHUP;
+                ev.data.u64 = idx;
+                epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+                inFlight++;
+            }
+
+            int n = epoll_wait(ep, events.data(), static_cast<int>(events.size()), 100);
+            for (int i = 0; i < n; ++i) {
+                size_t idx = events[i].data.u64;
+                ClientConn& c = slots[idx];
+                if (c.fd < 0) continue;
+                uint32_t e = events[i].events;
+
+                if (!c.sent && (e & EPOLLOUT)) {
+                    int err = 0;
+                    socklen_t len = sizeof(err);
+                    getsockopt(c.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                    if (err != 0 || send(c.fd, PAYLOAD, sizeof(PAYLOAD) - 1, MSG_NOSIGNAL) < 0) {
+                        finish(idx, false);
+                        continue;
+                    }
+                    shutdown(c.fd, SHUT_WR);
+                    c.sent = true;
+                    epoll_event ev{};
+                    ev.events = EPOLLIN | EPOLLRDHUP;
+                    ev.data.u64 = idx;
+                    epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &ev);
+                    continue;
+                }
+
+                if (c.sent && (e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                    char sink[256];
+                    ssize_t got = recv(c.fd, sink, sizeof(sink), 0);
+                    if (got == 0) finish(idx, true);
+                    else if (got < 0 && errno != EAGAIN) finish(idx, (errno == ECONNRESET));
+                } else if (e & (EPOLLERR | EPOLLHUP)) {
+                    finish(idx, false);
+                }
+            }
+
+            // Beragadt kapcsolatok (pl. telített backlog) ne akasszák meg a mérést
+            auto now = Clock::now();
+            if (now - lastReap > std::chrono::milliseconds(500)) {
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    if (slots[i].fd >= 0 && now - slots[i].started > CONN_TIMEOUT) finish(i, false);
+                }
+                lastReap = now;
+            }
+        }
+
+        r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        clientCpu = cpuSeconds(RUSAGE_THREAD) - cpu0;
+        close(ep);
+
+        std::sort(latencies.begin(), latencies.end());
+        auto pct = [&](size_t num, size_t den) {
+            return latencies.empty() ? 0.0 : static_cast<double>(latencies[(latencies.size() * num) / den]);
+        };
+        r.p50Us = pct(50, 100);
+        r.p99Us = pct(99, 100);
+        r.p999Us = pct(999, 1000);
+        return r;
+    }
+
+} // namespace VenomBench
+
+#endif // VENOM_BENCH_LOAD_CLIENT_HPP
@@ -0,0 +1,264 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Túlterhelés-állapotgép és fokozatos tehermentesítés: hiszterézis és a megtartott események késleltetése
+//
+// Használat: overload_bench [flood_ms=1500] [producers=4]
+//
+// 1. OverloadController szintetikus mintákkal (10 ms-os lépések), golden:
+//    - emelkedő késleltetés: UP -> DEGRADED -> OVERLOAD -> NULL_ONLY azonnal követi
+//    - a DEGRADED belépési küszöbe körül ingadozó késleltetés: pontosan 1 váltás (nincs billegés)
+//    - nyugalomban szintenként coolDown (500 ms) után lép vissza: NULL_ONLY -> UP 1500 ms
+//    - tele sor kis késleltetéssel is OVERLOAD (töltöttségi küszöb)
+// 2. árvíz a VenomBus-on: producers szál véletlen bináris hálózati eseményt tol flood_ms ideig,
+//    közben 1 ms-onként egy FILESYSTEM esemény. A partitionStream feliratkozója a megtartott
+//    események késleltetését (beküldés -> pontozás) méri. Kétszer: kikapcsolt vezérlővel és
+//    az alapértelmezett policy-val. Riport: p50 / p99 / max késleltetés, megtartott / elhagyott,
+//    a legmagasabb állapot. Golden (a vezérelt futásra): accepted + null_routed + dropped = total,
+//    legalább DEGRADED-ig lép, van elhagyott esemény, és az árvíz után 3 s-on belül UP.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "veth_frames.hpp"
+#include "core/OverloadController.hpp"
+#include "core/Scheduler.hpp"
+#include "core/VenomBus.hpp"
+
+using namespace Venom::Core;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    constexpr uint64_t STEP_NS = 10'000'000;   // 10 ms
+
+    const char* stateName(BusState s) {
+        switch (s) {
+            case BusState::UP: return "UP";
+            case BusState::DEGRADED: return "DEGRADED";
+            case BusState::OVERLOAD: return "OVERLOAD";
+            case BusState::NULL_ONLY: return "NULL_ONLY";
+        }
+        return "?";
+    }
+
+    uint64_t nowNs() {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    // Szintetikus minta: csak a mért ablak-késleltetés (üres sor) vagy csak a töltöttség
+    OverloadController::Sample sojournSample(uint64_t t, double ms) {
+        OverloadController::Sample s;
+        s.nowNs = t;
+        s.capacity = 1024;
+        s.maxSojournNs = static_cast<uint64_t>(ms * 1e6);
+        return s;
+    }
+
+    int controllerGoldens() {
+        int failures = 0;
+        uint64_t t = STEP_NS;
+
+        {
+            OverloadController c;
+            const double ramp[] = {0.2, 3.0, 15.0, 50.0};
+            const BusState want[] = {BusState::UP, BusState::DEGRADED, BusState::OVERLOAD, BusState::NULL_ONLY};
+            uint64_t ok = 0;
+            for (int i = 0; i < 4; ++i, t += STEP_NS) ok += c.update(sojournSample(t, ramp[i])) == want[i];
+            std::printf("  emelkedő késleltetés: %s, %llu váltás\n", stateName(c.state()),
+                        static_cast<unsigned long long>(c.transitions()));
+            failures += VenomBench::check("    ramp steps matched", ok, 4);
+        }
+        {
+            OverloadController c;
+            for (int i = 0; i < 200; ++i, t += STEP_NS) c.update(sojournSample(t, (i & 1) ? 1.5 : 2.5));
+            std::printf("  2.5 / 1.5 ms ingadozás 2 s-ig: %s, %llu váltás\n", stateName(c.state()),
+                        static_cast<unsigned long long>(c.transitions()));
+            failures += VenomBench::check("    flapping transitions", c.transitions(), 1);
+        }
+        {
+            OverloadController c;
+            c.update(sojournSample(t, 100.0));
+            const uint64_t calmFrom = t + STEP_NS;
+            uint64_t upAfterMs = 0;
+            for (t = calmFrom; t < calmFrom + 3'000'000'000ull; t += STEP_NS) {
+                if (c.update(sojournSample(t, 0.0)) == BusState::UP) {
+                    upAfterMs = (t - calmFrom) / 1'000'000;
+                    break;
+                }
+            }
+            std::printf("  NULL_ONLY -> UP nyugalomban: %llu ms (%llu váltás)\n",
+                        static_cast<unsigned long long>(upAfterMs), static_cast<unsigned long long>(c.transitions()));
+            failures += VenomBench::check("    recovery ms", upAfterMs, 1500);
+            failures += VenomBench::check("    recovery transitions", c.transitions(), 4);
+        }
+        {
+            OverloadController c;
+            OverloadController::Sample s;
+            // Gyors drain (1M/s) mellett is: a 90%-os töltöttség önmagában OVERLOAD
+            for (int i = 0; i < 3; ++i, t += STEP_NS) {
+                s.nowNs = t;
+                s.capacity = 1024;
+                s.depth = 920;
+                s.drained += 10'000;
+                c.update(s);
+            }
+            std::printf("  90%%-os sor, %.0f esemény/s: %s (becsült várakozás %.2f ms)\n", c.drainRate(),
+                        stateName(c.state()), c.delayMs());
+            failures += VenomBench::check("    fill -> OVERLOAD", c.state() == BusState::OVERLOAD ? 1 : 0, 1);
+        }
+        return failures;
+    }
+
+    struct FloodResult {
+        double p50Us = 0, p99Us = 0, maxUs = 0;
+        double fsP99Us = 0;
+        uint64_t kept = 0;
+        uint64_t total = 0, accepted = 0, nullRouted = 0, dropped = 0;
+        BusState peak = BusState::UP;
+        uint64_t recoverMs = 0;
+        bool recovered = false;
+        uint64_t transitions = 0;
+    };
+
+    double percentile(std::vector<double>& v, double q) {
+        if (v.empty()) return 0.0;
+        std::sort(v.begin(), v.end());
+        return v[std::min(v.size() - 1, static_cast<size_t>(q * static_cast<double>(v.size())))];
+    }
+
+    FloodResult flood(const OverloadPolicy& policy, unsigned producers, int floodMs,
+                      const std::vector<std::string>& payloads) {
+        Scheduler scheduler(1);
+        VenomBus bus;
+        bus.setOverloadPolicy(policy);
+        std::atomic<int> peak{static_cast<int>(BusState::UP)};
+        bus.setStateCallback([&peak](BusState s) {
+            int cur = peak.load();
+            while (static_cast<int>(s) > cur && !peak.compare_exchange_weak(cur, static_cast<int>(s))) {
+            }
+        });
+
+        // A feliratkozó egyetlen szálon fut (N = 1: a drain szál)
+        const SourceId net = bus.registerSource("NET_SOCKET_8888");
+        const SourceId fs = bus.registerSource("FS_WATCH");
+        std::vector<double> latUs, fsLatUs;
+        latUs.reserve(4 << 20);
+        fsLatUs.reserve(1 << 14);
+        rxcpp::composite_subscription lifetime;
+        bus.partitionStream(0).subscribe(lifetime, [&](const VentWindow& window) {
+            const uint64_t now = nowNs();
+            for (const VentEvent& ev : window) {
+                const double us = static_cast<double>(now - ev.header.timestampNs) / 1e3;
+                if (latUs.size() < latUs.capacity()) latUs.push_back(us);
+                if (ev.header.source == fs && fsLatUs.size() < fsLatUs.capacity()) fsLatUs.push_back(us);
+            }
+        });
+        bus.startReactive(lifetime, scheduler);
+
+        std::atomic<bool> running{true};
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < producers; ++t) {
+            threads.emplace_back([&, t] {
+                const IngressLane lane = bus.openLane();
+                const NetAddress peer = NetAddress::fromV4(htonl(0x0a020000u | (t + 1)));
+                size_t i = t;
+                while (running.load(std::memory_order_relaxed)) {
+                    const std::string& p = payloads[i++ % payloads.size()];
+                    bus.pushEvent(lane, net, EventOrigin::NETWORK, p, EVENT_FLAG_NONE, &peer);
+                }
+            });
+        }
+        threads.emplace_back([&] {
+            while (running.load(std::memory_order_relaxed)) {
+                bus.pushEvent(fs, EventOrigin::FILESYSTEM, {"FS_WATCH: MODIFY /etc/passwd"});
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(floodMs));
+        running = false;
+        for (auto& th : threads) th.join();
+
+        FloodResult r;
+        const auto calm0 = Clock::now();
+        while (Clock::now() - calm0 < std::chrono::seconds(3)) {
+            if (bus.getState() == BusState::UP && bus.getTelemetrySnapshot().queue_current == 0) {
+                r.recovered = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        r.recoverMs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - calm0).count());
+        lifetime.unsubscribe();
+        bus.stop();
+
+        const TelemetrySnapshot snap = bus.getTelemetrySnapshot();
+        r.total = snap.total;
+        r.accepted = snap.accepted;
+        r.nullRouted = snap.null_routed;
+        r.dropped = snap.dropped;
+        r.transitions = snap.state_transitions;
+        r.peak = static_cast<BusState>(peak.load());
+        r.kept = latUs.size();
+        r.p50Us = percentile(latUs, 0.50);
+        r.p99Us = percentile(latUs, 0.99);
+        r.maxUs = latUs.empty() ? 0.0 : latUs.back();
+        r.fsP99Us = percentile(fsLatUs, 0.99);
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int floodMs = (argc > 1) ? std::atoi(argv[1]) : 1500;
+    unsigned producers = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 4;
+    if (floodMs <= 0) floodMs = 1500;
+    if (producers == 0) producers = 4;
+    int failures = 0;
+
+    std::printf("OverloadController (10 ms-os minták):\n");
+    failures += controllerGoldens();
+
+    // Véletlen bináris payloadok: minden esemény teljes entrópia-pontozást kér
+    std::mt19937 rng(7);
+    std::vector<std::string> payloads(512);
+    for (auto& p : payloads) {
+        p.resize(192 + rng() % 64);
+        for (auto& c : p) c = static_cast<char>(rng());
+    }
+
+    std::printf("árvíz: %u producer, %d ms, %u mag:\n", producers, floodMs, std::thread::hardware_concurrency());
+    std::printf("  %-12s %10s %10s %10s %10s %10s %10s %10s %10s\n", "vezérlő", "p50 us", "p99 us", "max us",
+                "FS p99 us", "megtartott", "elhagyott", "csúcs", "vissza ms");
+    struct Run {
+        const char* name;
+        OverloadPolicy policy;
+    };
+    const Run runs[] = {{"kikapcsolva", OverloadPolicy::disabled()}, {"alapértelm.", OverloadPolicy{}}};
+    for (const Run& run : runs) {
+        const FloodResult r = flood(run.policy, producers, floodMs, payloads);
+        std::printf("  %-12s %10.1f %10.1f %10.1f %10.1f %10llu %10llu %10s %10llu\n", run.name, r.p50Us, r.p99Us,
+                    r.maxUs, r.fsP99Us, static_cast<unsigned long long>(r.kept),
+                    static_cast<unsigned long long>(r.dropped), stateName(r.peak),
+                    static_cast<unsigned long long>(r.recoverMs));
+        failures += VenomBench::check("    accepted + null_routed + dropped", r.accepted + r.nullRouted + r.dropped,
+                                      r.total);
+        if (&run == &runs[1]) {
+            failures += VenomBench::check("    reached DEGRADED or above", r.peak != BusState::UP ? 1 : 0, 1);
+            failures += VenomBench::check("    shed events > 0", r.dropped > 0 ? 1 : 0, 1);
+            failures += VenomBench::check("    back to UP within 3 s", r.recovered ? 1 : 0, 1);
+        } else {
+            failures += VenomBench::check("    disabled: transitions", r.transitions, 0);
+        }
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
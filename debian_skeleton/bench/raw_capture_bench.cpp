@@ -0,0 +1,139 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// RawPacketProbe (TPACKET_V3) ellenőrzés + áteresztés egy privát netns veth párján
+//
+// Használat: raw_capture_bench [flood=200000] [blokk_KiB=1024] [blokkok=16] [workerek=1]
+//
+// 1. golden menet: ismert keretek (ARP, spoofolt ARP, megbízható router ARP, IPv4/UDP,
+//    IPv6/UDP Hop-by-Hop kiterjesztéssel, VLAN-címkés IPv4, csonka IPv4) a "va" végen,
+//    a probe a "vb" végen fut. A probe és a busz számlálóinak pontosan egyezniük kell.
+// 2. flood: keret/sec és ring-eldobás (tp_drops) az adott ring-geometriával.
+// Root (CAP_NET_ADMIN + CAP_NET_RAW) kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "veth_frames.hpp"
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+#include "core/RawPacketProbe.hpp"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+int main(int argc, char* argv[]) {
+    size_t flood = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    uint32_t blockKiB = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1024;
+    uint32_t blocks = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 16;
+    unsigned workers = (argc > 4) ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10)) : 1;
+
+    if (!setupVeth()) {
+        std::printf("raw_capture_bench: skipped (netns/veth nem hozható létre: root kell)\n");
+        return 0;
+    }
+    int tx = openInjector("va");
+    if (tx < 0) {
+        std::printf("raw_capture_bench: skipped (AF_PACKET injektor: %s)\n", std::strerror(errno));
+        return 0;
+    }
+
+    Scheduler scheduler;
+    VenomBus bus;
+    rxcpp::composite_subscription lifetime;
+    bus.startReactive(lifetime, scheduler);
+
+    int failures = 0;
+
+    // --- 1. golden menet ---
+    {
+        RawPacketProbe probe(bus, "vb");
+        probe.allowRouter("02:00:00:00:00:01");
+        if (!probe.start()) {
+            std::printf("raw_capture_bench: skipped (TPACKET_V3 ring nem nyitható)\n");
+            return 0;
+        }
+
+        const std::string text = "hello venom hello venom";
+        const size_t V4 = 10, V6 = 10, VLAN = 5, BAD = 3, ARP_ATTACK = 5;
+        std::vector<Frame> frames;
+        for (size_t i = 0; i < V4; ++i) frames.push_back(udp4("10.0.0.66", "10.0.0.187", text));
+        for (size_t i = 0; i < V6; ++i) frames.push_back(udp6HopByHop(text));
+        for (size_t i = 0; i < VLAN; ++i) frames.push_back(udp4("10.0.0.66", "10.0.0.187", text, 42));
+        for (size_t i = 0; i < BAD; ++i) frames.push_back(truncatedV4());
+        frames.push_back(arp(MAC_ROUTER, MAC_ROUTER, "10.0.0.1", "10.0.0.187"));     // megbízható
+        frames.push_back(arp(MAC_ATTACKER, MAC_ROUTER, "10.0.0.1", "10.0.0.187"));   // router-MAC spoof
+        for (size_t i = 0; i < ARP_ATTACK; ++i) {
+            frames.push_back(arp(MAC_ATTACKER, MAC_ATTACKER, "10.0.0.66", "10.0.0.187"));
+        }
+
+        for (const auto& f : frames) inject(tx, f);
+        const uint64_t total = frames.size();
+        waitFor([&] { return probe.stats().packets >= total; });
+
+        const uint64_t flagged = ARP_ATTACK + 1;
+        const uint64_t ipEvents = V4 + V6 + VLAN;
+        waitFor([&] {
+            TelemetrySnapshot s = bus.getTelemetrySnapshot();
+            return s.null_routed + s.accepted >= flagged + ipEvents;
+        });
+        probe.stop();
+
+        RawCaptureStats st = probe.stats();
+        TelemetrySnapshot snap = bus.getTelemetrySnapshot();
+        std::printf("golden (TPACKET_V3, %u worker):\n", st.workers);
+        failures += check("packets", st.packets, total);
+        failures += check("ipv4 (VLAN-nal)", st.ipv4, V4 + VLAN);
+        failures += check("ipv6", st.ipv6, V6);
+        failures += check("arp", st.arp, ARP_ATTACK + 2);
+        failures += check("arp trusted", st.arpTrusted, 1);
+        failures += check("malformed", st.malformed, BAD);
+        failures += check("ring drops", st.ringDrops, 0);
+        failures += check("bus null_routed (ARP)", snap.null_routed, flagged);
+        failures += check("bus accepted (IP)", snap.accepted, ipEvents);
+        std::string last = bus.getLastFilteredIP();
+        bool lastOk = last == "10.0.0.66";
+        std::printf("  %-22s %8s  (elvárt 10.0.0.66)%s\n", "last filtered", last.c_str(), lastOk ? "" : "  MISMATCH");
+        if (!lastOk) failures++;
+    }
+
+    // --- 2. flood: áteresztés és ring-eldobás ---
+    if (flood > 0) {
+        RawPacketProbe probe(bus, "vb");
+        probe.setWorkerCount(workers);
+        probe.setRingGeometry(blockKiB << 10, blocks);
+        if (probe.start()) {
+            // Üres UDP payload: a capture + elemzés útját mérjük, a busz nem telítődik
+            Frame f = udp4("10.0.0.66", "10.0.0.187", "");
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < flood; ++i) {
+                if (!inject(tx, f)) break;
+            }
+            double sendSec = std::chrono::duration<double>(Clock::now() - t0).count();
+            waitFor([&] {
+                RawCaptureStats s = probe.stats();
+                return s.packets + s.ringDrops >= flood;
+            }, std::chrono::milliseconds(1000));
+            double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+            probe.stop();
+
+            RawCaptureStats st = probe.stats();
+            std::printf("flood: %zu keret, ring %u x %u KiB, %u worker\n", flood, blocks, blockKiB, st.workers);
+            std::printf("  injektálás   %10.0f keret/s\n", static_cast<double>(flood) / sendSec);
+            std::printf("  feldolgozva  %10llu (%0.f keret/s), %llu blokk\n",
+                        static_cast<unsigned long long>(st.packets), static_cast<double>(st.packets) / sec,
+                        static_cast<unsigned long long>(st.blocks));
+            std::printf("  ring drops   %10llu, freeze %llu, malformed %llu\n",
+                        static_cast<unsigned long long>(st.ringDrops),
+                        static_cast<unsigned long long>(st.ringFreezes),
+                        static_cast<unsigned long long>(st.malformed));
+            if (st.malformed != 0) failures++;
+        }
+    }
+
+    close(tx);
+    lifetime.unsubscribe();
+    bus.stop();
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Kernel eseménycsatorna: venom_router_guard (generic XDP) -> events_rb -> BpfLoader -> VenomBus
+//
+// Használat: ringbuf_channel_bench [bpf_obj=obj/core/ebpf/venom_shield.bpf.o] [flood=200000] [drop_every=1]
+//
+// Privát netns veth pár, az XDP program a "vb" végen SKB módban.
+// 1. golden menet: feketelistás forrás (DROP), figyelt forrás (SUSPECT) és idegen ARP;
+//    a rekordok, a buszra került (összevont) események és a stats_map pontosan egyezik.
+// 2. flood: egyetlen feketelistás forrás; rekord/s, buszesemény és elveszett rekord
+//    (tele ring) az adott DROP mintavétellel.
+// Root és a lefordított BPF objektum kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "veth_frames.hpp"
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+int main(int argc, char* argv[]) {
+    std::string objPath = (argc > 1) ? argv[1] : "obj/core/ebpf/venom_shield.bpf.o";
+    size_t flood = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    uint32_t dropEvery = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 1;
+
+    if (!setupVeth()) {
+        std::printf("ringbuf_channel_bench: skipped (netns/veth nem hozható létre: root kell)\n");
+        return 0;
+    }
+
+    BpfLoader loader;
+    if (!loader.deploy(objPath, "vb", XdpAttachMode::GENERIC)) {
+        std::printf("ringbuf_channel_bench: skipped (XDP program nem tölthető: %s)\n", objPath.c_str());
+        return 0;
+    }
+    loader.setRouterMAC("02:00:00:00:00:01");
+    loader.blockIP("10.0.0.99");
+    loader.watchIP("10.0.0.66");
+
+    int tx = openInjector("va");
+    if (tx < 0) {
+        std::printf("ringbuf_channel_bench: skipped (AF_PACKET injektor: %s)\n", std::strerror(errno));
+        return 0;
+    }
+
+    Scheduler scheduler;
+    VenomBus bus;
+    rxcpp::composite_subscription lifetime;
+    bus.startReactive(lifetime, scheduler);
+
+    if (!loader.startEventChannel(bus)) {
+        std::printf("ringbuf_channel_bench: skipped (events_rb nem nyitható)\n");
+        return 0;
+    }
+
+    int failures = 0;
+
+    // --- 1. golden menet ---
+    {
+        const std::string text = "hello venom hello venom";
+        const size_t BLOCKED = 20, WATCHED = 10, BENIGN = 10, ARP_ATTACK = 5;
+        std::vector<Frame> frames;
+        for (size_t i = 0; i < BLOCKED; ++i) frames.push_back(udp4("10.0.0.99", "10.0.0.187", text));
+        for (size_t i = 0; i < WATCHED; ++i) frames.push_back(udp4("10.0.0.66", "10.0.0.187", text));
+        for (size_t i = 0; i < BENIGN; ++i) frames.push_back(udp4("10.0.0.77", "10.0.0.187", text));
+        frames.push_back(arp(MAC_ROUTER, MAC_ROUTER, "10.0.0.1", "10.0.0.187"));     // kernelben átengedve
+        for (size_t i = 0; i < ARP_ATTACK; ++i) {
+            frames.push_back(arp(MAC_ATTACKER, MAC_ATTACKER, "10.0.0.66", "10.0.0.187"));
+        }
+
+        for (const auto& f : frames) inject(tx, f);
+        const uint64_t records = BLOCKED + WATCHED + ARP_ATTACK;
+        waitFor([&] { return loader.eventStats().received >= records; });
+        // Az utolsó poll kör összevont DROP-jai és a telemetria-frissítés (250 ms)
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+        EventChannelStats ev = loader.eventStats();
+        BpfStats kernel = loader.getStats();
+        TelemetrySnapshot snap = bus.getTelemetrySnapshot();
+        std::printf("golden (events_rb):\n");
+        failures += check("xdp dropped", kernel.dropped_packets, BLOCKED);
+        failures += check("records", ev.received, records);
+        failures += check("drop records", ev.drops, BLOCKED);
+        failures += check("suspect records", ev.suspects, WATCHED + ARP_ATTACK);
+        failures += check("sample records", ev.samples, 0);
+        failures += check("lost", ev.lost, 0);
+        failures += check("bus kernel_events", snap.kernel_events, records);
+        // Egy poll körbe eső DROP-ok egy eseménnyé vonódnak össze: legfeljebb BLOCKED
+        bool merged = ev.busEvents >= WATCHED + ARP_ATTACK + 1 && ev.busEvents <= records;
+        std::printf("  %-22s %8llu  (DROP összevonva)%s\n", "bus events",
+                    static_cast<unsigned long long>(ev.busEvents), merged ? "" : "  MISMATCH");
+        if (!merged) failures++;
+        failures += check("bus null_routed (ARP)", snap.null_routed, ARP_ATTACK);
+    }
+
+    // --- 2. flood: egyetlen feketelistás forrás ---
+    if (flood > 0) {
+        EventSampling sampling;
+        sampling.dropEvery = dropEvery;
+        loader.setEventSampling(sampling);
+
+        EventChannelStats before = loader.eventStats();
+        BpfStats kBefore = loader.getStats();
+        Frame blocked = udp4("10.0.0.99", "10.0.0.187", "");
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < flood; ++i) {
+            if (!inject(tx, blocked)) break;
+        }
+        double sendSec = std::chrono::duration<double>(Clock::now() - t0).count();
+        waitFor([&] {
+            BpfStats k = loader.getStats();
+            return k.dropped_packets - kBefore.dropped_packets >= flood;
+        }, std::chrono::milliseconds(1000));
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+
+        EventChannelStats ev = loader.eventStats();
+        BpfStats k = loader.getStats();
+        uint64_t recs = ev.received - before.received;
+        std::printf("flood: %zu keret, drop mintavétel 1/%u\n", flood, dropEvery);
+        std::printf("  injektálás   %10.0f keret/s\n", static_cast<double>(flood) / sendSec);
+        std::printf("  xdp drop     %10llu\n",
+                    static_cast<unsigned long long>(k.dropped_packets - kBefore.dropped_packets));
+        std::printf("  rekord       %10llu (%0.f rekord/s)\n",
+                    static_cast<unsigned long long>(recs), static_cast<double>(recs) / sec);
+        std::printf("  buszesemény  %10llu, elveszett %llu\n",
+                    static_cast<unsigned long long>(ev.busEvents - before.busEvents),
+                    static_cast<unsigned long long>(ev.lost - before.lost));
+    }
+
+    close(tx);
+    loader.stopEventChannel();
+    lifetime.unsubscribe();
+    bus.stop();
+    loader.detach();
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Work-stealing pool scheduler vs. rxcpp event_loop / new_thread: áteresztés, ébredési késleltetés
+//
+// Használat: scheduler_bench [tasks=200000] [workers=8] [samples=500]
+//
+// A pool kétszer szerepel: hardware_concurrency és fix 4 szál (lopás egy magon is).
+// 1. fan-out: egy külső szál tasks akciót oszt szét workers rx workerre (körbe), fal-idő / akció.
+// 2. lánc: workers rx worker mindegyike önmagát ütemezi újra (tasks / workers lépés), fal-idő /
+//    akció (poolban a beküldés a worker saját deque-jába megy).
+// 3. ébredés: tétlen scheduler (2 ms szünet a minták között), a beküldéstől az akció indulásáig
+//    eltelt idő p50 / p99.
+// Golden:
+//   - minden akció pontosan egyszer fut le (minden schedulernél)
+//   - egy rx worker akciói soha nem futnak párhuzamosan, és a beküldés sorrendjében futnak
+//   - prioritás: 1 workeres pool, a worker foglalt, közben 64 LOW és 64 HIGH akció érkezik
+//     (mind külön rx workeren); az első 64 lefutóból legalább 60 HIGH (a STARVATION_GUARD
+//     minden 32. keresésnél a LOW osztályt veszi előre)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "veth_frames.hpp"
+#include "rxcpp/rx.hpp"
+#include "core/WorkStealingPool.hpp"
+
+using namespace Venom::Core;
+using rxcpp::schedulers::schedulable;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    struct Named {
+        const char* name;
+        rxcpp::schedulers::scheduler sched;
+    };
+
+    void waitFor(const std::atomic<uint64_t>& counter, uint64_t target) {
+        while (counter.load(std::memory_order_acquire) < target) std::this_thread::yield();
+    }
+
+    std::vector<rxcpp::schedulers::worker> makeWorkers(rxcpp::schedulers::scheduler& sched,
+                                                       rxcpp::composite_subscription& cs, unsigned n) {
+        std::vector<rxcpp::schedulers::worker> out;
+        for (unsigned i = 0; i < n; ++i) out.push_back(sched.create_worker(cs));
+        return out;
+    }
+
+    double fanOut(rxcpp::schedulers::scheduler sched, size_t tasks, unsigned workers, uint64_t& ran) {
+        rxcpp::composite_subscription cs;
+        auto ws = makeWorkers(sched, cs, workers);
+        std::atomic<uint64_t> done{0};
+        const auto t0 = Clock::now();
+        for (size_t i = 0; i < tasks; ++i) {
+            ws[i % workers].schedule([&done](const schedulable&) { done.fetch_add(1, std::memory_order_release); });
+        }
+        waitFor(done, tasks);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        ran = done.load();
+        cs.unsubscribe();
+        return ns / static_cast<double>(tasks);
+    }
+
+    double chain(rxcpp::schedulers::scheduler sched, size_t tasks, unsigned workers, uint64_t& ran) {
+        rxcpp::composite_subscription cs;
+        auto ws = makeWorkers(sched, cs, workers);
+        std::atomic<uint64_t> done{0};
+        const uint64_t steps = tasks / workers;
+        std::vector<uint64_t> left(workers, steps);
+        const auto t0 = Clock::now();
+        for (unsigned w = 0; w < workers; ++w) {
+            uint64_t* mine = &left[w];
+            ws[w].schedule([&done, mine](const schedulable& self) {
+                done.fetch_add(1, std::memory_order_release);
+                if (--*mine > 0) self.schedule();
+            });
+        }
+        waitFor(done, steps * workers);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        ran = done.load();
+        cs.unsubscribe();
+        return ns / static_cast<double>(steps * workers);
+    }
+
+    void wakeup(rxcpp::schedulers::scheduler sched, unsigned samples, double& p50, double& p99) {
+        rxcpp::composite_subscription cs;
+        auto w = sched.create_worker(cs);
+        std::vector<double> lat;
+        lat.reserve(samples);
+        for (unsigned i = 0; i < samples; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::atomic<uint64_t> done{0};
+            double us = 0;
+            const auto t0 = Clock::now();
+            w.schedule([&](const schedulable&) {
+                us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+                done.store(1, std::memory_order_release);
+            });
+            waitFor(done, 1);
+            lat.push_back(us);
+        }
+        cs.unsubscribe();
+        std::sort(lat.begin(), lat.end());
+        p50 = lat[lat.size() / 2];
+        p99 = lat[std::min(lat.size() - 1, lat.size() * 99 / 100)];
+    }
+
+    // Egy rx worker: két külső szál ütemez rá; párhuzamosság és sorrend ellenőrzése
+    void strandCheck(rxcpp::schedulers::scheduler sched, size_t tasks, uint64_t& overlaps, uint64_t& reorders,
+                     uint64_t& ran) {
+        rxcpp::composite_subscription cs;
+        auto w = sched.create_worker(cs);
+        std::atomic<int> inside{0};
+        std::atomic<uint64_t> done{0};
+        std::atomic<uint64_t> overlap{0};
+        uint64_t last[2] = {0, 0};
+        uint64_t reorder = 0;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < 2; ++p) {
+            producers.emplace_back([&, p] {
+                for (uint64_t i = 1; i <= tasks / 2; ++i) {
+                    w.schedule([&, p, i](const schedulable&) {
+                        if (inside.fetch_add(1, std::memory_order_acq_rel) != 0) overlap.fetch_add(1);
+                        if (i <= last[p]) reorder++;
+                        last[p] = i;
+                        inside.fetch_sub(1, std::memory_order_acq_rel);
+                        done.fetch_add(1, std::memory_order_release);
+                    });
+                }
+            });
+        }
+        for (auto& t : producers) t.join();
+        waitFor(done, tasks / 2 * 2);
+        cs.unsubscribe();
+        overlaps = overlap.load();
+        reorders = reorder;
+        ran = done.load();
+    }
+
+    uint64_t priorityCheck() {
+        WorkStealingPool pool(1);
+        auto high = pool.scheduler(WorkStealingPool::Priority::HIGH);
+        auto low = pool.scheduler(WorkStealingPool::Priority::LOW);
+        rxcpp::composite_subscription cs;
+        std::atomic<bool> gate{false};
+        std::atomic<uint64_t> done{0};
+        std::mutex orderMutex;
+        std::vector<int> order;
+
+        // A worker foglalt, amíg mindkét osztály fel nem töltődik
+        auto blocker = high.create_worker(cs);
+        blocker.schedule([&](const schedulable&) {
+            while (!gate.load(std::memory_order_acquire)) std::this_thread::yield();
+        });
+        constexpr int PER_CLASS = 64;
+        std::vector<rxcpp::schedulers::worker> ws;
+        for (int i = 0; i < PER_CLASS; ++i) ws.push_back(low.create_worker(cs));
+        for (int i = 0; i < PER_CLASS; ++i) ws.push_back(high.create_worker(cs));
+        for (int i = 0; i < 2 * PER_CLASS; ++i) {
+            const int cls = i < PER_CLASS ? 2 : 0;
+            ws[i].schedule([&, cls](const schedulable&) {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                order.push_back(cls);
+                done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        gate.store(true, std::memory_order_release);
+        waitFor(done, 2 * PER_CLASS);
+        cs.unsubscribe();
+        return static_cast<uint64_t>(std::count(order.begin(), order.begin() + PER_CLASS, 0));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t tasks = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    unsigned workers = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 8;
+    unsigned samples = (argc > 3) ? static_cast<unsigned>(std::atoi(argv[3])) : 500;
+    if (tasks == 0) tasks = 200000;
+    if (workers == 0) workers = 8;
+    if (samples == 0) samples = 500;
+    int failures = 0;
+
+    WorkStealingPool pool;
+    // Magszámtól függetlenül 4 szál: a lopás egy magon is lefut (a golden-ekhez)
+    WorkStealingPool pool4(4);
+    Named scheds[] = {
+        {"work-stealing", pool.scheduler(WorkStealingPool::Priority::NORMAL)},
+        {"ws (4 szál)", pool4.scheduler(WorkStealingPool::Priority::NORMAL)},
+        {"event_loop", rxcpp::schedulers::make_event_loop()},
+        {"new_thread", rxcpp::schedulers::make_new_thread()},
+    };
+
+    std::printf("%zu akció, %u rx worker, %u pool-szál, %u mag:\n", tasks, workers, pool.workerCount(),
+                std::thread::hardware_concurrency());
+    std::printf("  %-14s %14s %14s %12s %12s\n", "scheduler", "fan-out ns/a", "lánc ns/a", "ébredés p50",
+                "p99 (us)");
+    for (Named& s : scheds) {
+        uint64_t ranFan = 0, ranChain = 0;
+        // Legjobb a 3 menetből (zajos VM)
+        double fan = 1e18, chn = 1e18;
+        for (int pass = 0; pass < 3; ++pass) {
+            fan = std::min(fan, fanOut(s.sched, tasks, workers, ranFan));
+            chn = std::min(chn, chain(s.sched, tasks, workers, ranChain));
+        }
+        double p50 = 0, p99 = 0;
+        wakeup(s.sched, samples, p50, p99);
+        std::printf("  %-14s %14.1f %14.1f %12.1f %12.1f\n", s.name, fan, chn, p50, p99);
+        failures += VenomBench::check("    fan-out executed", ranFan, tasks);
+        failures += VenomBench::check("    chain executed", ranChain, tasks / workers * workers);
+
+        uint64_t overlaps = 0, reorders = 0, ran = 0;
+        strandCheck(s.sched, tasks, overlaps, reorders, ran);
+        failures += VenomBench::check("    worker overlaps", overlaps, 0);
+        failures += VenomBench::check("    worker reorders", reorders, 0);
+        failures += VenomBench::check("    worker executed", ran, tasks / 2 * 2);
+    }
+
+    for (const WorkStealingPool* p : {&pool, &pool4}) {
+        const WorkStealingPool::Stats st = p->stats();
+        std::printf("pool (%u szál): %llu végrehajtott feladat, %llu lopott, %llu injektált, %llu parkolás\n",
+                    p->workerCount(), static_cast<unsigned long long>(st.executed),
+                    static_cast<unsigned long long>(st.stolen), static_cast<unsigned long long>(st.injected),
+                    static_cast<unsigned long long>(st.parks));
+    }
+
+    const uint64_t highFirst = priorityCheck();
+    std::printf("prioritás: az első 64 lefutó akcióból %llu HIGH\n", static_cast<unsigned long long>(highFirst));
+    failures += VenomBench::check("  HIGH in first 64 >= 60", highFirst >= 60 ? 1 : 0, 1);
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
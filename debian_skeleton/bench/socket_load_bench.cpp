@@ -0,0 +1,82 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Terhelési teszt: SocketProbe (LEGACY_ACCEPT / EPOLL / EPOLL_REUSEPORT / IO_URING) – accepts/sec, CPU/kapcsolat, tail latencia
+//
+// Használat: socket_load_bench [kapcsolatok=10000] [párhuzamos=10000] [port=18888] [worker/shard=0 (auto)]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "load_client.hpp"
+#include "core/VenomBus.hpp"
+#include "core/Scheduler.hpp"
+#include "core/SocketProbe.hpp"
+
+using Venom::Core::IngressBackend;
+using namespace VenomBench;
+
+namespace {
+
+    LoadResult runBackend(IngressBackend backend, int port, size_t total, size_t concurrency, unsigned workers) {
+        Venom::Core::Scheduler scheduler;
+        Venom::Core::VenomBus bus;
+        rxcpp::composite_subscription lifetime;
+        bus.startReactive(lifetime, scheduler);
+
+        Venom::Core::SocketProbe probe(bus, port, Venom::Core::LogLevel::SILENT);
+        probe.setBackend(backend);
+        probe.setWorkerCount(workers);
+        probe.setMaxConnections(concurrency + 1024);
+        probe.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        double proc0 = cpuSeconds(RUSAGE_SELF);
+        double clientCpu = 0.0;
+        LoadResult r = drive(port, total, concurrency, clientCpu);
+        double serverCpu = (cpuSeconds(RUSAGE_SELF) - proc0) - clientCpu;
+
+        r.shards = probe.stats().shards;
+        r.imbalance = bus.getTelemetrySnapshot().shard_imbalance;
+        probe.stop();
+        lifetime.unsubscribe();
+        bus.stop();
+
+        r.cpuUsPerConn = r.completed ? (serverCpu * 1e6) / static_cast<double>(r.completed) : 0.0;
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t concurrency = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000;
+    int port = (argc > 3) ? std::atoi(argv[3]) : 18888;
+    unsigned workers = (argc > 4) ? static_cast<unsigned>(std::atoi(argv[4])) : 0;
+    concurrency = std::max<size_t>(1, std::min(concurrency, total));
+
+    raiseFdLimit();
+    if (concurrency > concurrencyBudget()) {
+        concurrency = concurrencyBudget();
+        std::printf("# RLIMIT_NOFILE: párhuzamosság %zu-ra korlátozva\n", concurrency);
+    }
+
+    std::printf("%-10s %8s %7s %12s %12s %10s %10s %10s %7s %10s\n",
+                "backend", "ok", "failed", "accepts/sec", "cpu/conn(us)", "p50(us)", "p99(us)", "p999(us)",
+                "shards", "imbalance");
+
+    struct Case { const char* name; IngressBackend backend; };
+    const Case cases[] = {{"legacy", IngressBackend::LEGACY_ACCEPT}, {"epoll", IngressBackend::EPOLL},
+                           {"reuseport", IngressBackend::EPOLL_REUSEPORT}, {"io_uring", IngressBackend::IO_URING}};
+
+    int p = port;
+    for (const Case& c : cases) {
+        // Külön port: a legacy futás TIME_WAIT socketjei ne zavarják a következőt
+        LoadResult r = runBackend(c.backend, p++, total, concurrency, workers);
+        std::printf("%-10s %8zu %7zu %12.0f %12.1f %10.0f %10.0f %10.0f %7u %10.2f\n",
+                    c.name, r.completed, r.failed, static_cast<double>(r.completed) / r.seconds,
+                    r.cpuUsPerConn, r.p50Us, r.p99Us, r.p999Us, r.shards, r.imbalance);
+    }
+    return 0;
+}
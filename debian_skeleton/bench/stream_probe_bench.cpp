@@ -0,0 +1,167 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Golden-output korpusz + benchmark: StreamProbe::classify vs. a v2.1 többmenetes detectZeroTrust
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/StreamProbe.hpp"
+
+using namespace Venom::Core;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    // --- v2.1 referencia (verbatim): ez adja a golden kimenetet ---
+    double legacyEntropy(const std::string& data) {
+        if (data.empty()) return 0.0;
+        std::map<unsigned char, size_t> frequencies;
+        for (unsigned char c : data) frequencies[c]++;
+        double entropy = 0.0;
+        for (auto const& [val, count] : frequencies) {
+            double p = static_cast<double>(count) / data.size();
+            entropy -= p * std::log2(p);
+        }
+        return entropy;
+    }
+
+    DataType legacyDetect(const std::string& data, SecurityProfile profile) {
+        if (data.empty()) return DataType::UNKNOWN;
+        size_t nonPrintable = 0;
+        for (unsigned char c : data) {
+            if (c < 32 && c != '\n' && c != '\r' && c != '\t') nonPrintable++;
+        }
+        double entropy = legacyEntropy(data);
+        double threshold = (profile == SecurityProfile::HIGH) ? 5.8 : 6.8;
+        if (entropy > threshold || (static_cast<double>(nonPrintable) / data.size() > 0.3)) {
+            return DataType::BINARY;
+        }
+        if (data.find('{') != std::string::npos && data.find('}') != std::string::npos) {
+            if (data.find(':') != std::string::npos) return DataType::JSON;
+        }
+        return DataType::TEXT;
+    }
+
+    const char* typeName(DataType t) {
+        switch (t) {
+            case DataType::TEXT: return "TEXT";
+            case DataType::JSON: return "JSON";
+            case DataType::METRIC: return "METRIC";
+            case DataType::BINARY: return "BINARY";
+            default: return "UNKNOWN";
+        }
+    }
+
+    /**
+     * @brief Determinisztikus korpusz: kézi határesetek + generált minták
+     * (szöveg, JSON, metrika, bináris, vezérlőkarakter-arány a 0.3 küszöb körül,
+     * érvényes/érvénytelen UTF-8, entrópia a 5.8/6.8 küszöbök környékén).
+     */
+    std::vector<std::string> makeCorpus() {
+        std::vector<std::string> c = {
+            "",
+            "a",
+            "Normál naplózási esemény 1\n",
+            "{\"key\": 1}",
+            "{ no colon here }",
+            "key: value",
+            "}{:",
+            "cpu=0.42 mem=1337 load:1.2",
+            "MODIFIED: passwd",
+            "NULL_ROUTE: IP_BLOCKED: 16777343",
+            std::string("\x01\x02\x03" "abcdefg", 10),
+            std::string("\x01\x02\x03" "abcdef", 9),
+            std::string("\x01\x02\x03\x04" "abcdef", 10),
+            "\t\r\n\t\r\n",
+            "árvíztűrő tükörfúrógép",
+            "\xc0\xaf overlong",
+            "\xed\xa0\x80 surrogate",
+            "\xf4\x90\x80\x80 beyond U+10FFFF",
+            "\xe2\x82",
+        };
+
+        std::mt19937 rng(0xC0FFEE);
+        auto randomBytes = [&rng](size_t n, unsigned alphabet) {
+            std::string s(n, '\0');
+            for (auto& ch : s) ch = static_cast<char>(rng() % alphabet);
+            return s;
+        };
+
+        for (size_t n : {8u, 31u, 64u, 200u, 255u, 256u, 257u, 1024u, 2048u, 4096u, 9000u}) {
+            // Korlátozott ábécé: az entrópia log2(alphabet) közelében, a küszöbök két oldalán
+            for (unsigned alphabet : {2u, 16u, 48u, 56u, 64u, 100u, 112u, 128u, 200u, 256u}) {
+                c.push_back(randomBytes(n, alphabet));
+                std::string printable = randomBytes(n, alphabet);
+                for (auto& ch : printable) ch = static_cast<char>(32 + static_cast<unsigned char>(ch) % 95);
+                c.push_back(printable);
+            }
+            std::string json = "{";
+            while (json.size() < n) json += "\"k" + std::to_string(json.size()) + "\": " + std::to_string(rng() % 1000) + ", ";
+            json += "}";
+            c.push_back(json);
+
+            // Vezérlőkarakter-arány 0.29 / 0.30 / 0.31 körül
+            for (double ratio : {0.29, 0.30, 0.31}) {
+                std::string s(n, 'x');
+                size_t ctrl = static_cast<size_t>(ratio * n);
+                for (size_t i = 0; i < ctrl; ++i) s[(i * 7) % n] = static_cast<char>(1 + (i % 8));
+                c.push_back(s);
+            }
+        }
+        return c;
+    }
+}
+
+int main() {
+    const auto corpus = makeCorpus();
+    const SecurityProfile profiles[] = {SecurityProfile::NORMAL, SecurityProfile::HIGH};
+
+    size_t mismatches = 0;
+    size_t cases = 0;
+    for (const auto& s : corpus) {
+        for (auto profile : profiles) {
+            ++cases;
+            DataType golden = legacyDetect(s, profile);
+            StreamVerdict v = StreamProbe::classify(s, profile);
+            double refEntropy = legacyEntropy(s);
+            if (v.type != golden || std::fabs(v.features.entropy - refEntropy) > 1e-9) {
+                ++mismatches;
+                std::printf("MISMATCH len=%zu profile=%d golden=%s got=%s entropy=%.12f ref=%.12f\n",
+                            s.size(), static_cast<int>(profile), typeName(golden), typeName(v.type),
+                            v.features.entropy, refEntropy);
+            }
+        }
+    }
+    std::printf("golden corpus: %zu cases, %zu mismatches\n", cases, mismatches);
+
+    // Teljesítmény: 2 KiB SocketProbe-olvasás méretű minták
+    std::vector<std::string> reads;
+    for (const auto& s : corpus) {
+        if (s.size() == 2048) reads.push_back(s);
+    }
+    const size_t iterations = 2000;
+    unsigned sink = 0;
+
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        for (const auto& s : reads) sink += static_cast<unsigned>(legacyDetect(s, SecurityProfile::NORMAL));
+    }
+    auto t1 = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        for (const auto& s : reads) sink += static_cast<unsigned>(StreamProbe::classify(s, SecurityProfile::NORMAL).type);
+    }
+    auto t2 = Clock::now();
+
+    double calls = static_cast<double>(iterations * reads.size());
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+    double fusedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / calls;
+    std::printf("2 KiB classify: legacy %.1f ns, fused %.1f ns (%.1fx)\n", legacyNs, fusedNs, legacyNs / fusedNs);
+
+    if (sink == 0xffffffffu) std::printf("\n"); // ne optimalizálja ki a fordító
+    return mismatches == 0 ? 0 : 1;
+}
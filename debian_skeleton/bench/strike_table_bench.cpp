@@ -0,0 +1,185 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Strike-számlálás: std::map<std::string,int> + egy mutex (a régi VisualMemory) vs. StrikeTable
+//
+// Használat: strike_table_bench [ips=1000000] [threads=4] [capacity=1572864]
+//
+// 1. különálló források: ips darab cím (90% IPv4, 10% IPv6) a szálak között felosztva,
+//    címenként 3 strike + 1 olvasás. A régi út szöveges kulcsot kap (ahogy a hívók adták),
+//    az új a NetAddress-t. Golden: minden címnél 3 (kilakoltatás nélkül), az új táblánál
+//    a bejegyzések = ips.
+// 2. közös forró halmaz: minden szál ugyanazt az 1024 címet üti; golden: nincs elveszett
+//    strike (címenként threads * körök).
+// 3. bomlás (explicit Tick): 8 strike, felezési idő 10 tick -> 8, 4, 1, majd 0.
+// 4. korlát: 64k kapacitás, előbb 100 "nehéz" cím 10 strike-kal, majd ips különálló cím
+//    egy-egy strike-kal. Golden: a nehéz címek megmaradnak, a bejegyzések <= kapacitás.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "veth_frames.hpp"
+#include "core/NetAddress.hpp"
+#include "core/StrikeTable.hpp"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    // A régi VisualMemory strike útja változatlanul
+    struct LegacyStrikes {
+        std::map<std::string, int> strike_count;
+        std::mutex strike_mutex;
+
+        int mark(const std::string& ip) {
+            std::lock_guard<std::mutex> lock(strike_mutex);
+            return ++strike_count[ip];
+        }
+        int get(const std::string& ip) {
+            std::lock_guard<std::mutex> lock(strike_mutex);
+            if (strike_count.find(ip) == strike_count.end()) return 0;
+            return strike_count[ip];
+        }
+    };
+
+    // Minden 10. cím IPv6 (2001:db8::/64 alatt), a többi 10.x.y.z
+    NetAddress source(size_t i) {
+        if (i % 10 == 9) {
+            uint8_t raw[16] = {0x20, 0x01, 0x0d, 0xb8};
+            uint64_t n = i + 1;
+            std::memcpy(raw + 8, &n, 8);
+            return NetAddress::fromV6(raw);
+        }
+        return NetAddress::fromV4(htonl(0x0a000000u | static_cast<uint32_t>(i + 1)));
+    }
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // fn(thread, begin, end): a [0, n) tartomány threads részre osztva, párhuzamosan
+    template <typename Fn>
+    double runParallel(size_t n, unsigned threads, Fn fn) {
+        std::vector<std::thread> pool;
+        auto t0 = Clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            size_t begin = n * t / threads, end = n * (t + 1) / threads;
+            pool.emplace_back([=, &fn] { fn(t, begin, end); });
+        }
+        for (auto& th : pool) th.join();
+        return msSince(t0);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t ips = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    unsigned threads = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 4;
+    size_t capacity = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1572864;
+    if (ips == 0) ips = 1000000;
+    if (threads == 0) threads = 4;
+    constexpr int ROUNDS = 3;
+    int failures = 0;
+
+    std::vector<NetAddress> addrs(ips);
+    std::vector<std::string> texts(ips);
+    for (size_t i = 0; i < ips; ++i) {
+        addrs[i] = source(i);
+        texts[i] = addrs[i].toString();
+    }
+
+    // --- 1. különálló források ---
+    LegacyStrikes legacy;
+    std::vector<size_t> legacyWrong(threads, 0);
+    double legacyMs = runParallel(ips, threads, [&](unsigned t, size_t b, size_t e) {
+        for (int r = 0; r < ROUNDS; ++r) {
+            for (size_t i = b; i < e; ++i) legacy.mark(texts[i]);
+        }
+        for (size_t i = b; i < e; ++i) legacyWrong[t] += legacy.get(texts[i]) == ROUNDS ? 0 : 1;
+    });
+
+    StrikeTable table(capacity, std::chrono::milliseconds(0));
+    std::vector<size_t> tableWrong(threads, 0);
+    double tableMs = runParallel(ips, threads, [&](unsigned t, size_t b, size_t e) {
+        for (int r = 0; r < ROUNDS; ++r) {
+            for (size_t i = b; i < e; ++i) table.strike(addrs[i]);
+        }
+        for (size_t i = b; i < e; ++i) tableWrong[t] += table.strikes(addrs[i]) == ROUNDS ? 0 : 1;
+    });
+    StrikeTableStats st = table.stats();
+
+    const double ops = static_cast<double>(ips) * (ROUNDS + 1);
+    std::printf("%zu különálló forrás, %u szál, %d strike + 1 olvasás / cím:\n", ips, threads, ROUNDS);
+    std::printf("  %-40s %9.0f ms  %7.0f ns/op\n", "előtte: std::map<string,int> + mutex", legacyMs,
+                legacyMs * 1e6 / ops);
+    std::printf("  %-40s %9.0f ms  %7.0f ns/op  (%zu cím, %.1f MiB)\n", "utána: StrikeTable", tableMs,
+                tableMs * 1e6 / ops, st.capacity, st.capacity * 4.0 / 3.0 * 32.0 / (1024 * 1024));
+    std::printf("golden:\n");
+    size_t lw = 0, tw = 0;
+    for (unsigned t = 0; t < threads; ++t) { lw += legacyWrong[t]; tw += tableWrong[t]; }
+    failures += check("legacy wrong counts", lw, 0);
+    failures += check("evictions", st.evictions, 0);
+    failures += check("table wrong counts", tw, 0);
+    failures += check("table entries", st.entries, ips);
+
+    // --- 2. közös forró halmaz ---
+    constexpr size_t HOT = 1024;
+    constexpr int HOT_ROUNDS = 200;
+    StrikeTable hot(4096, std::chrono::milliseconds(0));
+    LegacyStrikes hotLegacy;
+    double hotLegacyMs = runParallel(threads, threads, [&](unsigned, size_t, size_t) {
+        for (int r = 0; r < HOT_ROUNDS; ++r) {
+            for (size_t i = 0; i < HOT; ++i) hotLegacy.mark(texts[i % ips]);
+        }
+    });
+    double hotMs = runParallel(threads, threads, [&](unsigned, size_t, size_t) {
+        for (int r = 0; r < HOT_ROUNDS; ++r) {
+            for (size_t i = 0; i < HOT; ++i) hot.strike(addrs[i % ips]);
+        }
+    });
+    const double hotOps = static_cast<double>(threads) * HOT_ROUNDS * HOT;
+    std::printf("közös forró halmaz (%zu cím, minden szál):\n", HOT);
+    std::printf("  %-40s %9.0f ms  %7.0f ns/op\n", "előtte: map + mutex", hotLegacyMs, hotLegacyMs * 1e6 / hotOps);
+    std::printf("  %-40s %9.0f ms  %7.0f ns/op\n", "utána: StrikeTable (CAS)", hotMs, hotMs * 1e6 / hotOps);
+    size_t lost = 0;
+    const uint32_t want = threads * HOT_ROUNDS;
+    for (size_t i = 0; i < HOT && i < ips; ++i) lost += hot.strikes(addrs[i]) == want ? 0 : 1;
+    failures += check("hot lost updates", lost, 0);
+
+    // --- 3. bomlás ---
+    StrikeTable decaying(1024, StrikeTable::TICK * 10);
+    const NetAddress a = addrs[0];
+    for (int i = 0; i < 8; ++i) decaying.strike(a, 100);
+    std::printf("bomlás (felezési idő 10 tick):\n");
+    failures += check("t=109", decaying.strikes(a, 109), 8);
+    failures += check("t=110", decaying.strikes(a, 110), 4);
+    failures += check("t=130", decaying.strikes(a, 130), 1);
+    failures += check("strike @130", decaying.strike(a, 130), 2);
+    failures += check("t=400", decaying.strikes(a, 400), 0);
+    failures += check("strike @400", decaying.strike(a, 400), 1);
+
+    // --- 4. korlátos kapacitás ---
+    StrikeTable bounded(size_t(1) << 16, std::chrono::milliseconds(0));
+    constexpr size_t HEAVY = 100;
+    for (size_t i = 0; i < HEAVY; ++i) {
+        for (int r = 0; r < 10; ++r) bounded.strike(addrs[(i * 7919) % ips]);
+    }
+    double floodMs = runParallel(ips, threads, [&](unsigned, size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) bounded.strike(source(ips + i));
+    });
+    StrikeTableStats bs = bounded.stats();
+    size_t heavyKept = 0;
+    for (size_t i = 0; i < HEAVY; ++i) heavyKept += bounded.strikes(addrs[(i * 7919) % ips]) == 10 ? 1 : 0;
+    std::printf("korlát: %zu cím, %zu új forrás: %.0f ms, %llu kilakoltatás\n", bs.capacity, ips, floodMs,
+                static_cast<unsigned long long>(bs.evictions));
+    failures += check("heavy kept", heavyKept, HEAVY);
+    failures += check("entries <= capacity", bs.entries <= bs.capacity ? 1 : 0, 1);
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,243 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Közös veth/netns környezet és keret-építők a RawPacketProbe benchmarkokhoz
+//
+// A setupVeth() privát hálózati névtérben "va" <-> "vb" veth párt hoz létre
+// (IPv6 nélkül, hogy az ND/MLD forgalom ne zavarjon); az injektor "va"-n küld,
+// a mért probe "vb"-n fogad. Root (CAP_NET_ADMIN + CAP_NET_RAW) kell.
+
+#ifndef VENOM_BENCH_VETH_FRAMES_HPP
+#define VENOM_BENCH_VETH_FRAMES_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace VenomBench {
+
+    using Clock = std::chrono::steady_clock;
+
+    using Frame = std::vector<uint8_t>;
+
+    inline constexpr uint8_t MAC_VB[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0xbb};
+    inline constexpr uint8_t MAC_ROUTER[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    inline constexpr uint8_t MAC_ATTACKER[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x66};
+    inline constexpr uint8_t BROADCAST[6] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+    inline void put16(Frame& f, uint16_t v) {
+        f.push_back(static_cast<uint8_t>(v >> 8));
+        f.push_back(static_cast<uint8_t>(v));
+    }
+
+    inline void putBytes(Frame& f, const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        f.insert(f.end(), b, b + n);
+    }
+
+    inline void putV4(Frame& f, const char* ip) {
+        in_addr a{};
+        inet_pton(AF_INET, ip, &a);
+        putBytes(f, &a, 4);
+    }
+
+    inline void ethernet(Frame& f, const uint8_t* dst, const uint8_t* src, uint16_t type, int vlan = -1) {
+        putBytes(f, dst, 6);
+        putBytes(f, src, 6);
+        if (vlan >= 0) {
+            put16(f, 0x8100);
+            put16(f, static_cast<uint16_t>(vlan));
+        }
+        put16(f, type);
+    }
+
+    inline Frame arp(const uint8_t* ethSrc, const uint8_t* senderMac, const char* senderIp, const char* targetIp) {
+        Frame f;
+        ethernet(f, BROADCAST, ethSrc, 0x0806);
+        put16(f, 1);            // htype: Ethernet
+        put16(f, 0x0800);       // ptype: IPv4
+        f.push_back(6);
+        f.push_back(4);
+        put16(f, 1);            // request
+        putBytes(f, senderMac, 6);
+        putV4(f, senderIp);
+        putBytes(f, "\0\0\0\0\0\0", 6);
+        putV4(f, targetIp);
+        return f;
+    }
+
+    // fragField: az IPv4 flags/fragment offset mező (0x4000 = DF, 0x2000 = MF)
+    inline Frame udp4(const char* src, const char* dst, const std::string& payload, int vlan = -1,
+                      uint16_t fragField = 0x4000) {
+        Frame f;
+        ethernet(f, MAC_VB, MAC_ATTACKER, 0x0800, vlan);
+        size_t ipStart = f.size();
+        f.push_back(0x45);
+        f.push_back(0);
+        put16(f, static_cast<uint16_t>(20 + 8 + payload.size()));
+        put16(f, 0);            // id
+        put16(f, fragField);
+        f.push_back(64);
+        f.push_back(17);        // UDP
+        put16(f, 0);            // checksum (lent)
+        putV4(f, src);
+        putV4(f, dst);
+        uint32_t sum = 0;
+        for (size_t i = ipStart; i < ipStart + 20; i += 2) sum += (f[i] << 8) | f[i + 1];
+        while (sum >> 16) sum = (sum & 0xffff) + (sum >> 16);
+        f[ipStart + 10] = static_cast<uint8_t>(~sum >> 8);
+        f[ipStart + 11] = static_cast<uint8_t>(~sum);
+        put16(f, 40000);
+        put16(f, 5353);
+        put16(f, static_cast<uint16_t>(8 + payload.size()));
+        put16(f, 0);
+        putBytes(f, payload.data(), payload.size());
+        return f;
+    }
+
+    // IPv6/UDP, opcionálisan Hop-by-Hop és/vagy Fragment kiterjesztett fejléccel
+    inline Frame udp6(const char* src, const char* dst, const std::string& payload,
+                      bool hopByHop = false, bool fragment = false) {
+        Frame f;
+        ethernet(f, MAC_VB, MAC_ATTACKER, 0x86DD);
+        f.push_back(0x60);
+        f.push_back(0);
+        put16(f, 0);
+        size_t extLen = (hopByHop ? 8 : 0) + (fragment ? 8 : 0);
+        put16(f, static_cast<uint16_t>(extLen + 8 + payload.size()));
+        f.push_back(hopByHop ? 0 : (fragment ? 44 : 17));
+        f.push_back(64);
+        in6_addr s{}, d{};
+        inet_pton(AF_INET6, src, &s);
+        inet_pton(AF_INET6, dst, &d);
+        putBytes(f, &s, 16);
+        putBytes(f, &d, 16);
+        if (hopByHop) {
+            // Hop-by-Hop: len=0 (8 bájt), PadN
+            f.push_back(fragment ? 44 : 17);
+            f.push_back(0);
+            f.push_back(1);
+            f.push_back(4);
+            putBytes(f, "\0\0\0\0", 4);
+        }
+        if (fragment) {
+            // Fragment: offset 0, M=1 (első fragmens), id
+            f.push_back(17);
+            f.push_back(0);
+            put16(f, 0x0001);
+            putBytes(f, "\0\0\x12\x34", 4);
+        }
+        put16(f, 40000);
+        put16(f, 5353);
+        put16(f, static_cast<uint16_t>(8 + payload.size()));
+        put16(f, 0);
+        putBytes(f, payload.data(), payload.size());
+        return f;
+    }
+
+    inline Frame udp6HopByHop(const std::string& payload) {
+        return udp6("fd00::66", "fd00::bb", payload, true);
+    }
+
+    // ICMPv6 Router Advertisement (fe80::1 -> ff02::1) a megadott forrás MAC-ről
+    inline Frame routerAdvert(const uint8_t* srcMac) {
+        Frame f;
+        ethernet(f, MAC_VB, srcMac, 0x86DD);
+        f.push_back(0x60);
+        f.push_back(0);
+        put16(f, 0);
+        put16(f, 16);
+        f.push_back(58);        // ICMPv6
+        f.push_back(255);
+        in6_addr s{}, d{};
+        inet_pton(AF_INET6, "fe80::1", &s);
+        inet_pton(AF_INET6, "ff02::1", &d);
+        putBytes(f, &s, 16);
+        putBytes(f, &d, 16);
+        f.push_back(134);       // Router Advertisement
+        f.push_back(0);
+        put16(f, 0);            // checksum (az XDP nem ellenőrzi)
+        f.push_back(64);        // cur hop limit
+        f.push_back(0);
+        put16(f, 1800);         // router lifetime
+        putBytes(f, "\0\0\0\0\0\0\0\0", 8);
+        return f;
+    }
+
+    inline Frame truncatedV4() {
+        Frame f;
+        ethernet(f, MAC_VB, MAC_ATTACKER, 0x0800);
+        putBytes(f, "\x45\x00\x00\x30\x00\x00", 6); // 20 bájtos fejléc helyett 6
+        return f;
+    }
+
+    inline bool sh(const std::string& cmd) {
+        return std::system((cmd + " >/dev/null 2>&1").c_str()) == 0;
+    }
+
+    inline bool setupVeth() {
+        if (unshare(CLONE_NEWNET) != 0) return false;
+        if (!sh("ip link add va type veth peer name vb")) return false;
+        // IPv6 kikapcsolva: a link-up ND/MLD forgalma ne keveredjen a golden számlálókba
+        sh("sysctl -w net.ipv6.conf.va.disable_ipv6=1");
+        sh("sysctl -w net.ipv6.conf.vb.disable_ipv6=1");
+        return sh("ip link set vb address 02:00:00:00:00:bb") &&
+               sh("ip link set va up") && sh("ip link set vb up");
+    }
+
+    inline int openInjector(const char* ifname) {
+        int fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, htons(ETH_P_ALL));
+        if (fd < 0) return -1;
+        sockaddr_ll addr{};
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_ALL);
+        addr.sll_ifindex = static_cast<int>(if_nametoindex(ifname));
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        int sndbuf = 4 << 20;
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        return fd;
+    }
+
+    inline bool inject(int fd, const Frame& f) {
+        for (;;) {
+            if (send(fd, f.data(), f.size(), 0) == static_cast<ssize_t>(f.size())) return true;
+            if (errno != ENOBUFS && errno != EAGAIN) return false;
+            std::this_thread::yield();
+        }
+    }
+
+    template <typename Pred>
+    inline bool waitFor(Pred pred, std::chrono::milliseconds limit = std::chrono::milliseconds(3000)) {
+        auto deadline = Clock::now() + limit;
+        while (!pred()) {
+            if (Clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    // Golden összevetés: kiírja a sort, eltérésnél 1-et ad (a hibaszámlálóhoz)
+    inline int check(const char* what, uint64_t got, uint64_t want) {
+        bool ok = got == want;
+        std::printf("  %-22s %8llu  (elvárt %llu)%s\n", what, static_cast<unsigned long long>(got),
+                    static_cast<unsigned long long>(want), ok ? "" : "  MISMATCH");
+        return ok ? 0 : 1;
+    }
+}
+
+#endif // VENOM_BENCH_VETH_FRAMES_HPP
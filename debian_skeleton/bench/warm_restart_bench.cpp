@@ -0,0 +1,223 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Meleg újraindítás: pinelt mapek + a futó XDP linkben cserélt program (attachXdpLink)
+//
+// Használat: warm_restart_bench [entries=10000] [frames=2000]
+//
+// Kézzel összerakott XDP program (forrás IPv4 -> blacklist_map lookup, verdikt-számláló
+// verziónként) a "vb" veth végen, SKB módban:
+// 1. hideg indulás: mapek, program, link és N tiltás betöltése (batch) -> védett állapotig
+//    eltelt idő. A mapek és a link a bpffs-re pinelődik.
+// 2. "leállás": a folyamat minden leíróját bezárja. Golden: a közben injektált tiltott
+//    keretek mind eldobódnak (a pinelt link tartja a programot).
+// 3. meleg indulás: pinelt mapek átvétele, új programverzió, bpf_link_update a meglévő
+//    linkben -> idő. Golden: a link újrahasznosítva, N bejegyzés megvan, az új verzió dob.
+// 4. pin nélküli összevetés: leíró zárása = lecsatolás (a régi detach); a tiltott keret átjut.
+// Root, bpffs (szükség esetén csatolja) és veth kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <sys/stat.h>
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "bpf_asm.hpp"
+#include "veth_frames.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    const std::string PIN_ROOT = "/sys/fs/bpf/wv_warm_bench";
+
+    std::string pin(const char* name) { return PIN_ROOT + "/" + name; }
+
+    void removePins() {
+        for (const char* name : {"blacklist_map", "stats_map", "link_vb"}) unlink(pin(name).c_str());
+        rmdir(PIN_ROOT.c_str());
+    }
+
+    /**
+     * @brief IPv4 forrás (Ethernet + 12. bájt) a blacklist_map-ben -> XDP_DROP, különben PASS.
+     * A verdikt a stats_map version*2 (pass) / version*2+1 (drop) slotjába kerül.
+     */
+    std::vector<bpf_insn> guardKernel(int blacklistFd, int statsFd, int version) {
+        Asm a;
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_2, BPF_REG_1, 0, 0));   // data
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_3, BPF_REG_1, 4, 0));   // data_end
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, 30));
+        a.jump(BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0, "pass");
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_5, BPF_REG_2, 26, 0));  // iph->saddr
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_5, -4, 0));
+        a.loadMap(BPF_REG_1, blacklistFd);
+        a.stackPtr(BPF_REG_2, -4);
+        a.call(BPF_FUNC_map_lookup_elem);
+        a.jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, "pass");
+
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_9, 0, 0, version * 2 + 1));
+        a.countSlot(statsFd, BPF_REG_9, -8, "drop_counted");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_DROP));
+        a.emit(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+        a.label("pass");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_9, 0, 0, version * 2));
+        a.countSlot(statsFd, BPF_REG_9, -8, "pass_counted");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+        a.emit(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        return a.finish();
+    }
+
+    int loadGuard(int blacklistFd, int statsFd, int version) {
+        std::vector<bpf_insn> prog = guardKernel(blacklistFd, statsFd, version);
+        return bpf_prog_load(BPF_PROG_TYPE_XDP, "venom_guard", "GPL", prog.data(), prog.size(), nullptr);
+    }
+
+    uint64_t slotSum(int statsFd, uint32_t slot) {
+        std::vector<uint64_t> perCpu(static_cast<size_t>(libbpf_num_possible_cpus() > 0 ? libbpf_num_possible_cpus() : 1));
+        if (bpf_map_lookup_elem(statsFd, &slot, perCpu.data()) != 0) return 0;
+        uint64_t s = 0;
+        for (uint64_t v : perCpu) s += v;
+        return s;
+    }
+
+    // 10.1.x.y, a 0. a tesztforrás (10.1.0.1)
+    uint32_t blockedIp(size_t i) { return htonl(0x0a010000u | static_cast<uint32_t>(i + 1)); }
+
+    size_t countEntries(int fd) {
+        uint32_t key = 0, next = 0;
+        size_t n = 0;
+        const void* cur = nullptr;
+        while (bpf_map_get_next_key(fd, cur, &next) == 0) {
+            key = next;
+            cur = &key;
+            n++;
+        }
+        return n;
+    }
+
+    // A tiltott forrás keretei; true, ha a megadott slot legalább +count-tal nőtt
+    bool injectAndWait(int tx, int statsFd, uint32_t slot, size_t count) {
+        const Frame blocked = udp4("10.1.0.1", "10.0.0.187", "venom");
+        uint64_t before = slotSum(statsFd, slot);
+        for (size_t i = 0; i < count; ++i) inject(tx, blocked);
+        return waitFor([&] { return slotSum(statsFd, slot) - before >= count; }, std::chrono::milliseconds(2000));
+    }
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t entries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t frames = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    if (entries == 0 || entries > VENOM_BLACKLIST_MAX) entries = 10000;
+
+    if (!setupVeth()) {
+        std::printf("warm_restart_bench: skipped (netns/veth nem hozható létre: root kell)\n");
+        return 0;
+    }
+    removePins();
+    if (mkdir(PIN_ROOT.c_str(), 0700) != 0) {
+        sh("mount -t bpf bpf /sys/fs/bpf");
+        if (mkdir(PIN_ROOT.c_str(), 0700) != 0) {
+            std::printf("warm_restart_bench: skipped (bpffs nem elérhető: %s)\n", std::strerror(errno));
+            return 0;
+        }
+    }
+    int tx = openInjector("va");
+    const int ifindex = static_cast<int>(if_nametoindex("vb"));
+    if (tx < 0 || ifindex == 0) {
+        std::printf("warm_restart_bench: skipped (AF_PACKET injektor)\n");
+        return 0;
+    }
+    int failures = 0;
+
+    // --- 1. hideg indulás ---
+    auto t0 = Clock::now();
+    int blFd = bpf_map_create(BPF_MAP_TYPE_LRU_HASH, "blacklist_map", sizeof(uint32_t), sizeof(uint8_t),
+                              VENOM_BLACKLIST_MAX, nullptr);
+    int statsFd = bpf_map_create(BPF_MAP_TYPE_PERCPU_ARRAY, "stats_map", sizeof(uint32_t), sizeof(uint64_t),
+                                 VENOM_STAT_SLOTS, nullptr);
+    int progFd = (blFd >= 0 && statsFd >= 0) ? loadGuard(blFd, statsFd, 0) : -1;
+    if (progFd < 0) {
+        std::printf("warm_restart_bench: skipped (BPF program nem tölthető: root kell)\n");
+        removePins();
+        return 0;
+    }
+    bool reused = true;
+    int linkFd = attachXdpLink(progFd, ifindex, XdpAttachMode::GENERIC, pin("link_vb"), &reused);
+    std::vector<uint32_t> keys(entries);
+    for (size_t i = 0; i < entries; ++i) keys[i] = blockedIp(i);
+    std::vector<uint8_t> values(entries, 1);
+    uint32_t count = static_cast<uint32_t>(entries);
+    bpf_map_update_batch(blFd, keys.data(), values.data(), &count, nullptr);
+    double coldMs = msSince(t0);
+    bpf_obj_pin(blFd, pin("blacklist_map").c_str());
+    bpf_obj_pin(statsFd, pin("stats_map").c_str());
+
+    std::printf("hideg indulás: %zu tiltás, link %s\n", entries, linkFd >= 0 ? "csatolva" : "HIBA");
+    failures += check("cold link reused", reused ? 1 : 0, 0);
+    failures += check("cold drops (v1)", injectAndWait(tx, statsFd, 1, frames) ? frames : 0, frames);
+
+    // --- 2. leállás: minden leíró zárva, a pinelt link tartja a programot ---
+    close(linkFd);
+    close(progFd);
+    close(blFd);
+    close(statsFd);
+    int watchFd = bpf_obj_get(pin("stats_map").c_str());
+    bool downProtected = watchFd >= 0 && injectAndWait(tx, watchFd, 1, frames);
+    std::printf("leállás alatt (nincs user-space leíró):\n");
+    failures += check("down drops (v1)", downProtected ? frames : 0, frames);
+    close(watchFd);
+
+    // --- 3. meleg indulás ---
+    t0 = Clock::now();
+    blFd = bpf_obj_get(pin("blacklist_map").c_str());
+    statsFd = bpf_obj_get(pin("stats_map").c_str());
+    progFd = (blFd >= 0 && statsFd >= 0) ? loadGuard(blFd, statsFd, 1) : -1;
+    reused = false;
+    linkFd = progFd >= 0 ? attachXdpLink(progFd, ifindex, XdpAttachMode::GENERIC, pin("link_vb"), &reused) : -1;
+    double warmMs = msSince(t0);
+
+    uint64_t v1Before = slotSum(statsFd, 1);
+    bool v2Drops = injectAndWait(tx, statsFd, 3, frames);
+    std::printf("meleg indulás:\n");
+    failures += check("warm link reused", reused ? 1 : 0, 1);
+    failures += check("entries kept", countEntries(blFd), entries);
+    failures += check("warm drops (v2)", v2Drops ? frames : 0, frames);
+    failures += check("old program drops", slotSum(statsFd, 1) - v1Before, 0);
+
+    std::printf("védett állapotig:\n");
+    std::printf("  %-34s %8.2f ms  (+ a tiltólista újratanulása)\n", "hideg: mapek + program + N tiltás", coldMs);
+    std::printf("  %-34s %8.2f ms  (védtelen ablak: 0)\n", "meleg: pin + program + link csere", warmMs);
+
+    // --- 4. pin nélkül: a leíró zárása lecsatol (a régi detach viselkedése) ---
+    close(linkFd);
+    unlink(pin("link_vb").c_str());
+    uint64_t passBefore = slotSum(statsFd, 2) + slotSum(statsFd, 0);
+    uint64_t dropBefore = slotSum(statsFd, 3) + slotSum(statsFd, 1);
+    inject(tx, udp4("10.1.0.1", "10.0.0.187", "venom"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::printf("pin törölve:\n");
+    failures += check("detached: verdicts", slotSum(statsFd, 3) + slotSum(statsFd, 1) - dropBefore +
+                                            slotSum(statsFd, 2) + slotSum(statsFd, 0) - passBefore, 0);
+
+    close(progFd);
+    close(blFd);
+    close(statsFd);
+    close(tx);
+    removePins();
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
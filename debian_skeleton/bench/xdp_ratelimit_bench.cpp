@@ -0,0 +1,292 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Forrásonkénti token bucket az XDP-ben (rate_map + rate_config_map), BPF_PROG_TEST_RUN-nal
+//
+// Használat: xdp_ratelimit_bench [repeat=1000000] [pps=1000] [burst=100] [bpf_obj=obj/core/ebpf/venom_shield.bpf.o]
+//
+// 1. vödör-kernel: kézzel összerakott XDP program, amely a venom_shield rate_exceeded()
+//    lépéseit végzi (config lookup, ktime, LRU_PERCPU_HASH vödör, kredit-aritmetika)
+//    egyetlen forrásra, és a verdiktet egy PERCPU számlálóba írja. ns/csomag kikapcsolt és
+//    bekapcsolt korláttal. Golden: az átengedett csomagok száma burst és
+//    burst + pps * (a futás fali ideje) + 1 közé esik, a többi eldobva.
+// 2. venom_router_guard: setRateLimit után egy IPv4 és egy IPv6 forrás árvize, a
+//    rate_limited / dropped számlálók, egy másik forrás átengedése és az applyProfile.
+//    Csak ha az objektum betölthető.
+// A Hydra terv L1 szintje (group_by(source_ip) az rxcpp láncban) minden árvíz-csomagot
+// user-space-be hozna; itt a többlet már a meghajtóban elvész.
+// Root (CAP_BPF / CAP_SYS_ADMIN) kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "bpf_asm.hpp"
+#include "veth_frames.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    struct Maps {
+        int config = -1;
+        int buckets = -1;
+        int verdicts = -1;   // PERCPU_ARRAY: 0 = átengedve, 1 = eldobva
+    };
+
+    /**
+     * @brief rate_exceeded() egy rögzített forráskulccsal (a csomagtól független, így csak
+     * a vödör ára mérődik), majd verdikt-számláló és XDP_PASS / XDP_DROP.
+     * Stack: fp-16 kulcs (venom_in6), fp-20 config kulcs, fp-24 verdikt slot, fp-40 új vödör.
+     */
+    std::vector<bpf_insn> bucketKernel(const Maps& m) {
+        Asm a;
+        // r9 = verdikt (0 = pass)
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_9, 0, 0, 0));
+        a.emit(insn(BPF_ST | BPF_MEM | BPF_DW, BPF_REG_10, 0, -16, 0));
+        a.emit(insn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -8, static_cast<int32_t>(htonl(0xffff))));
+        a.emit(insn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -4, static_cast<int32_t>(htonl(0x0a000063))));
+        a.emit(insn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -20, 0));
+
+        // r6 = rate_config
+        a.loadMap(BPF_REG_1, m.config);
+        a.stackPtr(BPF_REG_2, -20);
+        a.call(BPF_FUNC_map_lookup_elem);
+        a.jump(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0, "count");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_0, 0, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_6, 0, 0));
+        a.jump(BPF_JEQ | BPF_K, BPF_REG_1, 0, 0, "count");           // cost_ns = 0: kikapcsolva
+
+        a.call(BPF_FUNC_ktime_get_ns);
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_8, BPF_REG_0, 0, 0));
+
+        a.loadMap(BPF_REG_1, m.buckets);
+        a.stackPtr(BPF_REG_2, -16);
+        a.call(BPF_FUNC_map_lookup_elem);
+        a.jump(BPF_JNE | BPF_K, BPF_REG_0, 0, 0, "have");
+
+        // Új forrás: teli vödör mínusz ez a csomag
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_6, 8, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_2, BPF_REG_6, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_SUB | BPF_X, BPF_REG_1, BPF_REG_2, 0, 0));
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_10, BPF_REG_1, -40, 0));
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_10, BPF_REG_8, -32, 0));
+        a.loadMap(BPF_REG_1, m.buckets);
+        a.stackPtr(BPF_REG_2, -16);
+        a.stackPtr(BPF_REG_3, -40);
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, BPF_ANY));
+        a.call(BPF_FUNC_map_update_elem);
+        a.jump(BPF_JA, 0, 0, 0, "count");
+
+        // credit = min(credit + (now - last), burst)
+        a.label("have");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_7, BPF_REG_0, 0, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_7, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_8, 0, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_3, BPF_REG_7, 8, 0));
+        a.emit(insn(BPF_ALU64 | BPF_SUB | BPF_X, BPF_REG_2, BPF_REG_3, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_ADD | BPF_X, BPF_REG_1, BPF_REG_2, 0, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_2, BPF_REG_6, 8, 0));
+        a.jump(BPF_JLE | BPF_X, BPF_REG_1, BPF_REG_2, 0, "capped");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_1, BPF_REG_2, 0, 0));
+        a.label("capped");
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_7, BPF_REG_8, 8, 0));
+        a.emit(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_2, BPF_REG_6, 0, 0));
+        a.jump(BPF_JGE | BPF_X, BPF_REG_1, BPF_REG_2, 0, "spend");
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_7, BPF_REG_1, 0, 0));
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_9, 0, 0, 1));
+        a.jump(BPF_JA, 0, 0, 0, "count");
+        a.label("spend");
+        a.emit(insn(BPF_ALU64 | BPF_SUB | BPF_X, BPF_REG_1, BPF_REG_2, 0, 0));
+        a.emit(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_7, BPF_REG_1, 0, 0));
+
+        // verdicts[r9]++
+        a.label("count");
+        a.countSlot(m.verdicts, BPF_REG_9, -24, "out");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+        a.jump(BPF_JEQ | BPF_K, BPF_REG_9, 0, 0, "exit");
+        a.emit(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_DROP));
+        a.label("exit");
+        a.emit(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        return a.finish();
+    }
+
+    uint64_t sumSlot(int fd, uint32_t slot) {
+        std::vector<uint64_t> perCpu(static_cast<size_t>(libbpf_num_possible_cpus() > 0 ? libbpf_num_possible_cpus() : 1));
+        if (bpf_map_lookup_elem(fd, &slot, perCpu.data()) != 0) return 0;
+        uint64_t s = 0;
+        for (uint64_t v : perCpu) s += v;
+        return s;
+    }
+
+    struct RunResult {
+        double nsPerPacket = -1.0;
+        double wallSec = 0.0;
+        uint64_t passed = 0;
+        uint64_t dropped = 0;
+    };
+
+    RunResult runBucket(int progFd, const Maps& m, const Frame& frame, int repeat) {
+        RunResult r;
+        uint64_t p0 = sumSlot(m.verdicts, 0), d0 = sumSlot(m.verdicts, 1);
+        LIBBPF_OPTS(bpf_test_run_opts, opts);
+        opts.data_in = frame.data();
+        opts.data_size_in = static_cast<uint32_t>(frame.size());
+        opts.repeat = repeat;
+        auto t0 = Clock::now();
+        if (bpf_prog_test_run_opts(progFd, &opts) != 0) return r;
+        r.wallSec = std::chrono::duration<double>(Clock::now() - t0).count();
+        r.nsPerPacket = static_cast<double>(opts.duration);
+        r.passed = sumSlot(m.verdicts, 0) - p0;
+        r.dropped = sumSlot(m.verdicts, 1) - d0;
+        return r;
+    }
+
+    venom_rate_config configFor(uint32_t pps, uint32_t burst) {
+        venom_rate_config c{};
+        if (pps) {
+            c.cost_ns = 1000000000ULL / pps;
+            c.burst_ns = c.cost_ns * (burst ? burst : 1);
+        }
+        return c;
+    }
+
+    // ns/csomag és a visszatérési érték a valódi programra
+    double testRun(int progFd, const Frame& frame, int repeat, uint32_t* retval = nullptr) {
+        LIBBPF_OPTS(bpf_test_run_opts, opts);
+        opts.data_in = frame.data();
+        opts.data_size_in = static_cast<uint32_t>(frame.size());
+        opts.repeat = repeat;
+        if (bpf_prog_test_run_opts(progFd, &opts) != 0) return -1.0;
+        if (retval) *retval = opts.retval;
+        return static_cast<double>(opts.duration);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    uint32_t pps = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1000;
+    uint32_t burst = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 100;
+    std::string objPath = (argc > 4) ? argv[4] : "obj/core/ebpf/venom_shield.bpf.o";
+    if (pps == 0) pps = 1000;
+    if (burst == 0) burst = 1;
+
+    const Frame flood = udp4("10.0.0.99", "10.0.0.187", "");
+    int failures = 0;
+
+    // --- 1. vödör-kernel ---
+    Maps m;
+    m.config = bpf_map_create(BPF_MAP_TYPE_ARRAY, "rate_config_map", sizeof(uint32_t),
+                              sizeof(venom_rate_config), 1, nullptr);
+    m.buckets = bpf_map_create(BPF_MAP_TYPE_LRU_PERCPU_HASH, "rate_map", sizeof(venom_in6),
+                               sizeof(venom_rate_bucket), VENOM_RATE_MAX, nullptr);
+    m.verdicts = bpf_map_create(BPF_MAP_TYPE_PERCPU_ARRAY, "verdicts", sizeof(uint32_t), sizeof(uint64_t), 2, nullptr);
+    if (m.config < 0 || m.buckets < 0 || m.verdicts < 0) {
+        std::printf("xdp_ratelimit_bench: skipped (BPF map nem hozható létre: root kell)\n");
+        return 0;
+    }
+    std::vector<bpf_insn> prog = bucketKernel(m);
+    int progFd = bpf_prog_load(BPF_PROG_TYPE_XDP, "venom_bucket", "GPL", prog.data(), prog.size(), nullptr);
+    if (progFd < 0) {
+        std::printf("xdp_ratelimit_bench: skipped (BPF program nem tölthető: %s)\n", std::strerror(errno));
+        return 0;
+    }
+
+    uint32_t key = 0;
+    venom_rate_config off{};
+    bpf_map_update_elem(m.config, &key, &off, BPF_ANY);
+    RunResult disabled = runBucket(progFd, m, flood, repeat);
+
+    venom_rate_config on = configFor(pps, burst);
+    bpf_map_update_elem(m.config, &key, &on, BPF_ANY);
+    RunResult limited = runBucket(progFd, m, flood, repeat);
+
+    std::printf("vödör-kernel (%d ismétlés, egy forrás, %u pps / burst %u):\n", repeat, pps, burst);
+    std::printf("  %-34s %8.1f ns/csomag\n", "korlát kikapcsolva (config lookup)", disabled.nsPerPacket);
+    std::printf("  %-34s %8.1f ns/csomag  (átengedve %llu, eldobva %llu, %.3f s)\n", "token bucket",
+                limited.nsPerPacket, static_cast<unsigned long long>(limited.passed),
+                static_cast<unsigned long long>(limited.dropped), limited.wallSec);
+
+    const uint64_t R = static_cast<uint64_t>(repeat);
+    const uint64_t maxPassed = burst + static_cast<uint64_t>(static_cast<double>(pps) * limited.wallSec) + 1;
+    std::printf("golden:\n");
+    failures += check("disabled passed", disabled.passed, R);
+    failures += check("passed + dropped", limited.passed + limited.dropped, R);
+    bool inWindow = limited.passed >= std::min<uint64_t>(burst, R) && limited.passed <= maxPassed;
+    std::printf("  %-22s %8llu  (%u..%llu)%s\n", "passed in window", static_cast<unsigned long long>(limited.passed),
+                burst, static_cast<unsigned long long>(maxPassed), inWindow ? "" : "  MISMATCH");
+    if (!inWindow) failures++;
+
+    // Üresjárat után a vödör újratelik: pontosan burst csomag megy át egy gyors sorozatból
+    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(1000ULL * burst / pps) + 50));
+    RunResult refill = runBucket(progFd, m, flood, static_cast<int>(burst) * 4);
+    bool refilled = refill.passed >= burst && refill.passed <= burst + 1 +
+                    static_cast<uint64_t>(static_cast<double>(pps) * refill.wallSec);
+    std::printf("  %-22s %8llu  (burst %u)%s\n", "refill burst", static_cast<unsigned long long>(refill.passed),
+                burst, refilled ? "" : "  MISMATCH");
+    if (!refilled) failures++;
+    close(progFd);
+    close(m.config);
+    close(m.buckets);
+    close(m.verdicts);
+
+    // --- 2. a valódi venom_router_guard ---
+    BpfLoader loader;
+    if (setupVeth() && loader.deploy(objPath, "vb", XdpAttachMode::GENERIC)) {
+        int guardFd = loader.fds().guardProg;
+        RateLimit limit{pps, burst};
+        loader.setRateLimit(limit);
+
+        const Frame flood6 = udp6("2001:db8::99", "2001:db8::187", "");
+        const Frame other = udp4("10.0.0.77", "10.0.0.187", "");
+
+        BpfStats st0 = loader.getStats();
+        auto t0 = Clock::now();
+        double ns4 = testRun(guardFd, flood, repeat);
+        double ns6 = testRun(guardFd, flood6, repeat);
+        double wall = std::chrono::duration<double>(Clock::now() - t0).count();
+        uint32_t otherVerdict = 0;
+        testRun(guardFd, other, 1, &otherVerdict);
+        BpfStats st = loader.getStats();
+
+        std::printf("venom_router_guard (%u pps / burst %u):\n", pps, burst);
+        std::printf("  %-34s %8.1f ns/csomag\n", "IPv4 árvíz", ns4);
+        std::printf("  %-34s %8.1f ns/csomag\n", "IPv6 árvíz", ns6);
+
+        const uint64_t limitedPkts = st.rate_limited - st0.rate_limited;
+        const uint64_t allowed = 2 * R - limitedPkts;
+        const uint64_t maxAllowed = 2 * (burst + static_cast<uint64_t>(static_cast<double>(pps) * wall) + 1);
+        std::printf("golden (getStats):\n");
+        failures += check("dropped == rate_limited", st.dropped_packets - st0.dropped_packets, limitedPkts);
+        bool ok = allowed >= 2ULL * burst && allowed <= maxAllowed;
+        std::printf("  %-22s %8llu  (%u..%llu)%s\n", "allowed", static_cast<unsigned long long>(allowed),
+                    2 * burst, static_cast<unsigned long long>(maxAllowed), ok ? "" : "  MISMATCH");
+        if (!ok) failures++;
+        failures += check("other source passes", otherVerdict, XDP_PASS);
+
+        // Profilváltás: a LOCKDOWN a Hydra terv 100 pkt/s-e
+        loader.applyProfile(SecurityProfile::LOCKDOWN);
+        venom_rate_config cfg{};
+        int cfgFd = loader.fds().rateConfig;
+        bpf_map_lookup_elem(cfgFd, &key, &cfg);
+        failures += check("LOCKDOWN cost_ns", cfg.cost_ns, 1000000000ULL / RateLimit::forProfile(SecurityProfile::LOCKDOWN).packetsPerSec);
+        loader.setRateLimit({});
+        uint32_t verdict = 0;
+        testRun(guardFd, flood, 1, &verdict);
+        failures += check("disabled: flood passes", verdict, XDP_PASS);
+        loader.detach();
+    } else {
+        std::printf("venom_router_guard: skipped (XDP program nem tölthető: %s)\n", objPath.c_str());
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// XDP számlálók: megosztott ARRAY + atomikus add vs. PERCPU_ARRAY + sima add (BPF_PROG_TEST_RUN)
+//
+// Használat: xdp_stats_bench [repeat=1000000] [bpf_obj=obj/core/ebpf/venom_shield.bpf.o]
+//
+// 1. számláló-kernelek: kézzel összerakott XDP programok, amelyek csak a stats_map
+//    frissítését végzik. "előtte" = a régi út (ARRAY, __sync_fetch_and_add), "utána" =
+//    PERCPU_ARRAY, sima inkrement. ns/csomag a kernel test_run mérése szerint.
+//    Golden: a readStatsMap (egy batch olvasás + CPU-nkénti összeg) pontosan repeat-et ad.
+// 2. venom_router_guard: a valódi program ns/csomagja ismert keretekkel, és a
+//    getStats() verdikt-, protokoll- és ok-számlálói (golden). Csak ha az objektum betölthető.
+// A test_run a hívó CPU-ján fut: a cache-line pattogás megszűnése több magon látszik
+// igazán (párhuzamos futtatás, lásd taskset), itt az atomikus utasítás ára mérhető.
+// Root (CAP_BPF / CAP_SYS_ADMIN) kell; e nélkül "skipped" és 0-s kilépés.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <linux/bpf.h>
+#include <bpf/bpf.h>
+
+#include "veth_frames.hpp"
+#include "core/ebpf/BpfLoader.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+using namespace Venom::Core;
+using namespace VenomBench;
+
+namespace {
+
+    using Program = std::vector<bpf_insn>;
+
+    bpf_insn insn(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+        bpf_insn i{};
+        i.code = code;
+        i.dst_reg = dst & 0xf;
+        i.src_reg = src & 0xf;
+        i.off = off;
+        i.imm = imm;
+        return i;
+    }
+
+    // r1 = map (ld_imm64, két utasításhely)
+    void loadMap(Program& p, uint8_t dst, int mapFd) {
+        p.push_back(insn(BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, mapFd));
+        p.push_back(insn(0, 0, 0, 0, 0));
+    }
+
+    /**
+     * @brief Slotonként egy lookup + inkrement, majd XDP_PASS.
+     * atomic = true: lock xadd (a régi __sync_fetch_and_add), false: load/add/store.
+     */
+    Program counterKernel(int mapFd, const std::vector<uint32_t>& slots, bool atomic) {
+        Program p;
+        for (uint32_t slot : slots) {
+            p.push_back(insn(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, -4, static_cast<int32_t>(slot)));
+            loadMap(p, BPF_REG_1, mapFd);
+            p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0));
+            p.push_back(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, -4));
+            p.push_back(insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem));
+            if (atomic) {
+                p.push_back(insn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 2, 0));
+                p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_1, 0, 0, 1));
+                p.push_back(insn(BPF_STX | BPF_ATOMIC | BPF_DW, BPF_REG_0, BPF_REG_1, 0, BPF_ADD));
+            } else {
+                p.push_back(insn(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 3, 0));
+                p.push_back(insn(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_0, 0, 0));
+                p.push_back(insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_1, 0, 0, 1));
+                p.push_back(insn(BPF_STX | BPF_MEM | BPF_DW, BPF_REG_0, BPF_REG_1, 0, 0));
+            }
+        }
+        p.push_back(insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+        p.push_back(insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+        return p;
+    }
+
+    // ns/csomag a kernel mérése szerint; < 0 hiba esetén
+    double testRun(int progFd, const Frame& frame, int repeat, uint32_t* retval = nullptr) {
+        LIBBPF_OPTS(bpf_test_run_opts, opts);
+        opts.data_in = frame.data();
+        opts.data_size_in = static_cast<uint32_t>(frame.size());
+        opts.repeat = repeat;
+        if (bpf_prog_test_run_opts(progFd, &opts) != 0) return -1.0;
+        if (retval) *retval = opts.retval;
+        return static_cast<double>(opts.duration);
+    }
+
+    struct KernelResult {
+        double nsPerPacket = -1.0;
+        uint64_t counted = 0;   // Az első slot összege a futás után
+    };
+
+    KernelResult runCounterKernel(bpf_map_type type, const std::vector<uint32_t>& slots, bool atomic,
+                                  const Frame& frame, int repeat) {
+        KernelResult r;
+        int mapFd = bpf_map_create(type, "stats_map", sizeof(uint32_t), sizeof(uint64_t), VENOM_STAT_SLOTS, nullptr);
+        if (mapFd < 0) return r;
+
+        Program prog = counterKernel(mapFd, slots, atomic);
+        int progFd = bpf_prog_load(BPF_PROG_TYPE_XDP, "venom_cnt", "GPL", prog.data(), prog.size(), nullptr);
+        if (progFd >= 0) {
+            r.nsPerPacket = testRun(progFd, frame, repeat);
+            BpfStats st;
+            if (type == BPF_MAP_TYPE_PERCPU_ARRAY) {
+                if (readStatsMap(mapFd, st)) r.counted = st.inspected_packets;
+            } else {
+                uint32_t key = slots.front();
+                bpf_map_lookup_elem(mapFd, &key, &r.counted);
+            }
+            close(progFd);
+        }
+        close(mapFd);
+        return r;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    std::string objPath = (argc > 2) ? argv[2] : "obj/core/ebpf/venom_shield.bpf.o";
+
+    const Frame benign = udp4("10.0.0.77", "10.0.0.187", "hello venom");
+    int failures = 0;
+
+    // --- 1. számláló-kernelek ---
+    const std::vector<uint32_t> oldPath = {VENOM_STAT_INSPECTED};
+    const std::vector<uint32_t> newPath = {VENOM_STAT_INSPECTED, VENOM_STAT_PROTO_IPV4, VENOM_STAT_PASSED};
+
+    KernelResult before = runCounterKernel(BPF_MAP_TYPE_ARRAY, oldPath, true, benign, repeat);
+    if (before.nsPerPacket < 0) {
+        std::printf("xdp_stats_bench: skipped (BPF program nem tölthető / futtatható: root kell)\n");
+        return 0;
+    }
+    KernelResult atomic3 = runCounterKernel(BPF_MAP_TYPE_ARRAY, newPath, true, benign, repeat);
+    KernelResult percpu1 = runCounterKernel(BPF_MAP_TYPE_PERCPU_ARRAY, oldPath, false, benign, repeat);
+    KernelResult percpu3 = runCounterKernel(BPF_MAP_TYPE_PERCPU_ARRAY, newPath, false, benign, repeat);
+
+    std::printf("számláló-kernelek (%d ismétlés, benign IPv4/UDP):\n", repeat);
+    std::printf("  %-36s %8.1f ns/csomag\n", "előtte: ARRAY, 1 atomikus slot", before.nsPerPacket);
+    std::printf("  %-36s %8.1f ns/csomag\n", "ARRAY, 3 atomikus slot", atomic3.nsPerPacket);
+    std::printf("  %-36s %8.1f ns/csomag\n", "PERCPU_ARRAY, 1 slot", percpu1.nsPerPacket);
+    std::printf("  %-36s %8.1f ns/csomag\n", "utána: PERCPU_ARRAY, 3 slot", percpu3.nsPerPacket);
+    std::printf("golden (readStatsMap):\n");
+    failures += check("ARRAY inspected", before.counted, static_cast<uint64_t>(repeat));
+    failures += check("PERCPU inspected", percpu3.counted, static_cast<uint64_t>(repeat));
+
+    // --- 2. a valódi venom_router_guard ---
+    BpfLoader loader;
+    if (setupVeth() && loader.deploy(objPath, "vb", XdpAttachMode::GENERIC)) {
+        loader.setRouterMAC("02:00:00:00:00:01");
+        loader.blockIP("10.0.0.99");
+        int progFd = loader.fds().guardProg;
+
+        struct Case {
+            const char* name;
+            Frame frame;
+            uint32_t verdict;
+        };
+        const Case cases[] = {
+            {"IPv4 átengedve", benign, XDP_PASS},
+            {"IPv4 feketelistás", udp4("10.0.0.99", "10.0.0.187", "hello venom"), XDP_DROP},
+            {"IPv4 fragmens", udp4("10.0.0.77", "10.0.0.187", "hello venom", -1, 0x2000), XDP_PASS},
+            {"ARP router", arp(MAC_ROUTER, MAC_ROUTER, "10.0.0.1", "10.0.0.187"), XDP_PASS},
+            {"ARP idegen", arp(MAC_ATTACKER, MAC_ATTACKER, "10.0.0.66", "10.0.0.187"), XDP_PASS},
+            {"IPv6", udp6HopByHop("hello venom"), XDP_PASS},
+        };
+
+        BpfStats st0 = loader.getStats();
+        std::printf("venom_router_guard (%d ismétlés):\n", repeat);
+        for (const auto& c : cases) {
+            uint32_t retval = 0;
+            double ns = testRun(progFd, c.frame, repeat, &retval);
+            std::printf("  %-36s %8.1f ns/csomag%s\n", c.name, ns, retval == c.verdict ? "" : "  VERDICT MISMATCH");
+            if (ns < 0 || retval != c.verdict) failures++;
+        }
+        BpfStats st = loader.getStats();
+
+        const uint64_t R = static_cast<uint64_t>(repeat);
+        std::printf("golden (getStats):\n");
+        failures += check("inspected", st.inspected_packets - st0.inspected_packets, 6 * R);
+        failures += check("dropped", st.dropped_packets - st0.dropped_packets, R);
+        failures += check("passed", st.passed_packets - st0.passed_packets, 5 * R);
+        failures += check("ipv4", st.ipv4_packets - st0.ipv4_packets, 3 * R);
+        failures += check("arp", st.arp_packets - st0.arp_packets, 2 * R);
+        failures += check("ipv6", st.ipv6_packets - st0.ipv6_packets, R);
+        failures += check("blacklist drops", st.blacklist_drops - st0.blacklist_drops, R);
+        failures += check("fragments", st.fragments - st0.fragments, R);
+        failures += check("router arp", st.router_arp - st0.router_arp, R);
+        failures += check("untrusted arp", st.untrusted_arp - st0.untrusted_arp, R);
+        loader.detach();
+    } else {
+        std::printf("venom_router_guard: skipped (XDP program nem tölthető: %s)\n", objPath.c_str());
+    }
+
+    std::printf("%s\n", failures ? "FAIL" : "OK");
+    return failures ? 1 : 0;
+}
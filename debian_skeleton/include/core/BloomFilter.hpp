@@ -0,0 +1,77 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Cache-line blokkos Bloom-szűrő bináris címekre, két forgó generációval
+
+#ifndef VENOM_BLOOM_FILTER_HPP
+#define VENOM_BLOOM_FILTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "core/NetAddress.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief Blokkos Bloom-szűrő: egy cím mind a k bitje ugyanabban a 64 bájtos blokkban
+     * (8 x 64 bites szó) ül, így egy lekérdezés egyetlen cache line. A blokkot és a
+     * bitpozíciókat a NetAddress::hash két független magja adja (kettős hash: egy a blokkra,
+     * egy a blokkon belüli k bitre).
+     *
+     * Két generáció: a beszúrás az aktuálisba ír, a lekérdezés mindkettőt nézi. Ha az aktuális
+     * elérte a kapacitását, forgatás: a régebbi generáció lapjai madvise(MADV_DONTNEED)-del
+     * eldobódnak (nulla lapként jönnek vissza) és az lesz az aktuális. A törlés így nem
+     * egymillió tárolás, és a telítődő szűrő hamis pozitív aránya sem nő korlátlanul.
+     * A fpr a két generációra együtt értendő (generációnként a fele).
+     */
+    class BloomFilter {
+    public:
+        static constexpr size_t BLOCK_BITS = 512;
+        static constexpr unsigned MAX_HASHES = 16;
+
+        // capacity: generációnként ennyi cím után forgat; fpr: a cél hamis pozitív arány
+        BloomFilter(size_t capacity, double fpr);
+        ~BloomFilter();
+        BloomFilter(const BloomFilter&) = delete;
+        BloomFilter& operator=(const BloomFilter&) = delete;
+
+        void insert(const NetAddress& addr);
+        bool contains(const NetAddress& addr) const;
+
+        // A régebbi generáció eldobása (a kapacitás elérésekor magától is megtörténik)
+        void rotate();
+        // Mindkét generáció eldobása
+        void clear();
+
+        size_t blockCount() const { return blocks; }
+        unsigned hashCount() const { return hashes; }
+        size_t memoryBytes() const { return 2 * genBytes; }
+        uint64_t rotations() const { return rotationCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Probe {
+            size_t block;
+            uint64_t mask[BLOCK_BITS / 64];
+        };
+
+        uint64_t* gen[2] = {nullptr, nullptr};   // mmap-elt, lapra igazított szótömbök
+        size_t genBytes = 0;
+        size_t blocks = 0;
+        unsigned hashes = 0;
+        size_t capacity;
+
+        std::atomic<unsigned> active{0};
+        std::atomic<size_t> inserted{0};         // Az aktuális generációba írt címek
+        std::atomic<uint64_t> rotationCount{0};
+        std::mutex rotateMtx;                    // Forgatás / törlés egyszerre csak egy
+
+        Probe probe(const NetAddress& addr) const;
+        // Várható hamis pozitív arány egy generációban, blokkos elrendezéssel
+        static double blockedFpr(double bitsPerItem, unsigned k);
+        void drop(uint64_t* words);
+    };
+}
+
+#endif // VENOM_BLOOM_FILTER_HPP
@@ -0,0 +1,119 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Chase-Lev work-stealing deque (WorkStealingPool workerenként)
+
+#ifndef VENOM_CHASE_LEV_DEQUE_HPP
+#define VENOM_CHASE_LEV_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "core/MpscRing.hpp" // VENOM_CACHE_LINE
+
+namespace Venom::Core {
+
+    /**
+     * @brief Chase-Lev deque (Lê et al. C11 memóriamodell szerinti változata).
+     * A tulajdonos szál a bottom végén push/pop-ol (LIFO: a friss, cache-meleg feladat),
+     * a tolvajok a top végéről lopnak egyetlen CAS-sal. Tele tömbnél a tulajdonos duplázza;
+     * a régi tömb a deque élete végéig megmarad (egy tolvaj még olvashat belőle).
+     */
+    template<typename T>
+    class ChaseLevDeque {
+        static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque holds trivially copyable values");
+
+    private:
+        struct Array {
+            explicit Array(int64_t cap) : capacity(cap), slots(new std::atomic<T>[static_cast<size_t>(cap)]) {}
+
+            const int64_t capacity;   // Kettő hatványa
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            T get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+            void put(int64_t i, T v) { slots[i & (capacity - 1)].store(v, std::memory_order_relaxed); }
+        };
+
+        alignas(VENOM_CACHE_LINE) std::atomic<int64_t> top{0};
+        alignas(VENOM_CACHE_LINE) std::atomic<int64_t> bottom{0};
+        std::atomic<Array*> array;
+        std::vector<std::unique_ptr<Array>> arrays;   // Csak a tulajdonos írja
+
+        Array* grow(Array* a, int64_t b, int64_t t) {
+            auto bigger = std::make_unique<Array>(a->capacity * 2);
+            for (int64_t i = t; i < b; ++i) bigger->put(i, a->get(i));
+            Array* next = bigger.get();
+            arrays.push_back(std::move(bigger));
+            array.store(next, std::memory_order_release);
+            return next;
+        }
+
+    public:
+        explicit ChaseLevDeque(size_t initialCapacity = 256) {
+            int64_t cap = 2;
+            while (cap < static_cast<int64_t>(initialCapacity)) cap <<= 1;
+            arrays.push_back(std::make_unique<Array>(cap));
+            array.store(arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        // Csak a tulajdonos hívhatja
+        void push(T value) {
+            const int64_t b = bottom.load(std::memory_order_relaxed);
+            const int64_t t = top.load(std::memory_order_acquire);
+            Array* a = array.load(std::memory_order_relaxed);
+            if (b - t > a->capacity - 1) a = grow(a, b, t);
+            a->put(b, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // Csak a tulajdonos hívhatja; az utolsó elemért a tolvajokkal CAS dönt
+        bool pop(T& out) {
+            const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Array* a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = a->get(b);
+            if (t == b) {
+                const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                             std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // Bármely szál hívhatja; false: üres, vagy egy másik tolvaj / a tulajdonos nyert
+        bool steal(T& out) {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) return false;
+            Array* a = array.load(std::memory_order_acquire);
+            const T value = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
+        // Pillanatnyi becslés (ébresztési / parkolási döntéshez)
+        bool empty() const {
+            return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif // VENOM_CHASE_LEV_DEQUE_HPP
@@ -0,0 +1,62 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Incremental sliding-window entropy for long-lived streams
+
+#ifndef VENOM_ENTROPY_ACCUMULATOR_HPP
+#define VENOM_ENTROPY_ACCUMULATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Venom::Core {
+
+    /**
+     * @brief Csúszóablakos Shannon-entrópia, bájtonként O(1) frissítéssel.
+     * A hisztogram és a S = Σ c*log2(c) összeg együtt mozog az ablakkal: egy belépő
+     * és egy kilépő bájt két bin különbségét módosítja, a teljes puffert soha nem
+     * hash-eljük újra. Így a szétdarabolt ("slow-drip") bináris payload is látszik,
+     * hiába érkezik apró, egyenként alacsony entrópiájú darabokban.
+     */
+    class EntropyAccumulator {
+    public:
+        static constexpr size_t DEFAULT_WINDOW = 4096; // N KiB csúszóablak
+
+        explicit EntropyAccumulator(size_t windowBytes = DEFAULT_WINDOW);
+
+        /**
+         * @brief Új bájtok hozzáadása; a legrégebbiek kicsúsznak az ablakból.
+         */
+        void update(std::string_view chunk);
+
+        /**
+         * @brief Az ablak aktuális entrópiája (bit/bájt).
+         */
+        double entropy() const;
+
+        // Az ablak újrahasznosítása új kapcsolathoz (nincs új allokáció)
+        void reset();
+
+        size_t windowSize() const { return window.size(); }
+        size_t filled() const { return fill; }
+        uint64_t totalBytes() const { return total; }
+
+    private:
+        // Ennyi bájt után S-et a számlálókból újraszámoljuk (lebegőpontos sodródás ellen)
+        static constexpr uint64_t RESYNC_INTERVAL = 1u << 20;
+
+        std::vector<uint8_t> window;
+        uint32_t counts[256] = {};
+        double sumNLogN = 0.0;
+        size_t head = 0;
+        size_t fill = 0;
+        uint64_t total = 0;
+        uint64_t sinceResync = 0;
+
+        void resync();
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_ENTROPY_ACCUMULATOR_HPP
@@ -0,0 +1,44 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Table-driven Shannon entropy kernel (interleaved sub-histograms)
+
+#ifndef VENOM_ENTROPY_ENGINE_HPP
+#define VENOM_ENTROPY_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Venom::Core {
+
+    /**
+     * @brief A StreamProbe entrópia-motorja.
+     * H = log2(N) - (1/N) * Σ c*log2(c), ahol a c*log2(c) értékek előre számolt táblából
+     * jönnek (N < TABLE_SIZE esetén), így eseményenként egyetlen log2 hívás marad.
+     * A hisztogram 4 egymásba fűzött al-hisztogramba épül (nincs store-to-load stall
+     * az ismétlődő bájtokon).
+     */
+    class EntropyEngine {
+    public:
+        static constexpr size_t TABLE_SIZE = 4096;      // c*log2(c) tábla: 32 KiB, L1-barát
+        static constexpr size_t SMALL_PAYLOAD = 256;    // ez alatt egyetlen hisztogram + újrapásztázás
+
+        /**
+         * @brief Entrópia: SMALL_PAYLOAD alatt egyetlen hisztogram, felette a 4 al-hisztogram.
+         */
+        static double compute(std::string_view data);
+
+        /**
+         * @brief Entrópia kész hisztogramból (256 bin, total = bájtok száma).
+         */
+        static double fromHistogram(const uint32_t* hist, size_t total);
+
+        /**
+         * @brief c*log2(c) (táblából, ha c < TABLE_SIZE) – az inkrementális akkumulátor építőköve.
+         */
+        static double nlog2n(uint32_t c);
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_ENTROPY_ENGINE_HPP
@@ -0,0 +1,112 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Edge-triggered epoll reactor for SocketProbe (fixed worker pool)
+
+#ifndef VENOM_EPOLL_REACTOR_HPP
+#define VENOM_EPOLL_REACTOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/VenomBus.hpp"
+#include "core/EntropyAccumulator.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief Ingress számlálók (a SocketProbe birtokolja, a backendek írják).
+     */
+    struct alignas(64) IngressCounters {
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> closed{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> rejected{0};  // Kapacitáson felüli kapcsolat: azonnal lezárva
+        std::atomic<uint64_t> shed{0};      // A bus NULL_ONLY állapotában elfogadás után azonnal lezárva
+    };
+
+    /**
+     * @brief Kapcsolat-életciklus korlátai (minden backend ugyanezt alkalmazza).
+     */
+    struct ConnectionLimits {
+        static constexpr uint64_t IDLE_TIMEOUT_MS = 2000;       // Ennyi csend után zárunk
+        static constexpr uint64_t STREAM_BUDGET_BYTES = 1 << 20; // Kapcsolatonkénti plafon
+        static constexpr size_t READ_CHUNK = 2048;              // = PayloadBlock::CAPACITY
+    };
+
+    /**
+     * @brief Egy reaktor-példány beállításai.
+     */
+    struct ReactorOptions {
+        unsigned workers = 1;
+        size_t maxConnections = 16384;
+        IngressLane lane{};   // Melyik bus-sávra tol (shardonként saját)
+        int cpu = -1;         // >= 0: a worker(ek) erre a CPU-ra rögzítve
+    };
+
+    /**
+     * @brief Edge-triggered epoll reaktor, N worker szállal.
+     * Minden worker saját epoll példányt futtat; a listen socket mindegyikben
+     * EPOLLEXCLUSIVE-vel ül, így egy új kapcsolat csak egy workert ébreszt.
+     * A kapcsolat az őt elfogadó workernél marad (nincs szálak közti átadás),
+     * az olvasás nem blokkol, a payload közvetlenül a buszra megy.
+     */
+    class EpollReactor {
+    public:
+        EpollReactor(VenomBus& bus, SourceId source, int listenFd, IngressCounters& counters,
+                     const ReactorOptions& options = {});
+        ~EpollReactor();
+
+        EpollReactor(const EpollReactor&) = delete;
+        EpollReactor& operator=(const EpollReactor&) = delete;
+
+        bool start();
+        void stop();
+
+    private:
+        enum class ConnState : uint8_t { READING, CLOSING };
+
+        struct Connection {
+            int fd = -1;
+            ConnState state = ConnState::READING;
+            NetAddress peer;
+            EntropyAccumulator entropy;
+            uint64_t lastActivityMs = 0;
+            Connection* prev = nullptr;   // Aktív lista (idle sweep)
+            Connection* next = nullptr;
+        };
+
+        struct Worker {
+            int epfd = -1;
+            std::thread thread;
+            std::vector<std::unique_ptr<Connection>> storage; // Csak növekszik: újrahasznosítás
+            std::vector<Connection*> freeList;
+            Connection* active = nullptr;
+            size_t live = 0;
+            bool acceptPending = false;   // fd-/memóriahiány: a sor nincs kiürítve, újra kell próbálni
+        };
+
+        VenomBus& bus;
+        SourceId sourceId;
+        int listenFd;
+        int wakeFd;
+        size_t maxPerWorker;
+        IngressLane lane;
+        int cpu;
+        IngressCounters& counters;
+        std::atomic<bool> running{false};
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        void run(Worker& w);
+        void acceptAll(Worker& w);
+        void onReadable(Worker& w, Connection* c);
+        void closeConnection(Worker& w, Connection* c);
+        void sweepIdle(Worker& w, uint64_t nowMs);
+        Connection* obtain(Worker& w);
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_EPOLL_REACTOR_HPP
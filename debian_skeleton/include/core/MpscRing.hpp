@@ -0,0 +1,137 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Bounded, lock-free MPSC ring (Vent Bus ingress)
+
+#ifndef VENOM_MPSC_RING_HPP
+#define VENOM_MPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Venom::Core {
+
+    // Cache-line méret: a producer/consumer indexek és a slotok ne osztozzanak soron.
+    constexpr size_t VENOM_CACHE_LINE = 64;
+
+    /**
+     * @brief Korlátos, lock-free multi-producer / single-consumer gyűrű.
+     * Slotonkénti szekvencia-számláló (Vyukov-séma): a producerek egyetlen CAS-sal
+     * foglalnak helyet, a consumer mutex nélkül olvas. Tele gyűrűnél a push azonnal
+     * false-t ad vissza – nincs blokkolás, nincs lock convoy.
+     */
+    template<typename T, size_t Capacity>
+    class MpscRing {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                      "MpscRing capacity must be a power of two");
+
+    private:
+        struct alignas(VENOM_CACHE_LINE) Slot {
+            std::atomic<size_t> sequence;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+            T* value() { return std::launder(reinterpret_cast<T*>(&storage)); }
+        };
+
+        static constexpr size_t MASK = Capacity - 1;
+
+        alignas(VENOM_CACHE_LINE) std::atomic<size_t> enqueuePos{0};
+        alignas(VENOM_CACHE_LINE) std::atomic<size_t> dequeuePos{0};
+        alignas(VENOM_CACHE_LINE) Slot slots[Capacity];
+
+    public:
+        MpscRing() {
+            for (size_t i = 0; i < Capacity; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MpscRing() {
+            while (tryPopInto([](T&&) {})) {}
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        static constexpr size_t capacity() { return Capacity; }
+
+        /**
+         * @brief Producer oldal: bármelyik szálról hívható.
+         * @return false, ha a gyűrű tele van (a hívó dönt a null-route-ról).
+         */
+        template<typename... Args>
+        bool tryPush(Args&&... args) {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots[pos & MASK];
+                size_t seq = slot.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        new (&slot.storage) T(std::forward<Args>(args)...);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // Tele
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Consumer oldal: egyetlen elem kivétele, a sink-be mozgatva.
+         * Kizárólag a drain szálról hívható.
+         */
+        template<typename Sink>
+        bool tryPopInto(Sink&& sink) {
+            size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Slot& slot = slots[pos & MASK];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+            if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+                return false; // Üres (vagy a producer még írja a slotot)
+            }
+
+            T* value = slot.value();
+            sink(std::move(*value));
+            value->~T();
+
+            dequeuePos.store(pos + 1, std::memory_order_relaxed);
+            slot.sequence.store(pos + Capacity, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Kötegelt kivétel: legfeljebb maxItems elem a sink-be.
+         * @return A ténylegesen kivett elemek száma.
+         */
+        template<typename Sink>
+        size_t drainInto(Sink&& sink, size_t maxItems) {
+            size_t taken = 0;
+            while (taken < maxItems && tryPopInto(sink)) {
+                ++taken;
+            }
+            return taken;
+        }
+
+        /**
+         * @brief Közelítő foglaltság (telemetriához, nem szinkronizációhoz).
+         */
+        size_t approxSize() const {
+            size_t head = dequeuePos.load(std::memory_order_relaxed);
+            size_t tail = enqueuePos.load(std::memory_order_relaxed);
+            return (tail >= head) ? (tail - head) : 0;
+        }
+
+        bool empty() const { return approxSize() == 0; }
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_MPSC_RING_HPP
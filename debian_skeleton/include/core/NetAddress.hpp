@@ -0,0 +1,107 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Packed binary network address (IPv4 / IPv6) – no heap, no text form on the hot path
+
+#ifndef VENOM_NET_ADDRESS_HPP
+#define VENOM_NET_ADDRESS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace Venom::Core {
+
+    /**
+     * @brief Fix méretű, bináris cím. Az IPv4 IPv4-mapped (::ffff:a.b.c.d) formában ül,
+     * így egyetlen 16 bájtos kulcs szolgálja ki mindkét családot.
+     */
+    struct NetAddress {
+        uint8_t bytes[16] = {};
+        uint8_t family = 0; // 0 = nincs cím, AF_INET, AF_INET6
+
+        bool empty() const { return family == 0; }
+        bool isV4() const { return family == AF_INET; }
+
+        static NetAddress fromV4(uint32_t networkOrder) {
+            NetAddress a;
+            a.family = AF_INET;
+            a.bytes[10] = 0xff;
+            a.bytes[11] = 0xff;
+            std::memcpy(&a.bytes[12], &networkOrder, 4);
+            return a;
+        }
+
+        static NetAddress fromV6(const uint8_t* raw16) {
+            NetAddress a;
+            a.family = AF_INET6;
+            std::memcpy(a.bytes, raw16, 16);
+            return a;
+        }
+
+        /**
+         * @brief Szöveges címből (pl. "192.0.2.7" vagy "2001:db8::1").
+         * @return false, ha egyik család szerint sem értelmezhető.
+         */
+        static bool parse(const std::string& text, NetAddress& out) {
+            in_addr v4{};
+            if (inet_pton(AF_INET, text.c_str(), &v4) == 1) {
+                out = fromV4(v4.s_addr);
+                return true;
+            }
+            in6_addr v6{};
+            if (inet_pton(AF_INET6, text.c_str(), &v6) == 1) {
+                out = fromV6(v6.s6_addr);
+                return true;
+            }
+            return false;
+        }
+
+        // IPv4 cím hálózati bájtsorrendben (csak isV4() esetén értelmes)
+        uint32_t v4() const {
+            uint32_t ip;
+            std::memcpy(&ip, &bytes[12], 4);
+            return ip;
+        }
+
+        std::string toString() const {
+            char buf[INET6_ADDRSTRLEN] = {};
+            if (family == AF_INET) {
+                inet_ntop(AF_INET, &bytes[12], buf, sizeof(buf));
+            } else if (family == AF_INET6) {
+                inet_ntop(AF_INET6, bytes, buf, sizeof(buf));
+            }
+            return std::string(buf);
+        }
+
+        // A 16 bájt két 64 bites szóként (a hash-táblák kulcsa, másolás nélkül)
+        uint64_t hi() const { uint64_t w; std::memcpy(&w, bytes, 8); return w; }
+        uint64_t lo() const { uint64_t w; std::memcpy(&w, bytes + 8, 8); return w; }
+
+        /**
+         * @brief 64 bites hash a bináris címen (wyhash-féle 128 bites szorzás-keverés):
+         * a szomszédos címek (10.0.0.1, 10.0.0.2, ...) is független biteket adnak. Csak a
+         * 16 bájtból számol (az IPv4 a mapped alakból felismerhető), így a két szóból is
+         * újraszámolható.
+         */
+        uint64_t hash(uint64_t seed = 0) const { return hashWords(hi(), lo(), seed); }
+
+        static uint64_t hashWords(uint64_t hi, uint64_t lo, uint64_t seed = 0) {
+            auto mum = [](uint64_t a, uint64_t b) {
+                unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+                return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+            };
+            uint64_t h = mum(hi ^ 0xa0761d6478bd642full ^ seed, lo ^ 0xe7037ed1a0b428dbull);
+            return mum(h, 0x8ebc6af09c88c6e3ull ^ seed);
+        }
+
+        bool operator==(const NetAddress& o) const {
+            return family == o.family && std::memcmp(bytes, o.bytes, 16) == 0;
+        }
+        bool operator!=(const NetAddress& o) const { return !(*this == o); }
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_NET_ADDRESS_HPP
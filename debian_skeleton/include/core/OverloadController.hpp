@@ -0,0 +1,87 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// A VenomBus túlterhelés-állapotgépe: UP -> DEGRADED -> OVERLOAD -> NULL_ONLY, hiszterézissel
+
+#ifndef VENOM_OVERLOAD_CONTROLLER_HPP
+#define VENOM_OVERLOAD_CONTROLLER_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include "telemetry/TelemetryTypes.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief Küszöbök és fokozatos tehermentesítés. Szintenként külön belépési és (alacsonyabb)
+     * kilépési küszöb, a visszalépés pedig szintenként coolDown nyugalmat kér: a határon
+     * ingadozó terhelés nem billegteti az állapotot.
+     */
+    struct OverloadPolicy {
+        // Becsült várakozási idő (ms): max(ablak-késleltetés, mélység / drain ütem)
+        double degradedEnterMs = 2.0;
+        double degradedExitMs = 0.5;
+        double overloadEnterMs = 10.0;
+        double overloadExitMs = 3.0;
+        double nullOnlyEnterMs = 40.0;
+        double nullOnlyExitMs = 10.0;
+        // A sorkapacitás töltöttsége (a késleltetéstől függetlenül is emel; NULL_ONLY-ig nem)
+        double degradedEnterFill = 0.50;
+        double degradedExitFill = 0.20;
+        double overloadEnterFill = 0.85;
+        double overloadExitFill = 0.40;
+        std::chrono::milliseconds coolDown{500};
+        // Alacsony prioritású (hálózati) források mintavétele: minden N-edik marad meg
+        uint32_t degradedKeepOneIn = 2;
+        uint32_t overloadKeepOneIn = 8;
+
+        // Soha nem lép át (mérésekhez, összehasonlításhoz)
+        static OverloadPolicy disabled();
+    };
+
+    /**
+     * @brief A bus drain szála hívja CONTROL_INTERVAL-onként. Nem szálbiztos: egyetlen hívó
+     * (a drain szál) léptet; az állapotot a hívó publikálja (BusTelemetry::state).
+     * A felfelé lépés azonnali (akár több szintet is), a lefelé lépés szintenként coolDown
+     * után, ha közben a mérések végig az aktuális szint kilépési küszöbe alatt maradtak.
+     */
+    class OverloadController {
+    public:
+        static constexpr std::chrono::milliseconds CONTROL_INTERVAL{10};
+        // A drain ütem simítása (exponenciális átlag súlya az új mintára)
+        static constexpr double RATE_ALPHA = 0.3;
+
+        struct Sample {
+            uint64_t nowNs = 0;           // steady_clock
+            uint32_t depth = 0;           // Sorban álló (még nem pontozott) események
+            uint32_t capacity = 1;        // Az ingress + partíció gyűrűk összkapacitása
+            uint64_t drained = 0;         // Feldolgozott események (kumulatív)
+            uint64_t maxSojournNs = 0;    // Az intervallum leghosszabb beküldés -> pontozás ideje
+        };
+
+        explicit OverloadController(const OverloadPolicy& policy = {}) : policy(policy) {}
+
+        BusState update(const Sample& s);
+
+        BusState state() const { return current; }
+        const OverloadPolicy& getPolicy() const { return policy; }
+        double delayMs() const { return lastDelayMs; }
+        double drainRate() const { return rate; }        // esemény / s
+        uint64_t transitions() const { return transitionCount; }
+
+    private:
+        OverloadPolicy policy;
+        BusState current = BusState::UP;
+        uint64_t lastNs = 0;
+        uint64_t lastDrained = 0;
+        uint64_t calmSinceNs = 0;         // 0 = nincs nyugalmi szakasz
+        double rate = 0.0;
+        double lastDelayMs = 0.0;
+        uint64_t transitionCount = 0;
+
+        BusState target(double delayMs, double fill) const;
+        bool calm(double delayMs, double fill) const;
+    };
+}
+
+#endif // VENOM_OVERLOAD_CONTROLLER_HPP
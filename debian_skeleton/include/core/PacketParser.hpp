@@ -0,0 +1,61 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Zero-copy Ethernet / ARP / IPv4 / IPv6 header parser (capture rings, AF_XDP UMEM)
+
+#ifndef VENOM_PACKET_PARSER_HPP
+#define VENOM_PACKET_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/NetAddress.hpp"
+
+namespace Venom::Core {
+
+    enum class FrameKind : uint8_t { OTHER, ARP, IPV4, IPV6 };
+
+    /**
+     * @brief Egy keret feldolgozott nézete. A mutatók a capture-pufferbe mutatnak
+     * (nincs másolás); csak addig érvényesek, amíg a blokk/keret a felhasználónál van.
+     */
+    struct PacketView {
+        FrameKind kind = FrameKind::OTHER;
+        uint16_t etherType = 0;        // VLAN címkék után (host byte order)
+        uint8_t vlanDepth = 0;
+        const uint8_t* srcMac = nullptr;
+
+        // L3
+        NetAddress src;
+        NetAddress dst;
+        uint8_t l4Proto = 0;           // IPPROTO_*; IPv6-nál a kiterjesztések utáni
+        bool fragment = false;         // Nem első fragmens: nincs L4 fejléc
+
+        // L4
+        uint16_t srcPort = 0;
+        uint16_t dstPort = 0;
+
+        // ARP
+        uint16_t arpOp = 0;
+        const uint8_t* arpSenderMac = nullptr;
+
+        // Az érdemi tartalom: L4 payload (TCP/UDP), ARP-nál maga az ARP fejléc
+        const uint8_t* payload = nullptr;
+        size_t payloadLen = 0;
+    };
+
+    /**
+     * @brief Fejlécelemzés határellenőrzéssel; minden mező a bemeneti pufferből olvasódik.
+     * Legfeljebb 2 VLAN címkét és MAX_IPV6_EXT_HEADERS IPv6 kiterjesztést lép át.
+     * @return false, ha a keret csonka vagy hibás (a view ilyenkor részleges lehet).
+     */
+    class PacketParser {
+    public:
+        static constexpr int MAX_VLAN_TAGS = 2;
+        static constexpr int MAX_IPV6_EXT_HEADERS = 6;
+
+        static bool parse(const uint8_t* frame, size_t len, PacketView& out);
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_PACKET_PARSER_HPP
@@ -0,0 +1,133 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Slab payload pool for VentEvent (zero allocation in steady state)
+
+#ifndef VENOM_PAYLOAD_POOL_HPP
+#define VENOM_PAYLOAD_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <initializer_list>
+
+#include "core/MpscRing.hpp" // VENOM_CACHE_LINE
+
+namespace Venom::Core {
+
+    class PayloadPool;
+
+    /**
+     * @brief Egy pool-blokk: referenciaszámlált fejléc + inline adat.
+     * A SocketProbe olvasási puffere (2048 B) egy az egyben belefér.
+     */
+    struct alignas(VENOM_CACHE_LINE) PayloadBlock {
+        static constexpr size_t CAPACITY = 2048;
+
+        std::atomic<uint32_t> refs{0};
+        uint32_t length = 0;
+        uint32_t index = 0;
+        PayloadPool* pool = nullptr;
+        char data[CAPACITY];
+    };
+
+    /**
+     * @brief Referenciaszámlált "szelet" egy pool-blokkra.
+     * Másolás = atomikus inkrement, nincs heap; az utolsó példány adja vissza a blokkot.
+     */
+    class PayloadSlice {
+    private:
+        PayloadBlock* block = nullptr;
+
+        void release();
+
+    public:
+        PayloadSlice() = default;
+        explicit PayloadSlice(PayloadBlock* b) : block(b) {}
+        ~PayloadSlice() { release(); }
+
+        PayloadSlice(const PayloadSlice& o) : block(o.block) {
+            if (block) block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        PayloadSlice(PayloadSlice&& o) noexcept : block(o.block) { o.block = nullptr; }
+
+        PayloadSlice& operator=(const PayloadSlice& o) {
+            if (this != &o) {
+                if (o.block) o.block->refs.fetch_add(1, std::memory_order_relaxed);
+                release();
+                block = o.block;
+            }
+            return *this;
+        }
+        PayloadSlice& operator=(PayloadSlice&& o) noexcept {
+            if (this != &o) {
+                release();
+                block = o.block;
+                o.block = nullptr;
+            }
+            return *this;
+        }
+
+        bool valid() const { return block != nullptr; }
+        std::string_view view() const {
+            return block ? std::string_view(block->data, block->length) : std::string_view();
+        }
+        size_t size() const { return block ? block->length : 0; }
+    };
+
+    /**
+     * @brief Slab-alapú, lock-free (Treiber + ABA-tag) szabadlistás blokk-pool.
+     * Slab-onként SLAB_BLOCKS blokk; új slab csak akkor jön létre, ha a szabadlista
+     * kiürült és még nem értük el a MAX_SLABS plafont. Bemelegedés után nincs malloc.
+     */
+    class PayloadPool {
+    public:
+        static constexpr uint32_t SLAB_BLOCKS = 256;
+        static constexpr uint32_t MAX_SLABS = 64; // 16384 blokk * 2 KiB = 32 MiB plafon
+
+        explicit PayloadPool(uint32_t initialSlabs = 4);
+        ~PayloadPool();
+
+        PayloadPool(const PayloadPool&) = delete;
+        PayloadPool& operator=(const PayloadPool&) = delete;
+
+        /**
+         * @brief Blokk foglalása és feltöltése a részletekből (konkatenáció heap nélkül).
+         * A CAPACITY feletti rész csonkolódik. Kimerült pool esetén érvénytelen szelet.
+         */
+        PayloadSlice acquire(std::initializer_list<std::string_view> parts);
+
+        uint32_t blocksInUse() const { return inUse.load(std::memory_order_relaxed); }
+        uint32_t slabCount() const { return slabs.load(std::memory_order_acquire); }
+
+    private:
+        friend class PayloadSlice;
+
+        static constexpr uint32_t NIL = 0xffffffffu;
+
+        // Felső 32 bit: ABA tag, alsó 32 bit: blokk index
+        alignas(VENOM_CACHE_LINE) std::atomic<uint64_t> freeHead{NIL};
+        alignas(VENOM_CACHE_LINE) std::atomic<uint32_t> inUse{0};
+        std::atomic<uint32_t> slabs{0};
+        std::atomic<bool> growing{false};
+
+        std::unique_ptr<PayloadBlock[]> slabTable[MAX_SLABS];
+        std::unique_ptr<std::atomic<uint32_t>[]> nextFree; // blokk index -> következő szabad
+
+        PayloadBlock* blockAt(uint32_t index) const;
+        PayloadBlock* pop();
+        void push(PayloadBlock* block);
+        bool grow();
+    };
+
+    inline void PayloadSlice::release() {
+        if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block->pool->push(block);
+        }
+        block = nullptr;
+    }
+
+} // namespace Venom::Core
+
+#endif // VENOM_PAYLOAD_POOL_HPP
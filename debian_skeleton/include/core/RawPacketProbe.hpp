@@ -1,31 +1,140 @@
 #pragma once
 #include "core/VenomBus.hpp"
+#include "core/PacketParser.hpp"
+#include "core/XskSocket.hpp"
+#include <array>
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <string>
 #include <vector>
 
 namespace Venom::Core {
 
+    enum class CaptureMode : uint8_t {
+        TPACKET_V3,  // AF_PACKET mmap ring: minden keret az interfészről
+        XSK          // AF_XDP socket: csak az XDP (xsks_map) által kiválasztott, gyanús keretek
+    };
+
+    /**
+     * @brief A capture motor összesített számlálói (a ring méretezéséhez is).
+     */
+    struct RawCaptureStats {
+        uint64_t packets = 0;       // A ringből feldolgozott keretek
+        uint64_t bytes = 0;
+        uint64_t arp = 0;
+        uint64_t arpTrusted = 0;    // Engedélyezett routertől jött ARP (nem jelölt)
+        uint64_t ipv4 = 0;
+        uint64_t ipv6 = 0;
+        uint64_t other = 0;
+        uint64_t malformed = 0;
+        uint64_t ringDrops = 0;     // TPACKET: tp_drops; AF_XDP: rx_dropped + rx_ring_full
+        uint64_t ringFreezes = 0;   // TPACKET: tp_freeze_q_cnt; AF_XDP: üres fill ring
+        uint64_t blocks = 0;        // Visszaadott TPACKET_V3 blokkok / AF_XDP kötegek
+        uint32_t workers = 0;
+        CaptureMode mode = CaptureMode::TPACKET_V3;
+        bool zeroCopy = false;      // AF_XDP: XDP_ZEROCOPY kötés sikerült
+    };
+
+    /**
+     * @brief AF_PACKET capture TPACKET_V3 mmap-elt blokk-gyűrűvel.
+     * Workerenként egy socket + ring; több worker esetén PACKET_FANOUT (flow hash)
+     * osztja el a kereteket. A blokkokat a kernel tölti, a worker helyben (másolás
+     * nélkül) elemzi és a releváns tartalmat a VenomBus-ra teszi; ARP keretnél
+     * EVENT_FLAG_ARP-pal.
+     * AF_XDP módban workerenként (RX soronként) egy XskSocket fut; a keretek csak
+     * akkor érkeznek, ha a venom_router_guard XDP program az xsks_map-be irányítja őket.
+     */
     class RawPacketProbe {
+    public:
+        static constexpr uint32_t DEFAULT_BLOCK_SIZE = 1u << 20;   // 1 MiB blokk
+        static constexpr uint32_t DEFAULT_BLOCK_COUNT = 16;        // 16 MiB / worker
+        static constexpr uint32_t FRAME_SIZE = 2048;               // A tpacket_req3 frame-számításához
+        static constexpr uint32_t BLOCK_TIMEOUT_MS = 10;           // Részleges blokk visszavonása
+
     private:
+        struct alignas(64) WorkerCounters {
+            std::atomic<uint64_t> packets{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> arp{0};
+            std::atomic<uint64_t> arpTrusted{0};
+            std::atomic<uint64_t> ipv4{0};
+            std::atomic<uint64_t> ipv6{0};
+            std::atomic<uint64_t> other{0};
+            std::atomic<uint64_t> malformed{0};
+            std::atomic<uint64_t> ringDrops{0};
+            std::atomic<uint64_t> ringFreezes{0};
+            std::atomic<uint64_t> blocks{0};
+        };
+
+        struct Worker {
+            int fd = -1;
+            uint8_t* ring = nullptr;
+            size_t ringSize = 0;
+            std::unique_ptr<XskSocket> xsk;   // AF_XDP mód
+            uint32_t queue = 0;
+            std::thread thread;
+            WorkerCounters counters;
+        };
+
+        // Keretenkénti számlálás helyben; blokkonként/kötegenként egyszer kerül a workerre
+        struct FrameTally {
+            uint64_t packets = 0, bytes = 0, arp = 0, arpTrusted = 0;
+            uint64_t ipv4 = 0, ipv6 = 0, other = 0, malformed = 0;
+        };
+
         VenomBus& bus;
+        std::string iface;
+        SourceId sourceId;
         std::atomic<bool> running{false};
-        std::thread worker;
-        int bpf_obj_fd; // A betöltött eBPF program fájlleírója
-        int map_fd;     // A "fehérlista" tábla leírója
+        unsigned workerCount = 1;
+        uint32_t blockSize = DEFAULT_BLOCK_SIZE;
+        uint32_t blockCount = DEFAULT_BLOCK_COUNT;
+        CaptureMode mode = CaptureMode::TPACKET_V3;
+        int xskMapFd = -1;
+        std::vector<std::unique_ptr<Worker>> workers;
 
-        void capture_loop();
-        bool load_ebpf_program();
+        // Megbízható router MAC-ek: az ő ARP kereteik nem kerülnek null-route-ra
+        mutable std::mutex routerMutex;
+        std::vector<std::array<uint8_t, 6>> trustedRouters;
+        std::atomic<uint32_t> trustedCount{0};
+
+        bool openRing(Worker& w, int ifindex, int fanoutId);
+        void closeRing(Worker& w);
+        bool openXsk(Worker& w, int ifindex);
+        void capture_loop(Worker& w);
+        void xsk_loop(Worker& w);
+        void processBlock(Worker& w, uint8_t* block);
+        void handleFrame(const uint8_t* frame, size_t len, FrameTally& t);
+        void commitTally(Worker& w, const FrameTally& t);
+        void collectKernelStats(Worker& w);
+        bool isTrustedRouter(const uint8_t* mac) const;
 
     public:
-        explicit RawPacketProbe(VenomBus& vBus);
+        explicit RawPacketProbe(VenomBus& vBus, std::string iface = "wlo1");
         ~RawPacketProbe();
 
-        void start();
+        RawPacketProbe(const RawPacketProbe&) = delete;
+        RawPacketProbe& operator=(const RawPacketProbe&) = delete;
+
+        bool start();
         void stop();
-        
+
+        // start() előtt hívandó; n > 1 esetén PACKET_FANOUT
+        void setWorkerCount(unsigned n) { workerCount = n ? n : 1; }
+        // Ring geometria: blockSize a lapméret többszöröse
+        void setRingGeometry(uint32_t blockBytes, uint32_t blocks) { blockSize = blockBytes; blockCount = blocks; }
+        /**
+         * @brief AF_XDP mód (start() előtt): a workerek a 0..n-1 RX sorokra kötnek és
+         * bejegyzik magukat az xsks_map-be (BpfLoader::fds().xsks).
+         * Az átirányítást a BpfLoader::setXskRedirect kapcsolja be.
+         */
+        void setAfXdp(int xsksMapFd) { mode = CaptureMode::XSK; xskMapFd = xsksMapFd; }
+
         // Ez az, amit kértél: dinamikusan adhatunk hozzá routert
-        void allowRouter(const std::string& mac_addr);
+        bool allowRouter(const std::string& mac_addr);
+
+        RawCaptureStats stats() const;
     };
 }
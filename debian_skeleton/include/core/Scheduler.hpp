@@ -5,6 +5,7 @@
 #include <atomic>
 #include <memory>
 #include "rxcpp/rx.hpp"
+#include "core/WorkStealingPool.hpp"
 
 namespace Venom::Core {
 
@@ -12,17 +13,26 @@ namespace Venom::Core {
     class BpfLoader;    
     class VisualMemory; 
 
+    /**
+     * @brief A három végrehajtási tartomány egy közös work-stealing poolon, külön prioritási
+     * osztályban: cortex (HIGH) > vent (NORMAL) > null (LOW).
+     */
     class Scheduler {
     private:
+        // Elsőként deklarálva: a schedulerek és workereik után szűnik meg
+        std::unique_ptr<WorkStealingPool> pool;
+
         std::atomic<bool> running{false};
         rxcpp::composite_subscription lifetime;
 
         rxcpp::schedulers::scheduler vent_scheduler;    
         rxcpp::schedulers::scheduler cortex_scheduler;  
         rxcpp::schedulers::scheduler null_scheduler;
+        rxcpp::schedulers::worker cortex_worker;   // A tiltási döntések sora (start-tól)
 
     public:
-        Scheduler();
+        // 0 = hardware_concurrency worker
+        explicit Scheduler(unsigned workers = 0);
         ~Scheduler();
 
         // A hídhoz szükséges paraméterek: busz, loader és a memória példány
@@ -32,6 +42,7 @@ namespace Venom::Core {
         rxcpp::schedulers::scheduler getVentScheduler() const { return vent_scheduler; }
         rxcpp::schedulers::scheduler getCortexScheduler() const { return cortex_scheduler; }
         rxcpp::schedulers::scheduler getNullScheduler() const { return null_scheduler; }
+        const WorkStealingPool& getPool() const { return *pool; }
     };
 }
 
@@ -7,9 +7,14 @@
 #include <string>
 #include <atomic>
 #include <thread>
+#include <memory>
+#include <vector>
 #include <netinet/in.h>
 
 #include "core/VenomBus.hpp"
+#include "core/EntropyAccumulator.hpp"
+#include "core/EpollReactor.hpp"
+#include "core/UringReactor.hpp"
 #include "TimeCubeTypes.hpp"
 
 namespace Venom::Core {
@@ -19,6 +24,26 @@ namespace Venom::Core {
      */
     enum class LogLevel { SILENT, SECURITY_ONLY, DEBUG };
 
+    /**
+     * @brief Ingress backend: a régi egy szálas accept ciklus, az epoll reaktor,
+     * magonként egy SO_REUSEPORT listen socket saját (CPU-ra rögzített) reaktorral,
+     * vagy io_uring (multishot accept/recv). Az io_uring futásidőben epollra esik
+     * vissza, ha a kernel nem támogatja.
+     */
+    enum class IngressBackend { LEGACY_ACCEPT, EPOLL, EPOLL_REUSEPORT, IO_URING };
+
+    /**
+     * @brief Az ingress számlálók összesített pillanatképe.
+     */
+    struct IngressStats {
+        uint64_t accepted = 0;
+        uint64_t closed = 0;
+        uint64_t bytes = 0;
+        uint64_t rejected = 0;
+        uint64_t shed = 0;       // A bus NULL_ONLY állapotában azonnal lezárt kapcsolatok
+        uint32_t shards = 0;
+    };
+
     /**
      * @brief SocketProbe: Hálózati forgalom elfogása és buszra irányítása RX-szabályozással.
      */
@@ -27,12 +52,36 @@ namespace Venom::Core {
         VenomBus& bus;
         int serverFd;
         int port;
+        SourceId sourceId;
         std::atomic<bool> keepRunning;
         std::thread workerThread;
         
         LogLevel currentLogLevel;
         std::atomic<uint64_t> rxDropCounter{0};
 
+        // Kapcsolatonkénti csúszóablakos entrópia (a listenLoop újrahasznosítja)
+        EntropyAccumulator streamEntropy;
+
+        IngressBackend backend = IngressBackend::EPOLL;
+        unsigned workerCount = 0;          // 0 = hardware_concurrency
+        size_t maxConnections = 16384;
+        IngressCounters counters;
+        std::unique_ptr<EpollReactor> reactor;
+        std::unique_ptr<UringReactor> uringReactor;
+
+        // SO_REUSEPORT shard: saját listen socket, saját sáv, saját számlálók
+        struct Shard {
+            int fd = -1;
+            IngressLane lane{};
+            IngressCounters counters;
+            std::unique_ptr<EpollReactor> reactor;
+        };
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::vector<IngressLane> shardLanes; // Újraindításkor is ugyanazok a sávok
+
+        int openListener(bool reusePort);
+        bool startShards();
+        void stopShards();
         void listenLoop();
 
     public:
@@ -43,6 +92,15 @@ namespace Venom::Core {
         void stop(); // Clean Shutdown támogatás [cite: 13, 258, 268]
 
         void setLogLevel(LogLevel level) { currentLogLevel = level; }
+
+        // start() előtt hívandó
+        void setBackend(IngressBackend b) { backend = b; }
+        void setWorkerCount(unsigned n) { workerCount = n; }
+        void setMaxConnections(size_t n) { maxConnections = n; }
+
+        IngressStats stats() const;
+        // A ténylegesen futó backend (a visszaesések után)
+        IngressBackend activeBackend() const { return backend; }
     };
 }
 
@@ -0,0 +1,42 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Source interning table: "NET_SOCKET_8888" -> SourceId
+
+#ifndef VENOM_SOURCE_REGISTRY_HPP
+#define VENOM_SOURCE_REGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace Venom::Core {
+
+    using SourceId = uint16_t;
+
+    /**
+     * @brief Forrásnevek internálása kis egész azonosítóra.
+     * A regisztráció ritka (modul indításkor), ezért mutex védi; az olvasás
+     * (név visszakeresése, létező név keresése) lock-free, mert a publikált
+     * bejegyzések soha nem változnak.
+     */
+    class SourceRegistry {
+    public:
+        static constexpr SourceId MAX_SOURCES = 256;
+        static constexpr SourceId INVALID = 0xffff;
+
+        SourceId intern(std::string_view name);
+        SourceId find(std::string_view name) const;
+        std::string_view name(SourceId id) const;
+        SourceId size() const { return count.load(std::memory_order_acquire); }
+
+    private:
+        std::string names[MAX_SOURCES];
+        std::atomic<SourceId> count{0};
+        std::mutex writeMutex;
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_SOURCE_REGISTRY_HPP
@@ -6,6 +6,7 @@
 #define STREAM_PROBE_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "TimeCubeTypes.hpp" // A SecurityProfile definíció miatt
 
@@ -23,6 +24,24 @@ namespace Venom::Core {
         UNKNOWN  // Eldönthetetlen vagy sérült [cite: 19, 24]
     };
 
+    /**
+     * @brief Az egy menetben kinyert jellemzők (a busz újrahasznosítja, nem számol újra).
+     */
+    struct StreamFeatures {
+        size_t length = 0;
+        double entropy = 0.0;        // Shannon, bit/bájt
+        double controlRatio = 0.0;   // Bináris vezérlőkarakterek aránya (\n, \r, \t nélkül)
+        bool hasOpenBrace = false;   // '{'
+        bool hasCloseBrace = false;  // '}'
+        bool hasColon = false;       // ':'
+        bool utf8Valid = true;       // Szigorú UTF-8 (overlong / surrogate tiltva)
+    };
+
+    struct StreamVerdict {
+        DataType type = DataType::UNKNOWN;
+        StreamFeatures features;
+    };
+
     /**
      * @brief Könnyűsúlyú viselkedési szonda.
      * Nem végez mély elemzést (deep parsing), nem allokál nehéz objektumokat. [cite: 59]
@@ -35,13 +54,20 @@ namespace Venom::Core {
          * @param profile Az aktuális biztonsági profil (NORMAL/HIGH). [cite: 33]
          * @return A detektált DataType.
          */
-        static DataType detectZeroTrust(const std::string& data, SecurityProfile profile);
+        static DataType detectZeroTrust(std::string_view data, SecurityProfile profile);
+
+        /**
+         * @brief Fúzionált, egymenetes osztályozó.
+         * Hisztogram, vezérlőkarakter-arány, struktúra-jelek és UTF-8 validitás egyetlen
+         * bejárással; a döntés bitre azonos a detectZeroTrust korábbi többmenetes logikájával.
+         */
+        static StreamVerdict classify(std::string_view data, SecurityProfile profile);
 
         /**
          * @brief Shannon-entrópia számítás.
          * Segít felismerni a titkosított csatornákat vagy a tömörített adatokat.
          */
-        static double calculateEntropy(const std::string& data);
+        static double calculateEntropy(std::string_view data);
 
     private:
         // Belső segéd a karakterek validálásához (UTF-8/Ékezet barát)
@@ -0,0 +1,121 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Forrás IP-nkénti strike-számláló: shardolt, nyílt címzésű tábla bináris kulcsokkal
+
+#ifndef VENOM_STRIKE_TABLE_HPP
+#define VENOM_STRIKE_TABLE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "core/NetAddress.hpp"
+
+namespace Venom::Core {
+
+    struct StrikeTableStats {
+        uint64_t entries = 0;     // Foglalt slotok
+        uint64_t inserts = 0;     // Új cím került a táblába
+        uint64_t evictions = 0;   // Tele shardban a leggyengébb (lebomlott) bejegyzés helyére
+        size_t capacity = 0;      // Tárolható címek (a slotok 75%-a)
+    };
+
+    /**
+     * @brief Strike-tábla a VisualMemory alá. A kulcs a NetAddress 16 bájtja (IPv4 mapped
+     * formában), a slotok 32 bájtosak (kettő egy cache line-on), a próba a shardon belül
+     * lineáris, az első üres slotig. A shard legfeljebb 75%-ig telik, így a próbasor rövid.
+     *
+     * - Olvasás (strikes) zár nélküli: slotonkénti seqlock, íráskor újrapróbál. Egy
+     *   kilakoltatás közben a shardban az olvasó egy pillanatra 0-t láthat.
+     * - Meglévő cím strike-ja egyetlen CAS a slot állapotszaván (zár nélkül).
+     * - Új cím beszúrása / kilakoltatása a shard mutexe alatt; SHARDS shard mellett a
+     *   termelő szálak gyakorlatilag nem ütköznek.
+     * - A strike-ok felezési idővel bomlanak le (halfLife = 0: nincs bomlás). Tele shardban
+     *   az új cím helyétől számított első EVICT_CANDIDATES bejegyzés közül a legkevesebb
+     *   (lebomlott) strike-kal bíró törlődik (backward-shift törlés, sírkő nélkül).
+     */
+    class StrikeTable {
+    public:
+        // Időegység: 100 ms (32 biten ~13 év futásidő, a különbség körbeforduláskor is helyes)
+        using Tick = uint32_t;
+        static constexpr std::chrono::milliseconds TICK{100};
+
+        static constexpr size_t SHARDS = 256;
+        static constexpr size_t EVICT_CANDIDATES = 8;
+        static constexpr uint32_t MAX_STRIKES = (1u << 24) - 1;   // Telítődik, nem fordul át
+        static constexpr size_t DEFAULT_CAPACITY = size_t(3) << 16;   // 256 x 1024 slot (8 MiB)
+        static constexpr std::chrono::seconds DEFAULT_HALF_LIFE{300};
+
+        explicit StrikeTable(size_t capacity = DEFAULT_CAPACITY,
+                             std::chrono::milliseconds halfLife = DEFAULT_HALF_LIFE);
+        ~StrikeTable();
+        StrikeTable(const StrikeTable&) = delete;
+        StrikeTable& operator=(const StrikeTable&) = delete;
+
+        // +1 strike; a visszatérési érték a bomlás utáni új darabszám (0: érvénytelen cím)
+        uint32_t strike(const NetAddress& addr) { return strike(addr, now()); }
+        uint32_t strike(const NetAddress& addr, Tick at);
+
+        // Az aktuális (lebomlott) darabszám; zár nélkül, ismeretlen címre 0
+        uint32_t strikes(const NetAddress& addr) const { return strikes(addr, now()); }
+        uint32_t strikes(const NetAddress& addr, Tick at) const;
+
+        // Minden bejegyzés törlése (a shardok sorban zárolva)
+        void clear();
+
+        StrikeTableStats stats() const;
+        size_t capacity() const { return shardLimit * SHARDS; }
+
+        static Tick now();
+        static Tick ticks(std::chrono::milliseconds d) { return static_cast<Tick>(d / TICK); }
+
+    private:
+        /**
+         * @brief seq: páratlan = írás alatt (csak nő); tag: 0 = üres slot. state: [63:40]
+         * strike, [39:32] a slot generációja (áthelyezéskor / törléskor változik: a régi
+         * tartalomra szánt CAS nem sikerülhet), [31:0] a felezési periódus kezdete (Tick).
+         */
+        struct alignas(32) Slot {
+            std::atomic<uint32_t> seq{0};
+            std::atomic<uint32_t> tag{0};
+            std::atomic<uint64_t> hi{0};
+            std::atomic<uint64_t> lo{0};
+            std::atomic<uint64_t> state{0};
+        };
+
+        struct alignas(64) Shard {
+            std::mutex insertMtx;
+            std::atomic<uint64_t> entries{0};
+            std::atomic<uint64_t> inserts{0};
+            std::atomic<uint64_t> evictions{0};
+        };
+
+        struct Found {
+            Slot* slot = nullptr;
+            uint32_t seq = 0;
+            uint64_t state = 0;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        std::unique_ptr<Shard[]> shards;
+        size_t shardSlots;        // Kettő hatványa
+        size_t shardLimit;        // A shard legfeljebb ennyi címet tart (shardSlots 75%-a)
+        Tick halfLife;            // 0 = nincs bomlás
+
+        Found find(const NetAddress& addr, uint64_t h) const;
+        uint32_t insert(const NetAddress& addr, uint64_t h, Tick at);
+        // Törlés a shard zárja alatt: a mögötte ülő próbasor visszacsúszik a lyukba
+        void removeAt(size_t base, size_t index);
+        // Seqlock írás nyitása (a régi állapotot adja) / zárása; csak a shard zárja alatt
+        static uint64_t lockSlot(Slot& s);
+        static void unlockSlot(Slot& s);
+        // A bomlás alkalmazása: a periódus kezdete a lejárt felezési periódusokkal lép előre
+        uint64_t decay(uint64_t state, Tick at) const;
+        uint32_t bump(Slot& s, uint32_t seq, uint64_t cur, Tick at);
+    };
+}
+
+#endif // VENOM_STRIKE_TABLE_HPP
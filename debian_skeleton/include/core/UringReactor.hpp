@@ -0,0 +1,104 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// io_uring ingress reactor for SocketProbe (multishot accept/recv, provided buffer ring)
+
+#ifndef VENOM_URING_REACTOR_HPP
+#define VENOM_URING_REACTOR_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/EpollReactor.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief io_uring reaktor: ugyanaz a kapcsolat-modell, mint az EpollReactoré, de
+     * kapcsolatonként nincs accept4/epoll_ctl/read/close rendszerhívás.
+     * - egyetlen multishot ACCEPT workerenként, a listen socket teljes élettartamára;
+     * - kapcsolatonként egy multishot RECV, a kernel a közös pufferkészletből
+     *   (provided buffer ring) választ, a feldolgozott puffer azonnal visszakerül;
+     * - a lezárás is SQE (ASYNC_CANCEL + CLOSE), a beküldés és az aratás egy
+     *   io_uring_enter hívásban, kötegelve történik.
+     * A peer címét getpeername() adja (a multishot accept nem ad kérésenkénti címet).
+     * A liburing nem függőség: a gyűrűket közvetlenül a kernel ABI-n keresztül kezeljük.
+     */
+    class UringReactor {
+    public:
+        UringReactor(VenomBus& bus, SourceId source, int listenFd, IngressCounters& counters,
+                     const ReactorOptions& options = {});
+        ~UringReactor();
+
+        UringReactor(const UringReactor&) = delete;
+        UringReactor& operator=(const UringReactor&) = delete;
+
+        /**
+         * @brief Támogatja-e a kernel (multishot accept/recv + buffer ring, >= 6.0)?
+         * A SocketProbe ez alapján esik vissza epollra.
+         */
+        static bool supported();
+
+        bool start();
+        void stop();
+
+    private:
+        enum class ConnState : uint8_t { READING, CLOSING };
+
+        struct Connection {
+            int fd = -1;
+            uint32_t index = 0;
+            uint32_t generation = 0;     // Elavult CQE-k kiszűrése újrahasznosítás után
+            ConnState state = ConnState::READING;
+            bool recvArmed = false;
+            NetAddress peer;
+            EntropyAccumulator entropy;
+            uint64_t lastActivityMs = 0;
+            Connection* prev = nullptr;
+            Connection* next = nullptr;
+        };
+
+        struct Ring;   // SQ/CQ/buffer ring leképezések (a .cpp-ben)
+
+        struct Worker {
+            std::unique_ptr<Ring> ring;
+            std::thread thread;
+            std::vector<std::unique_ptr<Connection>> storage;
+            std::vector<Connection*> freeList;
+            Connection* active = nullptr;
+            size_t live = 0;
+            bool acceptArmed = false;
+            bool acceptBackoff = false;  // fd-hiány: rövid várakozás után élesítjük újra
+            bool wakeArmed = false;
+            Worker();
+            ~Worker();
+        };
+
+        VenomBus& bus;
+        SourceId sourceId;
+        int listenFd;
+        int wakeFd;
+        size_t maxPerWorker;
+        IngressLane lane;
+        int cpu;
+        IngressCounters& counters;
+        std::atomic<bool> running{false};
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        void run(Worker& w);
+        void armAccept(Worker& w);
+        void armRecv(Worker& w, Connection* c);
+        void armWake(Worker& w);
+        void onAccept(Worker& w, int res, uint32_t flags);
+        void onRecv(Worker& w, uint64_t userData, int res, uint32_t flags);
+        void beginClose(Worker& w, Connection* c);
+        void finishClose(Worker& w, Connection* c);
+        void sweepIdle(Worker& w, uint64_t nowMs);
+        Connection* obtain(Worker& w);
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_URING_REACTOR_HPP
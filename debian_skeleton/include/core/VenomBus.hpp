@@ -6,10 +6,20 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <initializer_list>
 #include <atomic>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
 #include "rxcpp/rx.hpp"
 
+#include "core/MpscRing.hpp"
+#include "core/NetAddress.hpp"
+#include "core/OverloadController.hpp"
+#include "core/PayloadPool.hpp"
+#include "core/SourceRegistry.hpp"
 #include "core/StreamProbe.hpp"
 #include "telemetry/BusTelemetry.hpp"
 #include "TimeCubeTypes.hpp"
@@ -18,10 +28,87 @@ namespace Venom::Core {
 
     class Scheduler;
 
+    /**
+     * @brief Az esemény keletkezési helye (modul-osztály), a forrásnévtől független.
+     */
+    enum class EventOrigin : uint8_t {
+        NETWORK,     // SocketProbe
+        RAW_PACKET,  // RawPacketProbe / kernel
+        FILESYSTEM,  // FilesystemModule
+        CORTEX,      // Scheduler / döntési visszacsatolás
+        INTERNAL     // Egyéb (kompatibilitási út)
+    };
+
+    /**
+     * @brief QoS osztály (a keletkezési helyből): osztályonként külön ingress gyűrű és
+     * kapacitás, így egy hálózati árvíz nem szoríthatja ki a gazdagép-integritási és a
+     * vezérlési eseményeket. Az index a telemetria qos_* tömbjeié is.
+     */
+    enum class QosClass : uint8_t {
+        CONTROL,         // CORTEX: a Scheduler tiltási visszacsatolása
+        HOST_INTEGRITY,  // FILESYSTEM: FS_AUDIT, FS_WATCH, FS_ERROR
+        NETWORK          // NETWORK, RAW_PACKET és a kompatibilitási út (INTERNAL)
+    };
+    constexpr size_t QOS_CLASS_COUNT = TELEMETRY_QOS_CLASSES;
+
+    constexpr QosClass qosOf(EventOrigin origin) {
+        return origin == EventOrigin::CORTEX ? QosClass::CONTROL
+             : origin == EventOrigin::FILESYSTEM ? QosClass::HOST_INTEGRITY
+             : QosClass::NETWORK;
+    }
+
+    // Header flag-ek
+    constexpr uint8_t EVENT_FLAG_NONE = 0x00;
+    constexpr uint8_t EVENT_FLAG_ARP  = 0x01; // ARP-specifikus jelző
+    constexpr uint8_t EVENT_FLAG_STREAM = 0x02; // streamEntropy érvényes (kapcsolat-szintű ablak)
+    constexpr uint8_t EVENT_FLAG_KERNEL = 0x04; // A kernel (XDP) jelentette: a keretről már döntés született
+
+    /**
+     * @brief Fix méretű, inline esemény-fejléc (nincs benne heap-mutató).
+     */
+    struct EventHeader {
+        uint64_t timestampNs = 0;   // steady_clock
+        SourceId source = SourceRegistry::INVALID;
+        EventOrigin origin = EventOrigin::INTERNAL;
+        uint8_t flags = EVENT_FLAG_NONE;
+        NetAddress peer;            // Távoli fél, ha ismert (hálózati források)
+        float streamEntropy = 0.0f; // A kapcsolat csúszóablakos entrópiája (EVENT_FLAG_STREAM)
+    };
+
+    /**
+     * @brief Kompakt esemény: fejléc + pool-blokk szelet.
+     * Másolása egy atomikus inkrement, a blokk az utolsó példánnyal tér vissza a poolba.
+     */
     struct VentEvent {
-        std::string source;
-        std::string payload;
-        bool isArp; // Új: ARP-specifikus jelző
+        EventHeader header;
+        PayloadSlice payload;
+
+        bool isArp() const { return (header.flags & EVENT_FLAG_ARP) != 0; }
+        std::string_view data() const { return payload.view(); }
+    };
+
+    /**
+     * @brief Egy drain-kör eseményei egybefüggő tömbként. Nem birtokolja őket: csak az on_next
+     * hívás idejére érvényes, a feliratkozó nem tarthatja meg (a kör végén a payloadok
+     * visszatérnek a poolba).
+     */
+    struct VentWindow {
+        const VentEvent* events = nullptr;
+        size_t count = 0;
+
+        const VentEvent* begin() const { return events; }
+        const VentEvent* end() const { return events + count; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const VentEvent& operator[](size_t i) const { return events[i]; }
+    };
+
+    /**
+     * @brief Ingress sáv azonosító. A 0. sáv a közös (alapértelmezett); a többit
+     * egy-egy shard kapja, így a magok nem ugyanazon a gyűrű-tail-en versengenek.
+     */
+    struct IngressLane {
+        uint8_t index = 0;
     };
 
     struct CortexCommand {
@@ -30,22 +117,196 @@ namespace Venom::Core {
     };
 
     class VenomBus {
+    public:
+        // A régi "queue_depth > 1000" puha korlát helyett: kemény, előre foglalt ingress gyűrű
+        static constexpr size_t VENT_RING_CAPACITY = 1024;
+        // Sávonként ennyi esemény kerül egy körben a reaktív lánc ablakába
+        static constexpr size_t DRAIN_BATCH = 256;
+        // 1 közös + shardonként egy ingress sáv
+        static constexpr size_t MAX_LANES = TELEMETRY_MAX_SHARDS + 1;
+        // Forráscím szerinti partíciók (mindegyik egy vent rx workeren, saját forrásonkénti állapottal)
+        static constexpr size_t MAX_PARTITIONS = TELEMETRY_MAX_PARTITIONS;
+        // drain szál -> partíció gyűrű; tele gyűrűnél a drain szál vár (visszanyomás az ingressre)
+        static constexpr size_t PARTITION_RING_CAPACITY = 4096;
+        // Ennyi null-route-olt esemény után kér a partíció tiltást a forrásra
+        static constexpr uint32_t SOURCE_STRIKE_LIMIT = 3;
+        // A kritikus osztályok saját ingress gyűrűi (osztályonként egy, minden producer közös)
+        static constexpr size_t CONTROL_RING_CAPACITY = 256;
+        static constexpr size_t HOST_RING_CAPACITY = 1024;
+        /**
+         * @brief Osztálykapacitás: egyszerre ennyi esemény lehet a buszon (ingress + partíció
+         * gyűrű, mind egy-egy pool-blokkot tart). A network a pool plafonjának a kritikus
+         * osztályok részén felüli maradékát kapja: a pool sem merülhet ki előttük.
+         */
+        static constexpr uint32_t QOS_CAPACITY[QOS_CLASS_COUNT] = {
+            CONTROL_RING_CAPACITY,
+            HOST_RING_CAPACITY,
+            PayloadPool::SLAB_BLOCKS * PayloadPool::MAX_SLABS - CONTROL_RING_CAPACITY - HOST_RING_CAPACITY,
+        };
+        /**
+         * @brief Súlyozott drain: egy körben osztályonként legfeljebb ennyi esemény, a kritikus
+         * osztályok elöl és külön ablakban (a hálózati ablak nem késlelteti őket). A network
+         * kvótája a sávok között forgó kezdőponttal oszlik meg, sávonként legfeljebb DRAIN_BATCH.
+         */
+        static constexpr size_t QOS_QUANTUM[QOS_CLASS_COUNT] = {64, 256, 4 * DRAIN_BATCH};
+        // N > 1: partíciónként a kritikus osztályok gyűrűje és egy drain-akció hálózati kvótája
+        static constexpr size_t PARTITION_URGENT_CAPACITY = HOST_RING_CAPACITY;
+        static constexpr size_t PARTITION_DRAIN_BATCH = 4 * DRAIN_BATCH;
+
     private:
-        rxcpp::subjects::subject<VentEvent> vent_bus;
+        using IngressRing = MpscRing<VentEvent, VENT_RING_CAPACITY>;
+        using ControlRing = MpscRing<VentEvent, CONTROL_RING_CAPACITY>;
+        using HostRing = MpscRing<VentEvent, HOST_RING_CAPACITY>;
+        struct Partition;
+
         rxcpp::subjects::subject<CortexCommand> cortex_bus;
 
         BusTelemetry telemetry;
         TimeCubeBaseline timeCubeBaseline;
 
-        mutable std::mutex ip_mutex;
-        std::string last_filtered_ip;
+        SourceRegistry sources;
+        PayloadPool payloads;
+
+        // --- Reaktív oldal: forráscím-hash szerinti partíciók, semmi nem osztott közöttük ---
+        std::unique_ptr<Partition> partitions[MAX_PARTITIONS];
+        uint32_t partitionCount = 0;
+        unsigned scoringWorkers = 0;
+        std::function<void(const NetAddress&)> on_source_block;
+
+        // --- Túlterhelés: a drain szál lépteti, a state-et a telemetria publikálja ---
+        OverloadController overload;
+        std::function<void(BusState)> on_state_change;
+
+        // --- Ingress: producer szálak -> MPSC gyűrűk (sávok) -> egyetlen drain szál -> subject ---
+        std::unique_ptr<IngressRing> lanes[MAX_LANES];
+        std::atomic<uint32_t> laneCount{1};
+        std::mutex laneMutex;
+        // Kritikus osztályok: a network sávoktól független gyűrűk
+        std::unique_ptr<ControlRing> controlRing;
+        std::unique_ptr<HostRing> hostRing;
+        std::thread drainThread;
+        std::atomic<bool> draining{false};
+        std::atomic<bool> drainParked{false};
+        std::mutex drainMutex;
+        std::condition_variable drainCv;
+
+        void drainLoop();
+        // CONTROL_INTERVAL-onként a drain szálon: mérés, állapotváltás, publikálás
+        void controlStep(uint64_t nowNs);
+        // Network osztályú esemény elhagyása a beküldéskor (DEGRADED és felette)
+        bool shedAtIngress(QosClass cls, BusState state) const;
+        // Osztálykapacitás foglalása a beküldéskor (a kritikus osztályoké pontos számláló)
+        bool reserveClass(QosClass cls);
+        void releaseClass(QosClass cls, uint32_t count);
+        bool pushToClassRing(IngressLane lane, QosClass cls, VentEvent&& ev);
+        void wakeDrain();
+        bool ingressEmpty() const;
+        // A kritikus osztályok gyűrűinek ürítése kvótáig (control, majd host-integrity)
+        template<typename Sink>
+        size_t drainCritical(Sink&& sink);
+        // Az N partíció újraépítése (csak a startReactive előtt)
+        void buildPartitions(uint32_t count);
+        uint32_t partitionOf(const NetAddress& peer) const;
+        // A drain szál -> partíció gyűrű átadás (tele gyűrűnél vár) és a drain-akció ütemezése.
+        // A kritikus osztályok a partíció urgent gyűrűjébe kerülnek, és a hálózati gyűrűre
+        // várakozás közben is továbbítódnak (pumpCritical)
+        void routeToPartition(VentEvent&& ev, bool urgent);
+        size_t pumpCritical();
+        void wakePartition(Partition& part);
+        void drainPartition(Partition& part);
+        // Egy ablak: küszöb egyszer, pontozás egy ciklusban, ítéletek egy menetben könyvelve
+        void processWindow(Partition& part, const VentWindow& window);
 
     public:
         VenomBus();
+        ~VenomBus();
+
+        VenomBus(const VenomBus&) = delete;
+        VenomBus& operator=(const VenomBus&) = delete;
         
-        // Kibővített pushEvent az ARP támogatáshoz
+        /**
+         * @brief Forrásnév internálása (modul-indításkor egyszer hívandó).
+         */
+        SourceId registerSource(std::string_view name) { return sources.intern(name); }
+        std::string_view sourceName(SourceId id) const { return sources.name(id); }
+
+        /**
+         * @brief Új, dedikált ingress sáv nyitása (shardonként egyszer). Ha elfogytak
+         * a sávok, a közös 0. sávot adja vissza.
+         */
+        IngressLane openLane();
+        // Elfogadott kapcsolat könyvelése a sáv shard-számlálóján (telemetria)
+        void noteAccept(IngressLane lane);
+        // Kernel eseménycsatorna: kiolvasott rekordok (növekmény) és a kernel elveszett-számlálója (abszolút)
+        void noteKernelEvents(uint64_t received, uint64_t lostTotal);
+
+        /**
+         * @brief Allokációmentes beküldés: a részletek közvetlenül a pool-blokkba másolódnak,
+         * így a "TYPE: " + filename jellegű összefűzés sem kér heap-et. A QoS osztály az
+         * origin-ből következik (qosOf); a lane csak a network osztályra vonatkozik.
+         */
+        void pushEvent(IngressLane lane, SourceId source, EventOrigin origin,
+                       std::initializer_list<std::string_view> parts,
+                       uint8_t flags = EVENT_FLAG_NONE, const NetAddress* peer = nullptr,
+                       float streamEntropy = 0.0f);
+        void pushEvent(IngressLane lane, SourceId source, EventOrigin origin, std::string_view payload,
+                       uint8_t flags = EVENT_FLAG_NONE, const NetAddress* peer = nullptr,
+                       float streamEntropy = 0.0f) {
+            pushEvent(lane, source, origin, {payload}, flags, peer, streamEntropy);
+        }
+        void pushEvent(SourceId source, EventOrigin origin, std::initializer_list<std::string_view> parts,
+                       uint8_t flags = EVENT_FLAG_NONE, const NetAddress* peer = nullptr,
+                       float streamEntropy = 0.0f) {
+            pushEvent(IngressLane{}, source, origin, parts, flags, peer, streamEntropy);
+        }
+        void pushEvent(SourceId source, EventOrigin origin, std::string_view payload,
+                       uint8_t flags = EVENT_FLAG_NONE, const NetAddress* peer = nullptr,
+                       float streamEntropy = 0.0f) {
+            pushEvent(IngressLane{}, source, origin, {payload}, flags, peer, streamEntropy);
+        }
+
+        // Kompatibilitási út (szöveges forrás): minden hívásnál internál, ezért a hot path kerülje
         void pushEvent(const std::string& source, const std::string& data, bool isArp = false);
+        /**
+         * @brief Nagy ablakok pontozása partíciónként ennyi segédszállal is (parallel-for;
+         * 0 = csak a partíció szála). A startReactive előtt hívandó.
+         */
+        void setScoringWorkers(unsigned workers);
+        /**
+         * @brief A reaktív oldal felosztása N partícióra a forráscím hash-e szerint (1 = a drain
+         * szál maga dolgozik). Egy forrás eseményei mindig ugyanabba a partícióba, sorrendben
+         * érkeznek; a partíció forrásonkénti állapota (strike-ok) csak a saját rx workerén él
+         * (akciói egyszerre egy szálon futnak).
+         * A startReactive és a partitionStream feliratkozások előtt hívandó.
+         */
+        void setPartitions(unsigned count);
+        unsigned getPartitionCount() const { return partitionCount; }
+        /**
+         * @brief A partíció ablakai a partíció rx workerén, sorban és egyszerre egy szálon (a
+         * feliratkozó forrásonkénti állapota így zár nélkül tartható). Az ablak csak az on_next
+         * idejére érvényes.
+         */
+        rxcpp::observable<VentWindow> partitionStream(unsigned partition) const;
+        // Forrás tiltási kérése SOURCE_STRIKE_LIMIT strike után (a partíció rx workerén hívódik)
+        void setSourceBlockCallback(std::function<void(const NetAddress&)> cb) {
+            on_source_block = std::move(cb);
+        }
+        /**
+         * @brief Túlterhelési küszöbök (a startReactive előtt hívandó). Fokozatos tehermentesítés:
+         * DEGRADED: a hálózati források mintavételezve; OVERLOAD: szigorúbb mintavétel és nincs
+         * entrópia-pontozás (csak az ARP jelző dönt); NULL_ONLY: hálózati esemény nem kerül a
+         * buszra, a SocketProbe elfogadás után azonnal zár, az XDP a LOCKDOWN korlátra vált.
+         * Az elhagyott esemény a dropped_events számlálóba kerül.
+         */
+        void setOverloadPolicy(const OverloadPolicy& policy) { overload = OverloadController(policy); }
+        // Állapotváltáskor (a drain szálon hívódik; a hívó ne blokkoljon)
+        void setStateCallback(std::function<void(BusState)> cb) { on_state_change = std::move(cb); }
+        BusState getState() const { return telemetry.state.load(std::memory_order_relaxed); }
+        // Az ingress backendek accept után kérdezik: NULL_ONLY alatt a kapcsolat azonnal zárul
+        bool admitsConnections() const { return getState() != BusState::NULL_ONLY; }
         void startReactive(rxcpp::composite_subscription& lifetime, const Scheduler& scheduler);
+        // A drain szál leállítása (a gyűrűben maradt események eldobódnak)
+        void stop();
 
         [[nodiscard]] TelemetrySnapshot getTelemetrySnapshot() const;
         [[nodiscard]] std::string getLastFilteredIP() const;
@@ -1,42 +1,50 @@
 #ifndef VISUAL_MEMORY_HPP
 #define VISUAL_MEMORY_HPP
 
-#include <vector>
 #include <string>
-#include <atomic>
 #include <cstddef>
-#include <map>
-#include <mutex>
 #include <functional> // Az callback-hez
 
+#include "core/BloomFilter.hpp"
+#include "core/NetAddress.hpp"
+#include "core/StrikeTable.hpp"
+
 namespace Venom::Core {
 
 class VisualMemory {
 private:
-    static const size_t BIT_SIZE = 1024 * 1024;
-    std::vector<std::atomic<bool>> bit_array;
+    // Gyors előszűrés: blokkos Bloom-szűrő két generációval (a törlés O(1))
+    BloomFilter wanted;
 
-    std::map<std::string, int> strike_count;
-    std::mutex strike_mutex;
+    // Forrásonkénti strike-ok: bináris kulcs, zár nélküli olvasás, felezési idős bomlás
+    StrikeTable strikes;
 
     // Callback függvény, hogy értesítsük a BpfLoadert az új tiltásról
-    std::function<void(uint32_t)> on_kernel_block_request;
-
-    size_t hash1(const std::string& key) const;
-    size_t hash2(const std::string& key) const;
+    std::function<void(const NetAddress&)> on_kernel_block_request;
 
 public:
+    // Ennyi (le nem bomlott) strike után kér a VisualMemory kernel tiltást
+    static constexpr uint32_t BLOCK_THRESHOLD = 3;
+    // Generációnként ennyi cím után forgat a szűrő; a cél hamis pozitív arány (~1.1 MiB)
+    static constexpr size_t WANTED_CAPACITY = size_t(1) << 18;
+    static constexpr double WANTED_FPR = 0.001;
+
     VisualMemory();
     ~VisualMemory() = default;
 
+    // A szöveges alak csak a régi hívóknak: a forró út a bináris címet adja (IPv4 és IPv6)
     void mark_as_wanted(const std::string& ip);
+    void mark_as_wanted(const NetAddress& addr);
     bool is_on_wanted_list(const std::string& ip) const;
+    bool is_on_wanted_list(const NetAddress& addr) const;
     
-    int get_strike_count(const std::string& ip);
+    int get_strike_count(const std::string& ip) const;
+    int get_strike_count(const NetAddress& addr) const { return static_cast<int>(strikes.strikes(addr)); }
+    StrikeTableStats strike_stats() const { return strikes.stats(); }
     void clear_memory();
 
     // Ezzel drótozzuk össze a BpfLoader-rel
-    void set_blocking_callback(std::function<void(uint32_t)> cb) {
+    void set_blocking_callback(std::function<void(const NetAddress&)> cb) {
         on_kernel_block_request = cb;
     }
 };
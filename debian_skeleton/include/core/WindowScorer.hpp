@@ -0,0 +1,73 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Ablakonkénti pontozás: egy drain-kör eseményei egyetlen szoros ciklusban, igény szerint több magon
+
+#ifndef VENOM_WINDOW_SCORER_HPP
+#define VENOM_WINDOW_SCORER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/VenomBus.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief A VenomBus ablak-pontozója. A küszöböt a hívó ablakonként egyszer számolja; itt
+     * eseményenként csak az entrópia és egy összehasonlítás fut, az ítélet egy bájttömbbe kerül.
+     *
+     * - Ha a küszöb eléri a Shannon-entrópia felső korlátját (8 bit/bájt), entrópia nem is
+     *   számolódik: csak az ARP jelző dönt (az ítélet ugyanaz, mint pontozással).
+     * - workers > 0 esetén a PARALLEL_MIN_WINDOW feletti ablakot a hívó szál és a segédszálak
+     *   szeletekre bontva pontozzák (parallel-for); a hívó megvárja az összes szeletet.
+     */
+    class WindowScorer {
+    public:
+        static constexpr double MAX_ENTROPY = 8.0;
+        // Ez alatt a segédszálak ébresztése többe kerül, mint a szeletek pontozása
+        static constexpr size_t PARALLEL_MIN_WINDOW = 1024;
+        // Szelethatár: a szomszédos szálak ítéletei ne osztozzanak cache line-on
+        static constexpr size_t SLICE_ALIGN = 64;
+
+        explicit WindowScorer(unsigned workers = 0);
+        ~WindowScorer();
+        WindowScorer(const WindowScorer&) = delete;
+        WindowScorer& operator=(const WindowScorer&) = delete;
+
+        // Ítéletek (1 = null-route) az ablak sorrendjében; a következő score hívásig érvényes
+        const uint8_t* score(const VentWindow& window, double threshold);
+
+        // Egyetlen esemény ítélete (ugyanaz a szabály, mint a score ciklusában)
+        static bool nullRoute(const VentEvent& ev, double threshold);
+
+        unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+        uint64_t parallelWindows() const { return parallelCount.load(std::memory_order_relaxed); }
+
+    private:
+        std::vector<uint8_t> verdicts;
+        std::vector<std::thread> workers;
+
+        // Az aktuális feladat: a jobEpoch léptetése (a mutex alatt) publikálja
+        const VentEvent* jobEvents = nullptr;
+        double jobThreshold = 0;
+        size_t jobSlice = 0;
+        size_t jobCount = 0;
+        unsigned jobSlices = 0;
+        uint64_t jobEpoch = 0;
+        bool stopping = false;
+        std::mutex jobMutex;
+        std::condition_variable jobCv;
+        std::atomic<unsigned> pending{0};     // Még futó segéd-szeletek
+        std::atomic<uint64_t> parallelCount{0};
+
+        void scoreRange(const VentEvent* events, size_t begin, size_t end, double threshold);
+        void workerLoop(unsigned index);
+    };
+}
+
+#endif // VENOM_WINDOW_SCORER_HPP
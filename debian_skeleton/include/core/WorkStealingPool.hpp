@@ -0,0 +1,144 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Work-stealing szálkészlet prioritási osztályokkal és rxcpp scheduler-illesztéssel
+
+#ifndef VENOM_WORK_STEALING_POOL_HPP
+#define VENOM_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "rxcpp/rx.hpp"
+#include "core/ChaseLevDeque.hpp"
+
+namespace Venom::Core {
+
+    /**
+     * @brief Rögzített méretű szálkészlet, workerenként és prioritási osztályonként egy
+     * Chase-Lev deque-val.
+     *
+     * - Workerről beküldött feladat a saját deque-ba kerül (zár nélkül, cache-meleg); külső
+     *   szálról a prioritási osztály injekciós sorába.
+     * - A worker osztályonként sorban keres: saját deque -> injekciós sor -> lopás a többi
+     *   workertől. Minden STARVATION_GUARD-adik keresés fordított sorrendben indul, így a LOW
+     *   osztály tartós HIGH terhelés mellett sem éhezik ki.
+     * - A tétlen worker rövid pörgés után parkol; a beküldő csak akkor ébreszt (mutex +
+     *   notify), ha van parkoló worker.
+     * - scheduler(prio): rxcpp scheduler; minden rx worker egy "strand", az akciói sorban,
+     *   soha nem párhuzamosan futnak (az rx szerződés szerint), de bármelyik szálon.
+     */
+    class WorkStealingPool {
+    public:
+        enum class Priority : uint8_t {
+            HIGH = 0,     // cortex: döntések, tiltások
+            NORMAL = 1,   // vent: reaktív partíciók
+            LOW = 2       // null: elnyelés, háttérmunka
+        };
+        static constexpr size_t PRIORITY_CLASSES = 3;
+        static constexpr int IDLE_SPINS = 64;
+        static constexpr uint32_t STARVATION_GUARD = 32;
+        // Egy strand ennyi akciót futtat egy feladatként, utána újra beküldi magát
+        static constexpr unsigned STRAND_BATCH = 64;
+
+        /**
+         * @brief Egy feladat: a run() után a pool nem nyúl hozzá (a feladat maga kezeli az
+         * élettartamát, pl. egy strand a saját shared_ptr-ét tartja, amíg sorban áll).
+         */
+        class Task {
+        public:
+            virtual void run() = 0;
+
+        protected:
+            ~Task() = default;
+        };
+
+        struct Stats {
+            uint64_t executed = 0;
+            uint64_t stolen = 0;
+            uint64_t injected = 0;
+            uint64_t parks = 0;
+        };
+
+        // 0 = hardware_concurrency
+        explicit WorkStealingPool(unsigned workers = 0);
+        // A már beküldött feladatok lefutnak, utána állnak le a workerek
+        ~WorkStealingPool();
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(Task* task, Priority prio);
+        // Időzített beküldés (a pool időzítő szála adja át a when pillanatban)
+        void submitAt(Task* task, Priority prio, std::chrono::steady_clock::time_point when);
+
+        rxcpp::schedulers::scheduler scheduler(Priority prio);
+
+        unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+        Stats stats() const;
+
+    private:
+        struct Worker {
+            WorkStealingPool* pool = nullptr;
+            unsigned index = 0;
+            ChaseLevDeque<Task*> deques[PRIORITY_CLASSES];
+            uint32_t rng = 0;
+            uint32_t lookups = 0;
+            std::thread thread;
+            alignas(VENOM_CACHE_LINE) std::atomic<uint64_t> executed{0};
+            std::atomic<uint64_t> stolen{0};
+            std::atomic<uint64_t> parks{0};
+        };
+
+        struct Injection {
+            std::mutex mutex;
+            std::deque<Task*> tasks;
+            alignas(VENOM_CACHE_LINE) std::atomic<size_t> size{0};
+        };
+
+        struct Timed {
+            std::chrono::steady_clock::time_point when;
+            uint64_t seq;
+            Task* task;
+            Priority prio;
+            bool operator>(const Timed& o) const { return when != o.when ? when > o.when : seq > o.seq; }
+        };
+
+        // A hívó szál workere (nullptr, ha nem pool-szál)
+        static thread_local Worker* current;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        Injection injection[PRIORITY_CLASSES];
+        std::atomic<uint64_t> injectedCount{0};
+
+        std::atomic<bool> stopping{false};
+        alignas(VENOM_CACHE_LINE) std::atomic<int> sleepers{0};
+        std::mutex parkMutex;
+        std::condition_variable parkCv;
+
+        // Időzítő: lustán indul az első submitAt-nél
+        std::mutex timerMutex;
+        std::condition_variable timerCv;
+        std::priority_queue<Timed, std::vector<Timed>, std::greater<Timed>> timers;
+        uint64_t timerSeq = 0;
+        bool timerStopping = false;
+        std::thread timerThread;
+
+        void workerLoop(Worker& w);
+        void timerLoop();
+        Task* findTask(Worker& w);
+        Task* findInClass(Worker& w, size_t cls);
+        bool hasWork() const;
+        void wakeOne();
+    };
+}
+
+#endif // VENOM_WORK_STEALING_POOL_HPP
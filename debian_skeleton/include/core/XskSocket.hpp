@@ -0,0 +1,95 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// AF_XDP socket + UMEM (RX only) for the RawPacketProbe deep-inspection path
+
+#ifndef VENOM_XSK_SOCKET_HPP
+#define VENOM_XSK_SOCKET_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Venom::Core {
+
+    /**
+     * @brief Egy átvett keret a UMEM-ben. A data a UMEM-be mutat (nincs másolás);
+     * a release() hívásig érvényes.
+     */
+    struct XskFrame {
+        const uint8_t* data = nullptr;
+        uint32_t len = 0;
+        uint64_t addr = 0;
+    };
+
+    // A kernel XDP_STATISTICS számlálói (kumulatívak, az olvasás nem nulláz)
+    struct XskKernelStats {
+        uint64_t rxDropped = 0;        // Nem fért a ringbe / UMEM-be
+        uint64_t rxInvalidDescs = 0;
+        uint64_t rxRingFull = 0;       // Az RX ring tele volt
+        uint64_t fillRingEmpty = 0;    // A kernel nem talált szabad UMEM keretet
+    };
+
+    /**
+     * @brief AF_XDP socket egy (interfész, RX sor) párra, saját UMEM-mel.
+     * Az XDP program (xsks_map) ide irányítja a kiválasztott kereteket; a fogyasztó
+     * a UMEM-ben helyben olvassa őket, majd a kereteket a fill ringen visszaadja.
+     * Először XDP_ZEROCOPY kötéssel próbálkozik, ha a meghajtó nem tudja (veth,
+     * generic XDP), XDP_COPY-ra esik vissza: ilyenkor a kernel másol a UMEM-be,
+     * a felhasználói oldal továbbra is másolásmentes.
+     * Nem szálbiztos: egy socketet egy worker használ.
+     */
+    class XskSocket {
+    public:
+        static constexpr uint32_t FRAME_SIZE = 2048;
+        static constexpr uint32_t FRAME_COUNT = 4096;   // 8 MiB UMEM
+        static constexpr uint32_t FILL_RING_SIZE = FRAME_COUNT;  // Minden keret elfér benne
+        static constexpr uint32_t RX_RING_SIZE = 2048;
+        static constexpr uint32_t COMPLETION_RING_SIZE = 64;     // RX-only: a kötéshez kell
+
+        XskSocket();
+        ~XskSocket();
+
+        XskSocket(const XskSocket&) = delete;
+        XskSocket& operator=(const XskSocket&) = delete;
+
+        bool open(int ifindex, uint32_t queue);
+        void close();
+
+        int fd() const { return sock; }
+        bool zeroCopy() const { return zeroCopyBound; }
+
+        /**
+         * @brief Legfeljebb max keret átvétele az RX ringről (rendszerhívás nélkül).
+         * A kereteket release()-szel kell visszaadni, a következő receive() előtt.
+         */
+        size_t receive(XskFrame* out, size_t max);
+        void release(const XskFrame* frames, size_t count);
+
+        XskKernelStats kernelStats() const;
+
+    private:
+        struct Ring {
+            uint32_t* producer = nullptr;
+            uint32_t* consumer = nullptr;
+            uint32_t* flags = nullptr;
+            void* descs = nullptr;
+            void* map = nullptr;
+            size_t mapLen = 0;
+            uint32_t mask = 0;
+        };
+
+        int sock = -1;
+        uint8_t* umem = nullptr;
+        size_t umemLen = 0;
+        bool zeroCopyBound = false;
+        Ring fill;
+        Ring completion;
+        Ring rx;
+
+        bool mapRing(Ring& ring, uint64_t pgoff, size_t descSize, uint32_t entries,
+                     uint64_t producerOff, uint64_t consumerOff, uint64_t descOff, uint64_t flagsOff);
+        void unmapRing(Ring& ring);
+    };
+
+} // namespace Venom::Core
+
+#endif // VENOM_XSK_SOCKET_HPP
@@ -0,0 +1,106 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+// Kötegelt host-tiltás: a függő IP-k összevonva, bpf_map_update_batch / delete_batch hívással
+
+#ifndef VENOM_BLOCK_QUEUE_HPP
+#define VENOM_BLOCK_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "core/NetAddress.hpp"
+
+namespace Venom::Core {
+
+    struct BlockQueueStats {
+        uint64_t queued = 0;      // block() / unblock() hívások
+        uint64_t coalesced = 0;   // Ugyanarra a címre a flush előtt (csak a legutolsó művelet marad)
+        uint64_t applied = 0;     // A mapbe írt / onnan törölt bejegyzések
+        uint64_t failed = 0;      // Sikertelen bejegyzések (a nem létező törlése nem hiba)
+        uint64_t syscalls = 0;    // bpf() hívások (batch és a régi kernelen egyenkénti)
+        uint64_t flushes = 0;
+    };
+
+    /**
+     * @brief Tiltási sor a blacklist_map / blacklist6_map elé. A block()/unblock() csak
+     * bejegyez (mutex + hash, syscall nélkül); a flusher szál az első függő bejegyzés után
+     * legfeljebb `deadline` idővel, vagy MAX_BATCH bejegyzésnél azonnal ír, családonként és
+     * műveletenként egy bpf_map_*_batch hívással. Botnet-hullámnál (10k IP) így a 10k
+     * egyenkénti update helyett néhány syscall. Batch nélküli kernelen (< 5.6) egyenkénti
+     * update/delete a tartalék.
+     */
+    class BlockQueue {
+    public:
+        static constexpr size_t MAX_BATCH = 8192;
+        static constexpr std::chrono::milliseconds DEFAULT_DEADLINE{5};
+
+        BlockQueue() = default;
+        ~BlockQueue();
+        BlockQueue(const BlockQueue&) = delete;
+        BlockQueue& operator=(const BlockQueue&) = delete;
+
+        // A map FD-ket a hívó birtokolja; -1 = az adott család nem támogatott
+        bool start(int v4Fd, int v6Fd, std::chrono::milliseconds deadline = DEFAULT_DEADLINE);
+        // A függő bejegyzések kiírása, majd a szál leállítása
+        void stop();
+
+        bool block(const NetAddress& addr) { return enqueue(addr, true); }
+        bool unblock(const NetAddress& addr) { return enqueue(addr, false); }
+
+        // Azonnali kiírás a hívó szálán (pl. leállás vagy mérés előtt)
+        void flush();
+
+        size_t pending() const;
+        BlockQueueStats stats() const;
+        bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    private:
+        struct AddressHash {
+            size_t operator()(const NetAddress& a) const {
+                uint64_t lo, hi;
+                std::memcpy(&lo, a.bytes, 8);
+                std::memcpy(&hi, a.bytes + 8, 8);
+                return std::hash<uint64_t>{}(lo ^ (hi * 0x9e3779b97f4a7c15ULL));
+            }
+        };
+        // cím -> true = tiltás, false = feloldás (a legutolsó művelet nyer)
+        using Pending = std::unordered_map<NetAddress, bool, AddressHash>;
+
+        bool enqueue(const NetAddress& addr, bool block);
+        void flusherLoop();
+        void apply(const Pending& batch);
+
+        // A stop() a join után nullázza, az enqueue() zár nélkül olvassa (cortex / fő szál)
+        std::atomic<int> v4Fd{-1};
+        std::atomic<int> v6Fd{-1};
+        std::chrono::milliseconds deadline = DEFAULT_DEADLINE;
+
+        mutable std::mutex mtx;        // pending + due
+        std::condition_variable cv;
+        Pending pending_;
+        std::chrono::steady_clock::time_point due{};
+
+        // A kiírások sorrendje: a csere és az alkalmazás egy kritikus szakasz,
+        // így egy későbbi feloldás nem előzheti meg a korábbi tiltást
+        std::mutex applyMtx;
+
+        std::thread flusher;
+        std::atomic<bool> running{false};
+
+        std::atomic<uint64_t> queued{0};
+        std::atomic<uint64_t> coalesced{0};
+        std::atomic<uint64_t> applied{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> syscalls{0};
+        std::atomic<uint64_t> flushes{0};
+    };
+}
+
+#endif // VENOM_BLOCK_QUEUE_HPP
@@ -6,43 +6,248 @@
 
 #include <string>
 #include <atomic>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <cstdint>
 
-// Forward declaration a libbpf-nek
+#include "core/ebpf/BlockQueue.hpp"
+#include "telemetry/TelemetryTypes.hpp"
+
+// Forward declaration a libbpf-nek és a bpftool által generált skeletonnak
 struct bpf_object;
-struct bpf_link;
+struct venom_shield;
 
 namespace Venom::Core {
 
+    class VenomBus;
+
+    /**
+     * @brief A stats_map CPU-nként vezetett számlálóinak összege (VENOM_STAT_* slotok).
+     */
     struct BpfStats {
-        uint64_t dropped_packets;
+        // Verdiktek: dropped + passed + redirected = inspected + túl rövid keretek
+        uint64_t inspected_packets = 0;
+        uint64_t dropped_packets = 0;
+        uint64_t passed_packets = 0;
+        uint64_t redirected_packets = 0;   // AF_XDP socketre átirányítva
+        uint64_t events_lost = 0;          // events_rb tele volt (kernel oldali számláló)
+
+        // Protokollonként
+        uint64_t arp_packets = 0;
+        uint64_t ipv4_packets = 0;
+        uint64_t ipv6_packets = 0;
+        uint64_t other_packets = 0;
+
+        // Döntési okonként (VENOM_REASON_*)
+        uint64_t blacklist_drops = 0;      // Egyedi host (blacklist_map)
+        uint64_t cidr_drops = 0;           // Tiltott prefix (cidr_blacklist_map)
+        uint64_t untrusted_arp = 0;
+        uint64_t router_arp = 0;
+        uint64_t fragments = 0;
+        uint64_t watched = 0;
+        uint64_t untrusted_ra = 0;         // ICMPv6 Router Advertisement idegen MAC-ről
+        uint64_t rate_limited = 0;         // Forrásonkénti token bucket (rate_map) dobta
+        uint64_t sampled = 0;
+    };
+
+    /**
+     * @brief A stats_map (PERCPU_ARRAY) összes slotjának kiolvasása egyetlen
+     * bpf_map_lookup_batch hívással és CPU-nkénti összegzése. Régi kernelen
+     * (batch nélkül) slotonkénti lookup. Sikertelen olvasásnál false.
+     */
+    bool readStatsMap(int mapFd, BpfStats& out);
+
+    /**
+     * @brief Kernel eseménycsatorna mintavétele: "minden N-edik" rekord fajtánként.
+     * 0 = kikapcsolva, 1 = minden rekord. A DROP rekordok a buszra forrás IP-nként
+     * összevonva kerülnek, így ott az 1 is olcsó.
+     */
+    struct EventSampling {
+        uint32_t dropEvery = 1;
+        uint32_t suspectEvery = 1;
+        uint32_t sampleEvery = 0;
     };
 
+    struct EventChannelStats {
+        uint64_t received = 0;    // Kiolvasott rekordok
+        uint64_t drops = 0;
+        uint64_t suspects = 0;
+        uint64_t samples = 0;
+        uint64_t busEvents = 0;   // A buszra küldött események (összevonás után)
+        uint64_t lost = 0;        // Kernel oldalon elveszett (tele ring)
+    };
+
+    /**
+     * @brief Forrásonkénti sebességkorlát az XDP-ben (Hydra L1 "IP-Fojtó"): packetsPerSec
+     * a tartós ütem, burst a vödör mérete csomagban. 0 pps = kikapcsolva.
+     */
+    struct RateLimit {
+        uint32_t packetsPerSec = 0;
+        uint32_t burst = 0;
+
+        // NORMAL: csak a valódi árvíz; HIGH: szigorúbb; LOCKDOWN: a Hydra terv 100 pkt/s-e
+        static RateLimit forProfile(SecurityProfile profile) {
+            switch (profile) {
+                case SecurityProfile::HIGH:     return {2000, 4000};
+                case SecurityProfile::LOCKDOWN: return {100, 200};
+                case SecurityProfile::NORMAL:
+                default:                        return {20000, 40000};
+            }
+        }
+
+        // A bus NULL_ONLY állapotában a profiltól függetlenül a LOCKDOWN korlát: a tehermentesítés
+        // a kernelben kezdődik, a felhasználói térbe el sem jut a csomag
+        static RateLimit forState(SecurityProfile profile, BusState state) {
+            return forProfile(state == BusState::NULL_ONLY ? SecurityProfile::LOCKDOWN : profile);
+        }
+    };
+
+    /**
+     * @brief XDP csatolási mód. GENERIC (SKB mode) minden eszközön működik
+     * (veth, teszt netns), NATIVE a meghajtó saját XDP útja.
+     */
+    enum class XdpAttachMode { NATIVE, GENERIC };
+
+    /**
+     * @brief XDP program csatolása bpf_link-kel. pinPath megadásával a link bpffs-re pinelődik
+     * és túléli a folyamatot; ha ott már él egy link, a program benne atomikusan cserélődik
+     * (bpf_link_update), így a csatolás egy pillanatra sem szűnik meg. Elárvult pin (pl. az
+     * interfész újra létrejött) helyett friss link. reused = a meglévő link cseréje történt.
+     * @return A link leírója, vagy -1.
+     */
+    int attachXdpLink(int progFd, int ifindex, XdpAttachMode mode,
+                      const std::string& pinPath = {}, bool* reused = nullptr);
+
     // A venom_ebpf_common.h-val szinkronizált struktúra
     struct router_identity {
         unsigned char mac[6];
         uint32_t trust_level;
     };
 
+    /**
+     * @brief A venom_shield objektum mapjeinek és programjának leírói, a deploy() egyszer
+     * oldja fel őket (skeletonnal a skel->maps / skel->progs mezőiből, név szerinti keresés
+     * nélkül). -1 = nincs betöltve.
+     */
+    struct ShieldFds {
+        int blacklist = -1;         // blacklist_map
+        int blacklist6 = -1;        // blacklist6_map
+        int cidr = -1;              // cidr_blacklist_map
+        int cidr6 = -1;             // cidr6_blacklist_map
+        int routerIdentity = -1;    // router_identity_map
+        int watch = -1;             // watch_map
+        int xsks = -1;              // xsks_map
+        int xskConfig = -1;         // xsk_config_map
+        int eventConfig = -1;       // event_config_map
+        int events = -1;            // events_rb
+        int stats = -1;             // stats_map
+        int rate = -1;              // rate_map
+        int rateConfig = -1;        // rate_config_map
+        int guardProg = -1;         // venom_router_guard (SEC("xdp"))
+    };
+
     class BpfLoader {
     private:
         struct bpf_object* obj;
-        struct bpf_link* link;
+        struct venom_shield* skel = nullptr;   // Beágyazott objektumnál; az obj ennek a része
+        int linkFd;               // Az XDP bpf_link (pinelt módban a bpffs is tartja)
         std::atomic<bool> attached;
 
+        // Meleg újraindítás: a tanult állapot (tiltólisták, vödrök, identitás) és a link a pinRoot alatt
+        std::string pinRoot;
+        bool warm = false;        // A deploy a pinelt (korábbi, kompatibilis) blacklist_map-et vette át
+
+        ShieldFds maps;
+
+        // Kötegelt host-tiltás (blacklist_map / blacklist6_map)
+        BlockQueue blockQueue;
+
+        // events_rb fogyasztó (a ring_buffer és az összevonó állapot a .cpp-ben)
+        struct EventChannel;
+        std::unique_ptr<EventChannel> events;
+        std::thread eventThread;
+        std::atomic<bool> eventsRunning{false};
+
+        void eventLoop();
+        void resolveMaps();
+        bool openObject(const std::string& objPath);
+        bool loadObject(const std::string& objPath);
+        void closeObject();
+        void unpinMaps();
+
     public:
+        static constexpr const char* DEFAULT_PIN_ROOT = "/sys/fs/bpf/white-venom";
+
         explicit BpfLoader();
         ~BpfLoader();
 
-        bool deploy(const std::string& objPath, const std::string& iface);
+        // Pinelt mód a deploy() előtt ("" = kikapcsolva). false, ha a könyvtár nem hozható
+        // létre (pl. nincs bpffs csatolva): ilyenkor a betöltés a régi, pin nélküli út.
+        bool setPinRoot(const std::string& dir);
+        // A bináris a generált skeletonnal (venom_shield.skel.h) épült: az objektum beágyazva
+        static bool hasEmbeddedObject();
+        // Pinelt módban a meglévő, kompatibilis mapeket veszi át (az eltérő definíciójút mapenként
+        // újra létrehozza), a programot a futó linkben cseréli; a sebességkorlát az alapprofilra áll.
+        // Üres objPath = a beágyazott objektum (lásd deployEmbedded)
+        bool deploy(const std::string& objPath, const std::string& iface,
+                    XdpAttachMode mode = XdpAttachMode::NATIVE);
+        // A binárisba fordított objektum betöltése (nincs futásidejű fájlútvonal); skeleton nélkül false
+        bool deployEmbedded(const std::string& iface, XdpAttachMode mode = XdpAttachMode::NATIVE) {
+            return deploy({}, iface, mode);
+        }
+        // Pin nélkül lecsatol; pinelt módban a program csatolva és a tanult állapot megmarad,
+        // a sebességkorlát az alapprofilra (NORMAL) áll vissza
         void detach();
+        // Teljes leszerelés: detach, majd a link és a mapek pinjeinek törlése
+        bool removePinned(const std::string& iface);
+        // Az előző példány állapota (tiltólisták, router-identitás) átvéve
+        bool isWarmStart() const { return warm; }
+        bool hasRouterIdentity();
         
         // Injekció-mentes MAC beállítás (SafeExecutor logika)
         bool setRouterMAC(const std::string& mac_str);
         
+        // Host tiltása (IPv4 vagy IPv6; LRU tábla, a legrégebbi bejegyzés öregszik ki)
         bool blockIP(const std::string& ip_str);
+        // Prefix tiltása: "a.b.c.d/len" vagy "2001:db8::/32" (a host-bitek nullázódnak);
+        // a sima cím teljes hosszú prefix
+        bool blockCIDR(const std::string& cidr_str);
+        // Tiltás feloldása: "cím/len" a prefixet, a sima cím a hostot és a teljes hosszú prefixet
+        bool unblock(const std::string& str);
+
+        // --- Forrásonkénti sebességkorlát (rate_map / rate_config_map) ---
+        // Futás közben állítható; a már létező vödrök az új árral folytatják
+        bool setRateLimit(const RateLimit& limit);
+        bool applyProfile(SecurityProfile profile, BusState state = BusState::UP) {
+            return setRateLimit(RateLimit::forState(profile, state));
+        }
+
+        // --- Kötegelt tiltás (automatikus válaszokhoz, pl. botnet-hullám) ---
+        // Csak bejegyez: a kiírás rövid határidőn belül, bpf_map_update_batch hívással
+        bool queueBlock(const NetAddress& addr) { return blockQueue.block(addr); }
+        bool queueUnblock(const NetAddress& addr) { return blockQueue.unblock(addr); }
+        void flushBlocks() { blockQueue.flush(); }
+        BlockQueueStats blockQueueStats() const { return blockQueue.stats(); }
+
+        // --- AF_XDP mély vizsgálat (xsks_map / xsk_config_map / watch_map) ---
+        // Átirányítási maszk: VENOM_XSK_REDIRECT_* (0 = kikapcsolva)
+        bool setXskRedirect(uint32_t mask);
+        // Forrás IP megfigyelése: az XDP a csomagjait az AF_XDP socketre küldi
+        bool watchIP(const std::string& ip_str);
+
+        // --- Kernel eseménycsatorna (events_rb, BPF_MAP_TYPE_RINGBUF) ---
+        bool setEventSampling(const EventSampling& sampling);
+        // Fogyasztó szál indítása: a rekordok pollonként kötegelve kerülnek a buszra
+        bool startEventChannel(VenomBus& bus, const EventSampling& sampling = {});
+        void stopEventChannel();
+        EventChannelStats eventStats() const;
+
+        // Típusos hozzáférés a mapekhez és a programhoz (pl. BPF_PROG_TEST_RUN mérésekhez)
+        const ShieldFds& fds() const { return maps; }
+        // Név szerinti keresés (az objektumban; a fds() mezői a deploy óta ugyanezek)
         int get_map_fd(const std::string& map_name);
+        int get_prog_fd(const std::string& prog_name);
         BpfStats getStats();
         
         bool isActive() const { return attached.load(); }
@@ -5,7 +5,127 @@
 
 struct router_identity {
     unsigned char mac[6];
-    __u32 trust_level; 
+    __u32 trust_level;
+};
+
+// stats_map (BPF_MAP_TYPE_PERCPU_ARRAY) slotjai. Minden CPU a saját példányát
+// növeli (nincs atomikus művelet, nincs cache-line pattogás); a BpfLoader egyetlen
+// batch olvasással kéri le és összegzi őket.
+#define VENOM_STAT_INSPECTED   0   // Minden vizsgált keret (érvényes Ethernet fejléc)
+#define VENOM_STAT_DROPPED     1   // XDP_DROP
+#define VENOM_STAT_REDIRECTED  2   // AF_XDP socketre átirányítva (xsks_map)
+#define VENOM_STAT_EVENTS_LOST 3   // events_rb tele: a rekord elveszett
+#define VENOM_STAT_PASSED      4   // XDP_PASS
+#define VENOM_STAT_PROTO_ARP   5
+#define VENOM_STAT_PROTO_IPV4  6
+#define VENOM_STAT_PROTO_IPV6  7
+#define VENOM_STAT_PROTO_OTHER 8
+#define VENOM_STAT_REASON_BASE 9   // + VENOM_REASON_* (1..9) = 10..18: döntési okok
+#define VENOM_STAT_SLOTS       24
+
+// Tiltólisták: egyedi (auto-blokkolt) hostok LRU hash-ben, így a régi bejegyzések
+// kiöregednek és a beszúrás nem bukik el; teljes alhálózatok LPM trie-ban.
+#define VENOM_BLACKLIST_MAX       65536
+#define VENOM_CIDR_MAX            131072
+#define VENOM_BLACKLIST6_MAX      65536
+#define VENOM_CIDR6_MAX           65536
+
+// cidr_blacklist_map kulcsa (az LPM trie a prefixlen utáni bájtokat hasonlítja)
+struct venom_lpm_v4 {
+    __u32 prefixlen;                // 0..32
+    __u32 addr;                     // hálózati bájtsorrend
+};
+
+// blacklist6_map kulcsa: a nyers 128 bites forrás cím
+struct venom_in6 {
+    __u8 addr[16];
+};
+
+// cidr6_blacklist_map kulcsa
+struct venom_lpm_v6 {
+    __u32 prefixlen;                // 0..128
+    __u8  addr[16];
+};
+
+// --- Forrásonkénti sebességkorlát (token bucket a kernelben) ---
+// rate_map: BPF_MAP_TYPE_LRU_PERCPU_HASH, kulcs a venom_in6 (IPv4 IPv4-mapped formában).
+// CPU-nként külön vödör: az RSS egy forrás folyamait egy sorra / CPU-ra viszi, így nincs
+// atomikus művelet; több sorra szórt forrásnál a keret legfeljebb CPU-szorosa érvényes.
+#define VENOM_RATE_MAX            65536
+
+// rate_config_map (0. kulcs). Egy csomag ára cost_ns nanoszekundum kredit; a kredit az
+// eltelt idővel nő, legfeljebb burst_ns-ig. A BpfLoader számolja (1e9 / pps, burst * cost),
+// így az XDP-ben nincs osztás. cost_ns = 0: kikapcsolva.
+struct venom_rate_config {
+    __u64 cost_ns;
+    __u64 burst_ns;
+};
+
+struct venom_rate_bucket {
+    __u64 credit_ns;
+    __u64 last_ns;                  // bpf_ktime_get_ns az utolsó csomagnál
+};
+
+// Ennyi IPv6 kiterjesztett fejlécet lép át az XDP (a láncot a támadó építi;
+// a PacketParser::MAX_IPV6_EXT_HEADERS-szel azonos)
+#define VENOM_IPV6_MAX_EXT_HDRS   6
+
+// xsk_config_map (0. kulcs) bitmaszkja: mely keretek menjenek mély vizsgálatra
+// a user-space AF_XDP fogyasztóhoz. 0 = kikapcsolva (minden a régi úton).
+#define VENOM_XSK_REDIRECT_ARP    0x1   // ARP, kivéve a router_identity_map routerét
+#define VENOM_XSK_REDIRECT_FRAG   0x2   // IPv4 fragmensek / IPv6 Fragment fejléc
+#define VENOM_XSK_REDIRECT_WATCH  0x4   // watch_map-ben szereplő forrás IP-k
+#define VENOM_XSK_REDIRECT_RA     0x8   // ICMPv6 Router Advertisement idegen MAC-ről
+
+#define VENOM_XSK_MAX_QUEUES      64
+
+// --- events_rb: kernel -> user-space rekordok (BPF_MAP_TYPE_RINGBUF) ---
+#define VENOM_EVENTS_RB_BYTES     (256 * 1024)
+#define VENOM_EVT_HEAD_LEN        64    // A keret eleje (minták/gyanús keretek)
+
+#define VENOM_EVT_DROP            1     // XDP_DROP (feketelista)
+#define VENOM_EVT_SUSPECT         2     // Gyanús keret (az xsk átirányítás feltételei)
+#define VENOM_EVT_SAMPLE          3     // Véletlen minta az átengedett IP forgalomból
+
+#define VENOM_REASON_BLACKLIST    1
+#define VENOM_REASON_ARP_UNTRUSTED 2
+#define VENOM_REASON_FRAGMENT     3
+#define VENOM_REASON_WATCHED      4
+#define VENOM_REASON_RANDOM       5
+#define VENOM_REASON_ROUTER_ARP   6     // A megbízható router ARP-ja (csak statisztika)
+#define VENOM_REASON_CIDR         7     // XDP_DROP: tiltott prefix (cidr_blacklist_map / cidr6)
+#define VENOM_REASON_RA_UNTRUSTED 8     // ICMPv6 RA nem a router MAC-jéről
+#define VENOM_REASON_RATE_LIMIT   9     // XDP_DROP: a forrás túllépte a rate_config_map keretét
+#define VENOM_REASON_LAST         VENOM_REASON_RATE_LIMIT
+
+// Az okok slotjai nem fedhetik a protokoll-számlálókat, és mind a stats_map-be esnek
+#ifdef __cplusplus
+#define VENOM_STATIC_ASSERT(cond, msg) static_assert(cond, msg)
+#else
+#define VENOM_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
+#endif
+VENOM_STATIC_ASSERT(VENOM_STAT_REASON_BASE > VENOM_STAT_PROTO_OTHER, "reason slots overlap the protocol counters");
+VENOM_STATIC_ASSERT(VENOM_STAT_REASON_BASE + VENOM_REASON_LAST < VENOM_STAT_SLOTS, "reason slots exceed VENOM_STAT_SLOTS");
+
+struct venom_event {
+    __u64 ts_ns;                    // bpf_ktime_get_ns (CLOCK_MONOTONIC)
+    __u32 saddr;                    // IPv4 forrás / ARP küldő (hálózati bájtsorrend), IPv6-nál 0
+    __u16 eth_proto;                // hálózati bájtsorrend
+    __u8  kind;                     // VENOM_EVT_*
+    __u8  reason;                   // VENOM_REASON_*
+    __u16 pkt_len;
+    __u16 head_len;                 // head[] érvényes bájtjai (DROP-nál 0)
+    __u32 rx_queue;
+    __u8  head[VENOM_EVT_HEAD_LEN];
+    __u8  saddr6[16];               // IPv6 forrás (eth_proto == ETH_P_IPV6), egyébként 0
+};
+
+// event_config_map (0. kulcs): "minden N-edik" mintavétel fajtánként, 0 = kikapcsolva.
+// Árvíznél így a ring nem telik meg; a kimaradt rekordok nem számítanak elveszettnek.
+struct venom_event_config {
+    __u32 drop_every;
+    __u32 suspect_every;
+    __u32 sample_every;
 };
 
 #endif
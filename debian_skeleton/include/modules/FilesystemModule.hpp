@@ -39,6 +39,11 @@ namespace Venom::Modules {
         Venom::Core::VenomBus& bus; // Referencia a központi idegrendszerre
         std::vector<FilesystemPathPolicy> policies;
 
+        // Internált forrás-azonosítók (egyszer regisztrálva)
+        Venom::Core::SourceId auditSource;
+        Venom::Core::SourceId watchSource;
+        Venom::Core::SourceId errorSource;
+
         // Inotify változók
         int inotifyFd;
         std::atomic<bool> keepMonitoring;
@@ -18,6 +18,36 @@ namespace Venom::Core {
         std::atomic<BusState> state{BusState::UP};
         std::atomic<SecurityProfile> current_profile{SecurityProfile::NORMAL};
 
+        // Túlterhelés-vezérlés: a partíciók az ablak-késleltetés maximumát írják (a vezérlő
+        // intervallumonként nullázza), a többit a drain szál publikálja
+        std::atomic<uint64_t> window_sojourn_ns{0};
+        std::atomic<uint64_t> overload_delay_us{0};
+        std::atomic<uint64_t> drain_rate{0};
+        std::atomic<uint64_t> state_transitions{0};
+
+        // Shardonkénti accept számlálók: külön cache-sorban, hogy a magok ne versengjenek
+        struct alignas(64) ShardCounter {
+            std::atomic<uint64_t> accepts{0};
+        };
+        ShardCounter shard_accepts[TELEMETRY_MAX_SHARDS];
+        std::atomic<uint32_t> shard_count{0};
+
+        // QoS osztályonként. A kritikus osztályok (control, host-integrity) a beküldést és a
+        // buszon lévő eseményeiket (kapacitás) is itt számolják; a network beküldött száma
+        // a total_events maradéka, így a hot path nem kap újabb közös számlálót
+        struct alignas(64) QosCounter {
+            std::atomic<uint64_t> events{0};
+            std::atomic<uint32_t> inflight{0};
+            std::atomic<uint64_t> shed{0};
+            std::atomic<uint64_t> overflow{0};
+            std::atomic<uint64_t> max_wait_ns{0};
+        };
+        QosCounter qos[TELEMETRY_QOS_CLASSES];
+
+        // XDP ring buffer csatorna (BpfLoader fogyasztó szála írja)
+        std::atomic<uint64_t> kernel_events{0};
+        std::atomic<uint64_t> kernel_events_lost{0};
+
         std::chrono::steady_clock::time_point window_start;
 
         BusTelemetry();
@@ -3,6 +3,13 @@
 #include <cstdint>
 #include "telemetry/TelemetryTypes.hpp"
 
+// Ennyi ingress shard (SO_REUSEPORT sáv) számlálója fér el a pillanatképben
+constexpr uint32_t TELEMETRY_MAX_SHARDS = 64;
+// Ennyi reaktív partíció (forráscím-hash szerinti sáv) számlálója
+constexpr uint32_t TELEMETRY_MAX_PARTITIONS = 16;
+// QoS osztályok (control, host-integrity, network) a VenomBus ingressen
+constexpr uint32_t TELEMETRY_QOS_CLASSES = 3;
+
 struct TelemetrySnapshot {
     // --- Traffic Metrics (Existing) ---
     uint64_t total;
@@ -13,13 +20,39 @@ struct TelemetrySnapshot {
     // --- Queue Metrics (Existing) ---
     uint32_t queue_current;
     uint32_t queue_peak;
+    uint64_t windows;          // Reaktív ablakok (átlagos méret: (accepted + null_routed) / windows)
 
     // --- System Health (Existing) ---
     BusState state;
     uint64_t window_ms;
+    double overload_delay_ms;       // A vezérlő becsült várakozási ideje (az állapot alapja)
+    uint64_t drain_rate;            // Feldolgozott esemény / s (simított)
+    uint64_t state_transitions;     // Állapotváltások száma
 
     // --- ÚJ: Security Posture (Dual-Venom additions) ---
     SecurityProfile current_profile; // Normal vs High
     uint64_t time_cube_violations;   // Hányszor volt időtúllépés?
     double current_system_load;      // A "Metabolism" load factor (1.0 = normal)
+
+    // --- Ingress shardok (SO_REUSEPORT) ---
+    uint32_t shard_count;                          // 0 = nincs sharding
+    uint64_t shard_accepts[TELEMETRY_MAX_SHARDS];  // Shardonként elfogadott kapcsolatok
+    double shard_imbalance;                        // max / átlag (1.0 = tökéletes eloszlás)
+
+    // --- Reaktív partíciók (a partíciók saját számlálóiból összefésülve) ---
+    uint32_t partition_count;
+    uint64_t partition_events[TELEMETRY_MAX_PARTITIONS];  // Partíciónként feldolgozott események
+    double partition_imbalance;                           // max / átlag (1.0 = egyenletes)
+    uint64_t source_blocks;                               // Forrásonkénti strike-limit miatti tiltáskérések
+
+    // --- QoS osztályok (index: control, host-integrity, network) ---
+    uint64_t qos_events[TELEMETRY_QOS_CLASSES];      // Beküldött események
+    uint64_t qos_delivered[TELEMETRY_QOS_CLASSES];   // Pontozott események (a partíciókból összefésülve)
+    uint64_t qos_shed[TELEMETRY_QOS_CLASSES];        // Túlterhelés miatt elhagyott (csak a network)
+    uint64_t qos_overflow[TELEMETRY_QOS_CLASSES];    // Osztálykapacitás / gyűrű tele: null-route
+    double qos_max_wait_ms[TELEMETRY_QOS_CLASSES];   // Leghosszabb beküldés -> pontozás (az ablak óta)
+
+    // --- Kernel eseménycsatorna (XDP ring buffer) ---
+    uint64_t kernel_events;       // A ringből kiolvasott rekordok
+    uint64_t kernel_events_lost;  // Tele ring: a kernel nem tudott foglalni (elveszett rekord)
 };
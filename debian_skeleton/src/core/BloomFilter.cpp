@@ -0,0 +1,134 @@
+#include "core/BloomFilter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Venom::Core {
+
+namespace {
+    constexpr size_t WORDS = BloomFilter::BLOCK_BITS / 64;
+    constexpr uint64_t BLOCK_SEED = 0;
+    constexpr uint64_t BIT_SEED = 0x9e3779b97f4a7c15ull;
+
+    // A szavak mmap-elt memóriában ülnek (nincs std::atomic objektum), ezért a GCC/Clang
+    // __atomic beépítettjei; a bitek nem publikálnak más adatot, relaxed elég
+    uint64_t loadWord(const uint64_t* w) { return __atomic_load_n(w, __ATOMIC_RELAXED); }
+    void orWord(uint64_t* w, uint64_t bits) { __atomic_fetch_or(w, bits, __ATOMIC_RELAXED); }
+}
+
+    double BloomFilter::blockedFpr(double bitsPerItem, unsigned k) {
+        // A blokkonkénti címszám Poisson-eloszlású (átlag BLOCK_BITS / bitsPerItem); a zsúfolt
+        // blokkok hamis pozitívja uralja az átlagot, ezért ez a klasszikus képletnél rosszabb
+        const double lambda = BLOCK_BITS / bitsPerItem;
+        const double perBit = 1.0 - 1.0 / BLOCK_BITS;
+        double pmf = std::exp(-lambda);
+        double sum = 0;
+        const unsigned top = static_cast<unsigned>(lambda + 12 * std::sqrt(lambda) + 12);
+        for (unsigned j = 0; j <= top; ++j) {
+            if (j > 0) pmf *= lambda / j;
+            sum += pmf * std::pow(1.0 - std::pow(perBit, static_cast<double>(j) * k), k);
+        }
+        return sum;
+    }
+
+    BloomFilter::BloomFilter(size_t capacity, double fpr) : capacity(std::max<size_t>(1, capacity)) {
+        // Generációnként fpr/2: a lekérdezés két generációt néz. A bitszám a klasszikus
+        // képletből indul, és addig nő, amíg a blokkos becslés is a cél alá esik
+        const double target = std::clamp(fpr, 1e-9, 0.5) / 2;
+        const double ln2 = std::log(2.0);
+        double bitsPerItem = -std::log(target) / (ln2 * ln2);
+        for (;;) {
+            hashes = static_cast<unsigned>(std::clamp(std::lround(bitsPerItem * ln2), 1L,
+                                                      static_cast<long>(MAX_HASHES)));
+            if (blockedFpr(bitsPerItem, hashes) <= target) break;
+            bitsPerItem += 0.5;
+        }
+        const double bits = bitsPerItem * static_cast<double>(this->capacity);
+        blocks = std::max<size_t>(1, static_cast<size_t>(std::ceil(bits / BLOCK_BITS)));
+
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        genBytes = (blocks * WORDS * sizeof(uint64_t) + page - 1) / page * page;
+        for (auto& g : gen) {
+            // Névtelen lapok: nullával indulnak, és az első írásig fizikai memóriát sem foglalnak
+            void* p = mmap(nullptr, genBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                if (gen[0]) munmap(gen[0], genBytes);
+                throw std::bad_alloc();
+            }
+            g = static_cast<uint64_t*>(p);
+        }
+    }
+
+    BloomFilter::~BloomFilter() {
+        for (auto* g : gen) {
+            if (g) munmap(g, genBytes);
+        }
+    }
+
+    BloomFilter::Probe BloomFilter::probe(const NetAddress& addr) const {
+        Probe p{};
+        // A blokk a hash felső feléből (szorzásos tartományra vetítés, nem kell kettő hatvány)
+        const uint64_t hb = addr.hash(BLOCK_SEED);
+        p.block = static_cast<size_t>((static_cast<unsigned __int128>(hb) * blocks) >> 64);
+        // A blokkon belüli k pozíció: a második hash-ből indított 64 bites LCG-folyam felső
+        // 9 bitje. A klasszikus a + i*b kettős hash 512 bites blokkban egymáshoz hasonló
+        // mintákat ad (a mért arány a vártnak kétszerese), ez véletlenszerű elhelyezésnek felel meg
+        uint64_t x = addr.hash(BIT_SEED);
+        for (unsigned i = 0; i < hashes; ++i) {
+            const uint32_t bit = static_cast<uint32_t>(x >> 55);
+            p.mask[bit / 64] |= uint64_t(1) << (bit % 64);
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        return p;
+    }
+
+    void BloomFilter::insert(const NetAddress& addr) {
+        const Probe p = probe(addr);
+        uint64_t* words = gen[active.load(std::memory_order_acquire)] + p.block * WORDS;
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (p.mask[w]) orWord(words + w, p.mask[w]);
+        }
+        // Pontosan egy szál látja a kapacitás elérését: az forgat
+        if (inserted.fetch_add(1, std::memory_order_relaxed) + 1 == capacity) rotate();
+    }
+
+    bool BloomFilter::contains(const NetAddress& addr) const {
+        const Probe p = probe(addr);
+        const unsigned cur = active.load(std::memory_order_acquire);
+        // A két generáció blokkja elágazás nélkül, egymástól független betöltésekkel: a két
+        // cache-miss átfed (egy nem tag cím mindkettőt végigolvassa)
+        const uint64_t* now = gen[cur] + p.block * WORDS;
+        const uint64_t* prev = gen[cur ^ 1u] + p.block * WORDS;
+        uint64_t missNow = 0, missPrev = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            missNow |= p.mask[w] & ~loadWord(now + w);
+            missPrev |= p.mask[w] & ~loadWord(prev + w);
+        }
+        return missNow == 0 || missPrev == 0;
+    }
+
+    void BloomFilter::drop(uint64_t* words) {
+        // Privát névtelen leképezésen a DONTNEED után a lapok nullaként jönnek vissza
+        if (madvise(words, genBytes, MADV_DONTNEED) == 0) return;
+        for (size_t i = 0; i < genBytes / sizeof(uint64_t); ++i) __atomic_store_n(words + i, 0, __ATOMIC_RELAXED);
+    }
+
+    void BloomFilter::rotate() {
+        std::lock_guard<std::mutex> lock(rotateMtx);
+        // A régebbi generáció ürül ki és lesz az aktuális; a mostani aktuális marad előzőnek
+        const unsigned next = active.load(std::memory_order_relaxed) ^ 1u;
+        drop(gen[next]);
+        active.store(next, std::memory_order_release);
+        inserted.store(0, std::memory_order_relaxed);
+        rotationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void BloomFilter::clear() {
+        std::lock_guard<std::mutex> lock(rotateMtx);
+        drop(gen[0]);
+        drop(gen[1]);
+        inserted.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,69 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/EntropyAccumulator.hpp"
+#include "core/EntropyEngine.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace Venom::Core {
+
+    EntropyAccumulator::EntropyAccumulator(size_t windowBytes)
+        : window(windowBytes ? windowBytes : DEFAULT_WINDOW, 0) {}
+
+    void EntropyAccumulator::update(std::string_view chunk) {
+        const size_t cap = window.size();
+
+        for (unsigned char b : chunk) {
+            if (fill == cap) {
+                // A legrégebbi bájt kicsúszik: f(c-1) - f(c)
+                uint8_t old = window[head];
+                uint32_t c = counts[old];
+                sumNLogN += EntropyEngine::nlog2n(c - 1) - EntropyEngine::nlog2n(c);
+                counts[old] = c - 1;
+            } else {
+                ++fill;
+            }
+
+            // A belépő bájt: f(c+1) - f(c)
+            uint32_t c = counts[b];
+            sumNLogN += EntropyEngine::nlog2n(c + 1) - EntropyEngine::nlog2n(c);
+            counts[b] = c + 1;
+
+            window[head] = b;
+            head = (head + 1 == cap) ? 0 : head + 1;
+        }
+
+        total += chunk.size();
+        sinceResync += chunk.size();
+        if (sinceResync >= RESYNC_INTERVAL) {
+            resync();
+        }
+    }
+
+    double EntropyAccumulator::entropy() const {
+        if (fill == 0) return 0.0;
+        double n = static_cast<double>(fill);
+        double h = std::log2(n) - sumNLogN / n;
+        return (h > 0.0) ? h : 0.0;
+    }
+
+    void EntropyAccumulator::resync() {
+        double s = 0.0;
+        for (uint32_t c : counts) {
+            if (c) s += EntropyEngine::nlog2n(c);
+        }
+        sumNLogN = s;
+        sinceResync = 0;
+    }
+
+    void EntropyAccumulator::reset() {
+        std::memset(counts, 0, sizeof(counts));
+        sumNLogN = 0.0;
+        head = 0;
+        fill = 0;
+        total = 0;
+        sinceResync = 0;
+    }
+
+} // namespace Venom::Core
@@ -0,0 +1,118 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/EntropyEngine.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace Venom::Core {
+
+namespace {
+
+    /**
+     * @brief c*log2(c) tábla: a [0, TABLE_SIZE) tartomány minden számlálójára.
+     * A 0. elem 0, így az üres binek elágazás nélkül is összeadhatók.
+     */
+    struct NLogNTable {
+        alignas(64) double v[EntropyEngine::TABLE_SIZE];
+        NLogNTable() {
+            v[0] = 0.0;
+            for (size_t n = 1; n < EntropyEngine::TABLE_SIZE; ++n) {
+                v[n] = static_cast<double>(n) * std::log2(static_cast<double>(n));
+            }
+        }
+    };
+
+    const NLogNTable g_nlogn;
+
+    inline double nlogn(uint32_t c) {
+        return (c < EntropyEngine::TABLE_SIZE) ? g_nlogn.v[c]
+                                               : static_cast<double>(c) * std::log2(static_cast<double>(c));
+    }
+
+    // H = log2(N) - S/N ; log2(N) is a táblából jön, ha N elég kicsi
+    inline double finish(double sum, size_t total) {
+        double n = static_cast<double>(total);
+        double logN = (total < EntropyEngine::TABLE_SIZE) ? g_nlogn.v[total] / n : std::log2(n);
+        double h = logN - sum / n;
+        return (h > 0.0) ? h : 0.0;
+    }
+
+    /**
+     * @brief Rövid payload: egy hisztogram, az összegzés a payload újrapásztázásával
+     * (nem kell mind a 256 bint bejárni, és a bin rögtön nullázódik is).
+     */
+    double smallPath(const unsigned char* p, size_t n) {
+        uint32_t hist[256] = {};
+        for (size_t i = 0; i < n; ++i) hist[p[i]]++;
+
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t c = hist[p[i]];
+            if (c) {
+                sum += g_nlogn.v[c];
+                hist[p[i]] = 0;
+            }
+        }
+        return finish(sum, n);
+    }
+
+    using SubHistograms = uint32_t[4][256];
+
+    /**
+     * @brief 4 egymásba fűzött al-hisztogram: az egymást követő bájtok más-más
+     * tömbbe számolnak, így az azonos bájtok sorozata nem sorosodik egy címen.
+     */
+    void buildSubHistograms(const unsigned char* p, size_t n, SubHistograms& h) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, sizeof(w));
+            h[0][w & 0xff]++;
+            h[1][(w >> 8) & 0xff]++;
+            h[2][(w >> 16) & 0xff]++;
+            h[3][(w >> 24) & 0xff]++;
+            h[0][(w >> 32) & 0xff]++;
+            h[1][(w >> 40) & 0xff]++;
+            h[2][(w >> 48) & 0xff]++;
+            h[3][(w >> 56) & 0xff]++;
+        }
+        for (; i < n; ++i) h[0][p[i]]++;
+    }
+
+    double largePath(const unsigned char* p, size_t n) {
+        alignas(32) SubHistograms h = {};
+        buildSubHistograms(p, n, h);
+
+        double sum = 0.0;
+        for (size_t b = 0; b < 256; ++b) {
+            uint32_t c = h[0][b] + h[1][b] + h[2][b] + h[3][b];
+            if (c) sum += nlogn(c);
+        }
+        return finish(sum, n);
+    }
+
+} // namespace
+
+    double EntropyEngine::compute(std::string_view data) {
+        if (data.empty()) return 0.0;
+
+        const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+        const size_t n = data.size();
+        return (n < SMALL_PAYLOAD) ? smallPath(p, n) : largePath(p, n);
+    }
+
+    double EntropyEngine::fromHistogram(const uint32_t* hist, size_t total) {
+        if (total == 0) return 0.0;
+        double sum = 0.0;
+        for (size_t b = 0; b < 256; ++b) {
+            if (hist[b]) sum += nlogn(hist[b]);
+        }
+        return finish(sum, total);
+    }
+
+    double EntropyEngine::nlog2n(uint32_t c) {
+        return nlogn(c);
+    }
+
+} // namespace Venom::Core
@@ -0,0 +1,264 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/EpollReactor.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
+#include <chrono>
+
+namespace Venom::Core {
+
+namespace {
+    // Az epoll_event.data.ptr jelölői a nem-kapcsolat leírókhoz
+    char g_listenTag;
+    char g_wakeTag;
+
+    constexpr int MAX_EVENTS = 256;
+    constexpr int SWEEP_INTERVAL_MS = 250;
+    constexpr int ACCEPT_RETRY_MS = 10;
+
+    uint64_t nowMs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+    EpollReactor::EpollReactor(VenomBus& vBus, SourceId source, int fd, IngressCounters& c,
+                               const ReactorOptions& options)
+        : bus(vBus), sourceId(source), listenFd(fd), wakeFd(-1),
+          lane(options.lane), cpu(options.cpu), counters(c) {
+        unsigned workerCount = options.workers ? options.workers : 1;
+        maxPerWorker = (options.maxConnections + workerCount - 1) / workerCount;
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    EpollReactor::~EpollReactor() {
+        stop();
+    }
+
+    bool EpollReactor::start() {
+        if (running) return false;
+
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0) return false;
+
+        for (auto& w : workers) {
+            w->epfd = epoll_create1(EPOLL_CLOEXEC);
+            if (w->epfd < 0) { stop(); return false; }
+
+            // EPOLLEXCLUSIVE: egy bejövő kapcsolat csak egy workert ébreszt (nincs thundering herd)
+            epoll_event lev{};
+            lev.events = EPOLLIN | EPOLLET | EPOLLEXCLUSIVE;
+            lev.data.ptr = &g_listenTag;
+            if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, listenFd, &lev) < 0) { stop(); return false; }
+
+            epoll_event wev{};
+            wev.events = EPOLLIN;
+            wev.data.ptr = &g_wakeTag;
+            epoll_ctl(w->epfd, EPOLL_CTL_ADD, wakeFd, &wev);
+        }
+
+        running = true;
+        for (auto& w : workers) {
+            Worker* wp = w.get();
+            wp->thread = std::thread([this, wp] { run(*wp); });
+        }
+        return true;
+    }
+
+    void EpollReactor::stop() {
+        bool wasRunning = running.exchange(false);
+        if (wasRunning && wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+            while (w->active) closeConnection(*w, w->active);
+            if (w->epfd >= 0) { close(w->epfd); w->epfd = -1; }
+        }
+
+        if (wakeFd >= 0) { close(wakeFd); wakeFd = -1; }
+    }
+
+    void EpollReactor::run(Worker& w) {
+        if (cpu >= 0) {
+            // Shard: a szál a saját magján marad (a listen socket RX-sora is ott van)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+
+        epoll_event events[MAX_EVENTS];
+        uint64_t lastSweep = nowMs();
+
+        while (running.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(w.epfd, events, MAX_EVENTS, w.acceptPending ? ACCEPT_RETRY_MS : SWEEP_INTERVAL_MS);
+            if (n < 0 && errno != EINTR) break;
+
+            for (int i = 0; i < n; ++i) {
+                void* tag = events[i].data.ptr;
+                if (tag == &g_wakeTag) continue; // stop(): a ciklusfeltétel dönt
+                if (tag == &g_listenTag) { acceptAll(w); continue; }
+
+                Connection* c = static_cast<Connection*>(tag);
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                    onReadable(w, c);
+                }
+            }
+
+            // ET mellett a félbehagyott accept sor nem jelez újra: magunktól próbáljuk
+            if (w.acceptPending) acceptAll(w);
+
+            uint64_t now = nowMs();
+            if (now - lastSweep >= static_cast<uint64_t>(SWEEP_INTERVAL_MS)) {
+                sweepIdle(w, now);
+                lastSweep = now;
+            }
+        }
+    }
+
+    EpollReactor::Connection* EpollReactor::obtain(Worker& w) {
+        if (!w.freeList.empty()) {
+            Connection* c = w.freeList.back();
+            w.freeList.pop_back();
+            return c;
+        }
+        // Csak a csúcsterhelés első elérésekor allokálunk; utána a szabadlista szolgál
+        w.storage.push_back(std::make_unique<Connection>());
+        w.freeList.reserve(w.storage.size());
+        return w.storage.back().get();
+    }
+
+    void EpollReactor::acceptAll(Worker& w) {
+        // Edge-triggered: EAGAIN-ig kell fogadni, különben elveszhet az értesítés
+        w.acceptPending = false;
+        for (;;) {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            int fd = accept4(listenFd, reinterpret_cast<sockaddr*>(&addr), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                    w.acceptPending = true;
+                }
+                return;
+            }
+
+            // NULL_ONLY: a kapcsolat nem kap olvasást és eseményt sem (a backlog így is ürül)
+            if (!bus.admitsConnections()) {
+                counters.shed.fetch_add(1, std::memory_order_relaxed);
+                close(fd);
+                continue;
+            }
+
+            counters.accepted.fetch_add(1, std::memory_order_relaxed);
+            bus.noteAccept(lane);
+
+            if (w.live >= maxPerWorker) {
+                counters.rejected.fetch_add(1, std::memory_order_relaxed);
+                close(fd);
+                continue;
+            }
+
+            Connection* c = obtain(w);
+            c->fd = fd;
+            c->state = ConnState::READING;
+            c->peer = NetAddress::fromV4(addr.sin_addr.s_addr);
+            c->entropy.reset();
+            c->lastActivityMs = nowMs();
+
+            c->prev = nullptr;
+            c->next = w.active;
+            if (w.active) w.active->prev = c;
+            w.active = c;
+            w.live++;
+
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+            ev.data.ptr = c;
+            if (epoll_ctl(w.epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+                closeConnection(w, c);
+                continue;
+            }
+
+            // A kliens már az accept előtt küldhetett: ET mellett nem jönne rá külön él
+            onReadable(w, c);
+        }
+    }
+
+    void EpollReactor::onReadable(Worker& w, Connection* c) {
+        if (c->fd < 0) return;
+
+        char buffer[ConnectionLimits::READ_CHUNK];
+        for (;;) {
+            ssize_t n = read(c->fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                std::string_view chunk(buffer, static_cast<size_t>(n));
+                c->entropy.update(chunk);
+                c->lastActivityMs = nowMs();
+                counters.bytes.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+
+                bus.pushEvent(lane, sourceId, EventOrigin::NETWORK, chunk, EVENT_FLAG_STREAM, &c->peer,
+                              static_cast<float>(c->entropy.entropy()));
+
+                if (c->entropy.totalBytes() >= ConnectionLimits::STREAM_BUDGET_BYTES) {
+                    c->state = ConnState::CLOSING;
+                    break;
+                }
+                continue;
+            }
+            if (n == 0) {
+                c->state = ConnState::CLOSING; // EOF
+                break;
+            }
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) c->state = ConnState::CLOSING;
+            break;
+        }
+
+        if (c->state == ConnState::CLOSING) {
+            closeConnection(w, c);
+        }
+    }
+
+    void EpollReactor::closeConnection(Worker& w, Connection* c) {
+        if (c->fd >= 0) {
+            close(c->fd); // close() az epoll-ból is kiveszi
+            c->fd = -1;
+            counters.closed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (c->prev) c->prev->next = c->next;
+        else w.active = c->next;
+        if (c->next) c->next->prev = c->prev;
+        c->prev = c->next = nullptr;
+
+        w.live--;
+        w.freeList.push_back(c);
+    }
+
+    void EpollReactor::sweepIdle(Worker& w, uint64_t now) {
+        Connection* c = w.active;
+        while (c) {
+            Connection* next = c->next;
+            if (now - c->lastActivityMs >= ConnectionLimits::IDLE_TIMEOUT_MS) {
+                closeConnection(w, c);
+            }
+            c = next;
+        }
+    }
+
+} // namespace Venom::Core
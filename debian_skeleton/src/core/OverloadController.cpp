@@ -0,0 +1,75 @@
+#include "core/OverloadController.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace Venom::Core {
+
+    OverloadPolicy OverloadPolicy::disabled() {
+        OverloadPolicy p;
+        const double never = std::numeric_limits<double>::infinity();
+        p.degradedEnterMs = p.overloadEnterMs = p.nullOnlyEnterMs = never;
+        p.degradedEnterFill = p.overloadEnterFill = never;
+        return p;
+    }
+
+    BusState OverloadController::target(double delayMs, double fill) const {
+        if (delayMs >= policy.nullOnlyEnterMs) return BusState::NULL_ONLY;
+        if (delayMs >= policy.overloadEnterMs || fill >= policy.overloadEnterFill) return BusState::OVERLOAD;
+        if (delayMs >= policy.degradedEnterMs || fill >= policy.degradedEnterFill) return BusState::DEGRADED;
+        return BusState::UP;
+    }
+
+    bool OverloadController::calm(double delayMs, double fill) const {
+        switch (current) {
+            case BusState::NULL_ONLY:
+                return delayMs < policy.nullOnlyExitMs;
+            case BusState::OVERLOAD:
+                return delayMs < policy.overloadExitMs && fill < policy.overloadExitFill;
+            case BusState::DEGRADED:
+                return delayMs < policy.degradedExitMs && fill < policy.degradedExitFill;
+            case BusState::UP:
+            default:
+                return true;
+        }
+    }
+
+    BusState OverloadController::update(const Sample& s) {
+        // Drain ütem: a kumulatív számláló különbsége, exponenciálisan simítva. Üresjáratban
+        // (nincs sor, nincs feldolgozás) nem mérünk: a tétlen busz ütemét nem húzzuk nullára
+        const bool busy = s.depth > 0 || s.drained != lastDrained;
+        if (busy && lastNs != 0 && s.nowNs > lastNs) {
+            const double dt = static_cast<double>(s.nowNs - lastNs) * 1e-9;
+            const double instant = static_cast<double>(s.drained - lastDrained) / dt;
+            rate = rate == 0.0 ? instant : rate + RATE_ALPHA * (instant - rate);
+        }
+        lastNs = s.nowNs;
+        lastDrained = s.drained;
+
+        // Várható várakozás: a sor kiürülésének ideje a jelenlegi ütemmel, vagy a mért
+        // ablak-késleltetés, ha az a nagyobb (ütembecslés nélkül csak a mért késleltetés számít)
+        const double predictedMs = rate > 0.0 ? static_cast<double>(s.depth) / rate * 1e3 : 0.0;
+        lastDelayMs = std::max(predictedMs, static_cast<double>(s.maxSojournNs) * 1e-6);
+        const double fill = static_cast<double>(s.depth) / static_cast<double>(std::max<uint32_t>(s.capacity, 1));
+
+        const BusState want = target(lastDelayMs, fill);
+        if (want > current) {
+            current = want;
+            calmSinceNs = 0;
+            transitionCount++;
+            return current;
+        }
+        if (current == BusState::UP || !calm(lastDelayMs, fill)) {
+            calmSinceNs = 0;
+            return current;
+        }
+        if (calmSinceNs == 0) calmSinceNs = s.nowNs;
+        const uint64_t coolNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(policy.coolDown).count());
+        if (s.nowNs - calmSinceNs >= coolNs) {
+            current = static_cast<BusState>(static_cast<int>(current) - 1);
+            calmSinceNs = s.nowNs;   // A következő szinthez újra coolDown kell
+            transitionCount++;
+        }
+        return current;
+    }
+}
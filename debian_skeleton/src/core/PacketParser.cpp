@@ -0,0 +1,157 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/PacketParser.hpp"
+#include <cstring>
+#include <netinet/in.h>
+
+namespace Venom::Core {
+
+namespace {
+    constexpr size_t ETH_HEADER_LEN = 14;
+    constexpr size_t VLAN_TAG_LEN = 4;
+    constexpr size_t ARP_ETH_IPV4_LEN = 28;
+    constexpr size_t IPV4_MIN_HLEN = 20;
+    constexpr size_t IPV6_HLEN = 40;
+    constexpr size_t UDP_HLEN = 8;
+    constexpr size_t TCP_MIN_HLEN = 20;
+
+    constexpr uint16_t TYPE_IPV4 = 0x0800;
+    constexpr uint16_t TYPE_ARP = 0x0806;
+    constexpr uint16_t TYPE_IPV6 = 0x86DD;
+    constexpr uint16_t TYPE_VLAN = 0x8100;
+    constexpr uint16_t TYPE_QINQ = 0x88A8;
+
+    // Igazítatlan, bájtsorrend-független olvasás (a capture-pufferben nincs igazítási garancia)
+    inline uint16_t rd16(const uint8_t* p) {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    void parseL4(const uint8_t* l4, size_t len, PacketView& out) {
+        if (out.fragment) return;
+
+        if (out.l4Proto == IPPROTO_UDP && len >= UDP_HLEN) {
+            out.srcPort = rd16(l4);
+            out.dstPort = rd16(l4 + 2);
+            out.payload = l4 + UDP_HLEN;
+            out.payloadLen = len - UDP_HLEN;
+        } else if (out.l4Proto == IPPROTO_TCP && len >= TCP_MIN_HLEN) {
+            size_t doff = static_cast<size_t>(l4[12] >> 4) * 4;
+            if (doff < TCP_MIN_HLEN || doff > len) return;
+            out.srcPort = rd16(l4);
+            out.dstPort = rd16(l4 + 2);
+            out.payload = l4 + doff;
+            out.payloadLen = len - doff;
+        } else {
+            // ICMP és egyéb: a teljes L4 rész a tartalom
+            out.payload = l4;
+            out.payloadLen = len;
+        }
+    }
+
+    bool parseIPv4(const uint8_t* ip, size_t len, PacketView& out) {
+        if (len < IPV4_MIN_HLEN || (ip[0] >> 4) != 4) return false;
+        size_t ihl = static_cast<size_t>(ip[0] & 0x0f) * 4;
+        size_t total = rd16(ip + 2);
+        if (ihl < IPV4_MIN_HLEN || ihl > len) return false;
+        // A keret hosszabb lehet (Ethernet padding), rövidebb nem
+        if (total < ihl) return false;
+        if (total > len) total = len;
+
+        uint32_t s, d;
+        std::memcpy(&s, ip + 12, 4);
+        std::memcpy(&d, ip + 16, 4);
+        out.src = NetAddress::fromV4(s);
+        out.dst = NetAddress::fromV4(d);
+        out.l4Proto = ip[9];
+        out.fragment = (rd16(ip + 6) & 0x1fff) != 0;
+
+        parseL4(ip + ihl, total - ihl, out);
+        return true;
+    }
+
+    bool parseIPv6(const uint8_t* ip, size_t len, PacketView& out) {
+        if (len < IPV6_HLEN || (ip[0] >> 4) != 6) return false;
+        size_t payloadLen = rd16(ip + 4);
+        size_t end = IPV6_HLEN + payloadLen;
+        if (end > len) end = len;
+
+        out.src = NetAddress::fromV6(ip + 8);
+        out.dst = NetAddress::fromV6(ip + 24);
+
+        uint8_t next = ip[6];
+        size_t off = IPV6_HLEN;
+        // Kiterjesztett fejlécek: korlátos lépésszám (a láncot a támadó építi)
+        for (int i = 0; i < PacketParser::MAX_IPV6_EXT_HEADERS; ++i) {
+            if (next == IPPROTO_HOPOPTS || next == IPPROTO_ROUTING || next == IPPROTO_DSTOPTS) {
+                if (off + 2 > end) return false;
+                size_t hlen = (static_cast<size_t>(ip[off + 1]) + 1) * 8;
+                next = ip[off];
+                off += hlen;
+            } else if (next == IPPROTO_FRAGMENT) {
+                if (off + 8 > end) return false;
+                uint16_t fragOff = static_cast<uint16_t>(rd16(ip + off + 2) & 0xfff8);
+                if (fragOff != 0) out.fragment = true;
+                next = ip[off];
+                off += 8;
+            } else {
+                break;
+            }
+            if (off > end) return false;
+        }
+
+        out.l4Proto = next;
+        parseL4(ip + off, end - off, out);
+        return true;
+    }
+}
+
+    bool PacketParser::parse(const uint8_t* frame, size_t len, PacketView& out) {
+        out = PacketView{};
+        if (!frame || len < ETH_HEADER_LEN) return false;
+
+        out.srcMac = frame + 6;
+        uint16_t type = rd16(frame + 12);
+        size_t off = ETH_HEADER_LEN;
+
+        while ((type == TYPE_VLAN || type == TYPE_QINQ) && out.vlanDepth < MAX_VLAN_TAGS) {
+            if (off + VLAN_TAG_LEN > len) return false;
+            type = rd16(frame + off + 2);
+            off += VLAN_TAG_LEN;
+            out.vlanDepth++;
+        }
+        out.etherType = type;
+
+        const uint8_t* l3 = frame + off;
+        size_t l3len = len - off;
+
+        switch (type) {
+            case TYPE_ARP: {
+                // Csak Ethernet/IPv4 ARP (htype=1, ptype=0x0800, hlen=6, plen=4)
+                if (l3len < ARP_ETH_IPV4_LEN) return false;
+                if (rd16(l3) != 1 || rd16(l3 + 2) != TYPE_IPV4 || l3[4] != 6 || l3[5] != 4) return false;
+                out.kind = FrameKind::ARP;
+                out.arpOp = rd16(l3 + 6);
+                out.arpSenderMac = l3 + 8;
+                uint32_t spa, tpa;
+                std::memcpy(&spa, l3 + 14, 4);
+                std::memcpy(&tpa, l3 + 24, 4);
+                out.src = NetAddress::fromV4(spa);
+                out.dst = NetAddress::fromV4(tpa);
+                out.payload = l3;
+                out.payloadLen = ARP_ETH_IPV4_LEN;
+                return true;
+            }
+            case TYPE_IPV4:
+                out.kind = FrameKind::IPV4;
+                return parseIPv4(l3, l3len, out);
+            case TYPE_IPV6:
+                out.kind = FrameKind::IPV6;
+                return parseIPv6(l3, l3len, out);
+            default:
+                out.kind = FrameKind::OTHER;
+                return true;
+        }
+    }
+
+} // namespace Venom::Core
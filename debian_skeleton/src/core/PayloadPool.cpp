@@ -0,0 +1,105 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/PayloadPool.hpp"
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+namespace Venom::Core {
+
+    PayloadPool::PayloadPool(uint32_t initialSlabs)
+        : nextFree(std::make_unique<std::atomic<uint32_t>[]>(static_cast<size_t>(MAX_SLABS) * SLAB_BLOCKS)) {
+        initialSlabs = std::min(std::max(initialSlabs, 1u), MAX_SLABS);
+        for (uint32_t i = 0; i < initialSlabs; ++i) {
+            grow();
+        }
+    }
+
+    PayloadPool::~PayloadPool() = default;
+
+    PayloadBlock* PayloadPool::blockAt(uint32_t index) const {
+        return &slabTable[index / SLAB_BLOCKS][index % SLAB_BLOCKS];
+    }
+
+    PayloadBlock* PayloadPool::pop() {
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t idx = static_cast<uint32_t>(head);
+            if (idx == NIL) return nullptr;
+
+            uint32_t next = nextFree[idx].load(std::memory_order_relaxed);
+            uint64_t tagged = (((head >> 32) + 1) << 32) | next;
+            if (freeHead.compare_exchange_weak(head, tagged, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return blockAt(idx);
+            }
+        }
+    }
+
+    void PayloadPool::push(PayloadBlock* block) {
+        uint64_t head = freeHead.load(std::memory_order_relaxed);
+        for (;;) {
+            nextFree[block->index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            uint64_t tagged = (((head >> 32) + 1) << 32) | block->index;
+            if (freeHead.compare_exchange_weak(head, tagged, std::memory_order_release, std::memory_order_relaxed)) {
+                inUse.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    bool PayloadPool::grow() {
+        // Egyszerre csak egy szál bővít; a többiek közben a szabadlistára várnak
+        if (growing.exchange(true, std::memory_order_acquire)) return false;
+
+        uint32_t slab = slabs.load(std::memory_order_relaxed);
+        if (slab >= MAX_SLABS) {
+            growing.store(false, std::memory_order_release);
+            return false;
+        }
+
+        slabTable[slab] = std::make_unique<PayloadBlock[]>(SLAB_BLOCKS);
+        for (uint32_t i = 0; i < SLAB_BLOCKS; ++i) {
+            PayloadBlock& b = slabTable[slab][i];
+            b.index = slab * SLAB_BLOCKS + i;
+            b.pool = this;
+            inUse.fetch_add(1, std::memory_order_relaxed); // push() visszaveszi
+            push(&b);
+        }
+
+        slabs.store(slab + 1, std::memory_order_release);
+        growing.store(false, std::memory_order_release);
+        return true;
+    }
+
+    PayloadSlice PayloadPool::acquire(std::initializer_list<std::string_view> parts) {
+        PayloadBlock* block = pop();
+        while (!block) {
+            // Üres szabadlista: bővítünk, vagy kivárjuk a másik szál bővítését. Érvénytelen
+            // szelet csak a plafonon: egy épp bővítő szál mellett a beküldés nem vész el
+            if (!grow()) {
+                if (slabs.load(std::memory_order_acquire) >= MAX_SLABS) {
+                    block = pop();
+                    if (!block) return PayloadSlice{};
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            block = pop();
+        }
+
+        size_t len = 0;
+        for (std::string_view part : parts) {
+            size_t n = std::min(part.size(), PayloadBlock::CAPACITY - len);
+            std::memcpy(block->data + len, part.data(), n);
+            len += n;
+            if (len == PayloadBlock::CAPACITY) break;
+        }
+
+        block->length = static_cast<uint32_t>(len);
+        block->refs.store(1, std::memory_order_relaxed);
+        inUse.fetch_add(1, std::memory_order_relaxed);
+        return PayloadSlice(block);
+    }
+
+} // namespace Venom::Core
@@ -1,47 +1,382 @@
 #include "core/RawPacketProbe.hpp"
 #include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <sys/socket.h>
+#include <sys/mman.h>
 #include <linux/if_packet.h>
 #include <net/ethernet.h>
+#include <net/if.h>
 #include <arpa/inet.h>
+#include <poll.h>
 #include <unistd.h>
+#include <bpf/bpf.h>
 
 namespace Venom::Core {
 
-    bool RawPacketProbe::load_ebpf_program() {
-        // Itt hívjuk meg a libbpf-et vagy a syscall-t, ami 
-        // a "venom_shield.bpf.o" tartalmát betölti a kernelbe.
-        std::cout << "[RawPacketProbe] Injecting eBPF Shield into Kernel..." << std::endl;
-        return true;
+namespace {
+    constexpr int POLL_TIMEOUT_MS = 100;        // A leállítás-jelző ellenőrzési periódusa
+    constexpr auto KERNEL_STATS_INTERVAL = std::chrono::milliseconds(500);
+
+    constexpr size_t XSK_BATCH = 64;
+
+    // Fanout csoportazonosító: folyamaton belül példányonként egyedi
+    std::atomic<uint32_t> fanoutSeq{0};
+}
+
+    RawPacketProbe::RawPacketProbe(VenomBus& vBus, std::string ifaceName)
+        : bus(vBus), iface(std::move(ifaceName)) {
+        sourceId = bus.registerSource("RAW_" + iface);
+    }
+
+    RawPacketProbe::~RawPacketProbe() {
+        stop();
     }
 
-    void RawPacketProbe::allowRouter(const std::string& mac_addr) {
-        // Itt frissítjük a BPF Map-et (a kernel tábláját)
+    bool RawPacketProbe::allowRouter(const std::string& mac_addr) {
+        std::array<uint8_t, 6> mac{};
+        char tail = 0;
+        if (std::sscanf(mac_addr.c_str(), "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx%c",
+                        &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5], &tail) != 6) {
+            std::cerr << "[RawPacketProbe] Invalid router MAC: " << mac_addr << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(routerMutex);
+        for (const auto& known : trustedRouters) {
+            if (known == mac) return true;
+        }
+        trustedRouters.push_back(mac);
+        trustedCount.store(static_cast<uint32_t>(trustedRouters.size()), std::memory_order_release);
         std::cout << "[RawPacketProbe] Whitelisting Router MAC: " << mac_addr << std::endl;
+        return true;
+    }
+
+    bool RawPacketProbe::isTrustedRouter(const uint8_t* mac) const {
+        if (trustedCount.load(std::memory_order_acquire) == 0) return false;
+        std::lock_guard<std::mutex> lock(routerMutex);
+        for (const auto& known : trustedRouters) {
+            if (std::memcmp(known.data(), mac, known.size()) == 0) return true;
+        }
+        return false;
+    }
+
+    bool RawPacketProbe::openRing(Worker& w, int ifindex, int fanoutId) {
+        w.fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, htons(ETH_P_ALL));
+        if (w.fd < 0) {
+            std::cerr << "[RawPacketProbe] AF_PACKET socket: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        int version = TPACKET_V3;
+        if (setsockopt(w.fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+            std::cerr << "[RawPacketProbe] TPACKET_V3 unsupported: " << std::strerror(errno) << std::endl;
+            closeRing(w);
+            return false;
+        }
+
+        // Csak a bejövő forgalom érdekel; a saját kimenő keretek ne foglaljanak ringet
+        int ignoreOutgoing = 1;
+        setsockopt(w.fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignoreOutgoing, sizeof(ignoreOutgoing));
+
+        tpacket_req3 req{};
+        req.tp_block_size = blockSize;
+        req.tp_block_nr = blockCount;
+        req.tp_frame_size = FRAME_SIZE;
+        req.tp_frame_nr = (blockSize / FRAME_SIZE) * blockCount;
+        req.tp_retire_blk_tov = BLOCK_TIMEOUT_MS;
+        req.tp_feature_req_word = 0;
+        if (setsockopt(w.fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0) {
+            std::cerr << "[RawPacketProbe] PACKET_RX_RING: " << std::strerror(errno) << std::endl;
+            closeRing(w);
+            return false;
+        }
+
+        w.ringSize = static_cast<size_t>(blockSize) * blockCount;
+        void* mem = mmap(nullptr, w.ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, w.fd, 0);
+        if (mem == MAP_FAILED) {
+            std::cerr << "[RawPacketProbe] ring mmap: " << std::strerror(errno) << std::endl;
+            w.ringSize = 0;
+            closeRing(w);
+            return false;
+        }
+        w.ring = static_cast<uint8_t*>(mem);
+
+        sockaddr_ll addr{};
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_ALL);
+        addr.sll_ifindex = ifindex;
+        if (bind(w.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cerr << "[RawPacketProbe] bind " << iface << ": " << std::strerror(errno) << std::endl;
+            closeRing(w);
+            return false;
+        }
+
+        if (fanoutId >= 0) {
+            // Flow hash: egy folyam mindig ugyanahhoz a workerhez kerül; DEFRAG a fragmensekért
+            int arg = (fanoutId & 0xffff) | ((PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_DEFRAG) << 16);
+            if (setsockopt(w.fd, SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) != 0) {
+                std::cerr << "[RawPacketProbe] PACKET_FANOUT: " << std::strerror(errno) << std::endl;
+                closeRing(w);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool RawPacketProbe::openXsk(Worker& w, int ifindex) {
+        if (xskMapFd < 0) {
+            std::cerr << "[RawPacketProbe] AF_XDP mode without xsks_map (is the XDP shield deployed?)" << std::endl;
+            return false;
+        }
+        w.xsk = std::make_unique<XskSocket>();
+        if (!w.xsk->open(ifindex, w.queue)) return false;
+
+        // Bejegyzés: innentől a sorra átirányított keretek ehhez a sockethez jutnak.
+        // A socket lezárásakor a kernel maga veszi ki a map-ből.
+        int fd = w.xsk->fd();
+        if (bpf_map_update_elem(xskMapFd, &w.queue, &fd, BPF_ANY) != 0) {
+            std::cerr << "[RawPacketProbe] xsks_map update (queue " << w.queue << "): "
+                      << std::strerror(errno) << std::endl;
+            w.xsk->close();
+            return false;
+        }
+        return true;
+    }
+
+    void RawPacketProbe::closeRing(Worker& w) {
+        if (w.xsk) w.xsk->close();
+        if (w.ring) {
+            munmap(w.ring, w.ringSize);
+            w.ring = nullptr;
+            w.ringSize = 0;
+        }
+        if (w.fd >= 0) {
+            close(w.fd);
+            w.fd = -1;
+        }
     }
 
-    void RawPacketProbe::start() {
-        if (!load_ebpf_program()) return;
+    bool RawPacketProbe::start() {
+        if (running) return true;
+
+        unsigned ifindex = if_nametoindex(iface.c_str());
+        if (ifindex == 0) {
+            std::cerr << "[RawPacketProbe] Unknown interface: " << iface << std::endl;
+            return false;
+        }
+
+        workers.clear();
+        int fanoutId = -1;
+        if (workerCount > 1) {
+            fanoutId = static_cast<int>((static_cast<uint32_t>(getpid()) + fanoutSeq.fetch_add(1)) & 0xffff);
+        }
+
+        for (unsigned i = 0; i < workerCount; ++i) {
+            auto w = std::make_unique<Worker>();
+            w->queue = i;
+            bool opened = (mode == CaptureMode::XSK)
+                ? openXsk(*w, static_cast<int>(ifindex))
+                : openRing(*w, static_cast<int>(ifindex), fanoutId);
+            if (!opened) {
+                for (auto& started : workers) closeRing(*started);
+                workers.clear();
+                return false;
+            }
+            workers.push_back(std::move(w));
+        }
+
         running = true;
-        // A linker itt kereste a capture_loop-ot
-        worker = std::thread(&RawPacketProbe::capture_loop, this);
+        for (auto& w : workers) {
+            auto loop = (mode == CaptureMode::XSK) ? &RawPacketProbe::xsk_loop : &RawPacketProbe::capture_loop;
+            w->thread = std::thread(loop, this, std::ref(*w));
+        }
+        if (mode == CaptureMode::XSK) {
+            std::cout << "[RawPacketProbe] AF_XDP capture on " << iface << " (" << workers.size()
+                      << " queue, " << (workers.front()->xsk->zeroCopy() ? "zero-copy" : "copy mode") << ")" << std::endl;
+        } else {
+            std::cout << "[RawPacketProbe] TPACKET_V3 capture on " << iface
+                      << " (" << workers.size() << " worker, "
+                      << (static_cast<size_t>(blockSize) * blockCount >> 20) << " MiB ring/worker)" << std::endl;
+        }
+        return true;
     }
 
     void RawPacketProbe::stop() {
-        running = false;
-        if (worker.joinable()) {
-            worker.join();
+        if (!running.exchange(false)) return;
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+            closeRing(*w);
         }
+        // A workerek (számlálóik) a következő start()-ig megmaradnak a stats() számára
         std::cout << "[RawPacketProbe] Engine stopped." << std::endl;
     }
 
-    void RawPacketProbe::capture_loop() {
-        std::cout << "[RawPacketProbe] Capture loop started." << std::endl;
-        while (running) {
-            // Itt jönne a nyers packet capture (recvfrom) 
-            // vagy a BPF ring buffer olvasása.
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    void RawPacketProbe::capture_loop(Worker& w) {
+        pollfd pfd{};
+        pfd.fd = w.fd;
+        pfd.events = POLLIN | POLLERR;
+
+        uint32_t current = 0;
+        auto nextStats = std::chrono::steady_clock::now() + KERNEL_STATS_INTERVAL;
+
+        while (running.load(std::memory_order_relaxed)) {
+            uint8_t* block = w.ring + static_cast<size_t>(current) * blockSize;
+            auto* desc = reinterpret_cast<tpacket_block_desc*>(block);
+
+            if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+                poll(&pfd, 1, POLL_TIMEOUT_MS);
+            } else {
+                processBlock(w, block);
+                // A blokk visszaadása: a kernel csak e store után írhat bele újra
+                __atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+                current = (current + 1) % blockCount;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextStats) {
+                collectKernelStats(w);
+                nextStats = now + KERNEL_STATS_INTERVAL;
+            }
+        }
+        collectKernelStats(w);
+    }
+
+    void RawPacketProbe::xsk_loop(Worker& w) {
+        pollfd pfd{};
+        pfd.fd = w.xsk->fd();
+        pfd.events = POLLIN;
+
+        XskFrame frames[XSK_BATCH];
+        auto nextStats = std::chrono::steady_clock::now() + KERNEL_STATS_INTERVAL;
+
+        while (running.load(std::memory_order_relaxed)) {
+            size_t n = w.xsk->receive(frames, XSK_BATCH);
+            if (n == 0) {
+                poll(&pfd, 1, POLL_TIMEOUT_MS);
+            } else {
+                FrameTally t;
+                for (size_t i = 0; i < n; ++i) {
+                    t.packets++;
+                    t.bytes += frames[i].len;
+                    handleFrame(frames[i].data, frames[i].len, t);
+                }
+                // A bus a tartalmat a poolba másolta: a UMEM keretek mehetnek vissza a kernelnek
+                w.xsk->release(frames, n);
+                commitTally(w, t);
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextStats) {
+                collectKernelStats(w);
+                nextStats = now + KERNEL_STATS_INTERVAL;
+            }
+        }
+        collectKernelStats(w);
+    }
+
+    void RawPacketProbe::processBlock(Worker& w, uint8_t* block) {
+        const auto* desc = reinterpret_cast<const tpacket_block_desc*>(block);
+        const uint32_t count = desc->hdr.bh1.num_pkts;
+        const uint8_t* cursor = block + desc->hdr.bh1.offset_to_first_pkt;
+
+        FrameTally t;
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto* hdr = reinterpret_cast<const tpacket3_hdr*>(cursor);
+            t.packets++;
+            t.bytes += hdr->tp_len;
+            handleFrame(cursor + hdr->tp_mac, hdr->tp_snaplen, t);
+
+            if (hdr->tp_next_offset == 0) break;
+            cursor += hdr->tp_next_offset;
+        }
+        commitTally(w, t);
+    }
+
+    void RawPacketProbe::handleFrame(const uint8_t* frame, size_t len, FrameTally& t) {
+        PacketView view;
+        if (!PacketParser::parse(frame, len, view)) {
+            t.malformed++;
+            return;
+        }
+
+        std::string_view payload(reinterpret_cast<const char*>(view.payload), view.payloadLen);
+        switch (view.kind) {
+            case FrameKind::ARP:
+                t.arp++;
+                // Csak akkor megbízható, ha a keret és az ARP feladója is a router
+                if (std::memcmp(view.srcMac, view.arpSenderMac, 6) == 0 &&
+                    isTrustedRouter(view.arpSenderMac)) {
+                    t.arpTrusted++;
+                } else {
+                    bus.pushEvent(sourceId, EventOrigin::RAW_PACKET, payload, EVENT_FLAG_ARP, &view.src);
+                }
+                break;
+            case FrameKind::IPV4:
+            case FrameKind::IPV6:
+                (view.kind == FrameKind::IPV4 ? t.ipv4 : t.ipv6)++;
+                if (view.payloadLen > 0) {
+                    bus.pushEvent(sourceId, EventOrigin::RAW_PACKET, payload, EVENT_FLAG_NONE, &view.src);
+                }
+                break;
+            case FrameKind::OTHER:
+                t.other++;
+                break;
+        }
+    }
+
+    void RawPacketProbe::commitTally(Worker& w, const FrameTally& t) {
+        // Blokkonként egy könyvelés: a hot path nem ír megosztott cache-sort keretenként
+        auto& c = w.counters;
+        c.packets.fetch_add(t.packets, std::memory_order_relaxed);
+        c.bytes.fetch_add(t.bytes, std::memory_order_relaxed);
+        c.arp.fetch_add(t.arp, std::memory_order_relaxed);
+        c.arpTrusted.fetch_add(t.arpTrusted, std::memory_order_relaxed);
+        c.ipv4.fetch_add(t.ipv4, std::memory_order_relaxed);
+        c.ipv6.fetch_add(t.ipv6, std::memory_order_relaxed);
+        c.other.fetch_add(t.other, std::memory_order_relaxed);
+        c.malformed.fetch_add(t.malformed, std::memory_order_relaxed);
+        c.blocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RawPacketProbe::collectKernelStats(Worker& w) {
+        if (w.xsk) {
+            // Az XDP_STATISTICS kumulatív: felülírjuk, nem összegzünk
+            if (w.xsk->fd() < 0) return;
+            XskKernelStats xs = w.xsk->kernelStats();
+            w.counters.ringDrops.store(xs.rxDropped + xs.rxRingFull, std::memory_order_relaxed);
+            w.counters.ringFreezes.store(xs.fillRingEmpty, std::memory_order_relaxed);
+            return;
+        }
+        // A PACKET_STATISTICS olvasása nullázza a kernel számlálóit: mi összegzünk
+        tpacket_stats_v3 st{};
+        socklen_t len = sizeof(st);
+        if (getsockopt(w.fd, SOL_PACKET, PACKET_STATISTICS, &st, &len) != 0) return;
+        w.counters.ringDrops.fetch_add(st.tp_drops, std::memory_order_relaxed);
+        w.counters.ringFreezes.fetch_add(st.tp_freeze_q_cnt, std::memory_order_relaxed);
+    }
+
+    RawCaptureStats RawPacketProbe::stats() const {
+        RawCaptureStats s;
+        for (const auto& w : workers) {
+            const auto& c = w->counters;
+            s.packets += c.packets.load(std::memory_order_relaxed);
+            s.bytes += c.bytes.load(std::memory_order_relaxed);
+            s.arp += c.arp.load(std::memory_order_relaxed);
+            s.arpTrusted += c.arpTrusted.load(std::memory_order_relaxed);
+            s.ipv4 += c.ipv4.load(std::memory_order_relaxed);
+            s.ipv6 += c.ipv6.load(std::memory_order_relaxed);
+            s.other += c.other.load(std::memory_order_relaxed);
+            s.malformed += c.malformed.load(std::memory_order_relaxed);
+            s.ringDrops += c.ringDrops.load(std::memory_order_relaxed);
+            s.ringFreezes += c.ringFreezes.load(std::memory_order_relaxed);
+            s.blocks += c.blocks.load(std::memory_order_relaxed);
         }
+        s.workers = static_cast<uint32_t>(workers.size());
+        s.mode = mode;
+        s.zeroCopy = !workers.empty() && workers.front()->xsk && workers.front()->xsk->zeroCopy();
+        return s;
     }
 
 } // namespace Venom::Core
@@ -3,13 +3,15 @@
 #include "core/ebpf/BpfLoader.hpp"
 #include "core/VisualMemory.hpp"
 #include <iostream>
-#include <bpf/bpf.h>
+#include "core/NetAddress.hpp"
 
 namespace Venom::Core {
-    Scheduler::Scheduler() {
-        vent_scheduler = rxcpp::schedulers::make_event_loop();
-        cortex_scheduler = rxcpp::schedulers::make_new_thread();
-        null_scheduler = rxcpp::schedulers::make_current_thread();
+    Scheduler::Scheduler(unsigned workers) : pool(std::make_unique<WorkStealingPool>(workers)) {
+        // Az event_loop / new_thread mutex + condvar sora helyett: közös pool, a cortex döntései
+        // előzik a vent pontozását, a null-tartomány háttérmunkája csak a maradék időt kapja
+        vent_scheduler = pool->scheduler(WorkStealingPool::Priority::NORMAL);
+        cortex_scheduler = pool->scheduler(WorkStealingPool::Priority::HIGH);
+        null_scheduler = pool->scheduler(WorkStealingPool::Priority::LOW);
     }
 
     Scheduler::~Scheduler() {
@@ -20,15 +22,26 @@ namespace Venom::Core {
         if (running) return;
         running = true;
 
-        int fd = loader.get_map_fd("blacklist_map");
-
-        vmem.set_blocking_callback([fd, &bus](uint32_t bad_ip) {
-            if (fd >= 0) {
-                uint8_t blocked = 1;
-                bpf_map_update_elem(fd, &bad_ip, &blocked, BPF_ANY);
+        SourceId cortexSource = bus.registerSource("CORTEX");
+
+        // A tiltás a BpfLoader sorába kerül: egy hullám IP-i egy batch hívással íródnak ki
+        auto block = [&loader, &bus, cortexSource](const NetAddress& bad_ip) {
+            loader.queueBlock(bad_ip);
+            // Cím -> szöveg veremben, az összefűzés a pool-blokkban történik
+            char text[INET6_ADDRSTRLEN] = {};
+            if (bad_ip.isV4()) {
+                inet_ntop(AF_INET, &bad_ip.bytes[12], text, sizeof(text));
+            } else {
+                inet_ntop(AF_INET6, bad_ip.bytes, text, sizeof(text));
             }
-            // Két paraméter: source és data a VenomBus.hpp szerint
-            bus.pushEvent("CORTEX", "NULL_ROUTE: IP_BLOCKED: " + std::to_string(bad_ip));
+            bus.pushEvent(cortexSource, EventOrigin::CORTEX, {"NULL_ROUTE: IP_BLOCKED: ", std::string_view(text)});
+        };
+        vmem.set_blocking_callback(block);
+        // A busz partíciói a saját forrásonkénti strike-jaik alapján kérnek tiltást; a döntés a
+        // cortex workeren (HIGH) fut, nem a partíció pontozó körében
+        cortex_worker = cortex_scheduler.create_worker(lifetime);
+        bus.setSourceBlockCallback([this, block](const NetAddress& bad_ip) {
+            cortex_worker.schedule([block, bad_ip](const rxcpp::schedulers::schedulable&) { block(bad_ip); });
         });
 
         std::cout << "[Scheduler] Bridge Active. Kernel + User-Space sync OK." << std::endl;
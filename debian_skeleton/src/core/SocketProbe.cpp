@@ -12,51 +12,169 @@
 #include <sys/time.h>
 #include <netinet/in.h>
 #include <thread>
+#include <algorithm>
+#include <sched.h>
 
 namespace Venom::Core {
 
+    // Egy kapcsolat legfeljebb ennyi ideig / bájtig tartja az accept ciklust
+    constexpr auto STREAM_DEADLINE = std::chrono::seconds(2);
+    constexpr uint64_t STREAM_BUDGET_BYTES = 64 * 1024;
+
     SocketProbe::SocketProbe(VenomBus& vBus, int listenPort, LogLevel level) 
-        : bus(vBus), serverFd(-1), port(listenPort), keepRunning(false), currentLogLevel(level) {}
+        : bus(vBus), serverFd(-1), port(listenPort), keepRunning(false), currentLogLevel(level) {
+        // A forrásnév egyszer internálódik, nem eseményenként fűzzük össze
+        sourceId = bus.registerSource("NET_SOCKET_" + std::to_string(port));
+    }
 
     SocketProbe::~SocketProbe() {
         stop();
     }
 
-    void SocketProbe::start() {
-        if (keepRunning) return;
-
-        serverFd = socket(AF_INET, SOCK_STREAM, 0);
-        if (serverFd < 0) return;
+    int SocketProbe::openListener(bool reusePort) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
 
         int opt = 1;
-        setsockopt(serverFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        if (reusePort) {
+            // A kernel a 4-tuple hash alapján osztja szét a bejövő kapcsolatokat a shardok között
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+        }
 
         struct sockaddr_in address{};
         address.sin_family = AF_INET;
         address.sin_addr.s_addr = INADDR_ANY;
         address.sin_port = htons(port);
 
-        if (bind(serverFd, (struct sockaddr*)&address, sizeof(address)) < 0) {
-            close(serverFd);
-            serverFd = -1;
-            return;
+        if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 ||
+            listen(fd, SOMAXCONN) < 0) {
+            close(fd);
+            return -1;
         }
 
-        if (listen(serverFd, 128) < 0) {
-            close(serverFd);
-            return;
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        return fd;
+    }
+
+    bool SocketProbe::startShards() {
+        // Csak az engedélyezett CPU-kra pinelünk (cgroup / taskset korlátozás)
+        std::vector<int> cpus;
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int c = 0; c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+            }
         }
+        if (cpus.empty()) cpus.push_back(-1);
 
-        fcntl(serverFd, F_SETFL, O_NONBLOCK);
+        size_t count = workerCount ? workerCount : cpus.size();
+        count = std::min<size_t>(count, TELEMETRY_MAX_SHARDS);
+
+        for (size_t i = 0; i < count; ++i) {
+            auto shard = std::make_unique<Shard>();
+            shard->fd = openListener(true);
+            if (shard->fd < 0) {
+                stopShards();
+                return false;
+            }
+
+            if (i >= shardLanes.size()) shardLanes.push_back(bus.openLane());
+            shard->lane = shardLanes[i];
+
+            ReactorOptions options;
+            options.workers = 1;
+            options.maxConnections = (maxConnections + count - 1) / count;
+            options.lane = shard->lane;
+            options.cpu = cpus[i % cpus.size()];
+
+            shard->reactor = std::make_unique<EpollReactor>(bus, sourceId, shard->fd, shard->counters, options);
+            if (!shard->reactor->start()) {
+                close(shard->fd);
+                stopShards();
+                return false;
+            }
+            shards.push_back(std::move(shard));
+        }
+        return true;
+    }
+
+    void SocketProbe::stopShards() {
+        for (auto& shard : shards) {
+            if (shard->reactor) shard->reactor->stop();
+            if (shard->fd >= 0) close(shard->fd);
+        }
+        shards.clear();
+    }
+
+    void SocketProbe::start() {
+        if (keepRunning) return;
+
+        if (backend == IngressBackend::EPOLL_REUSEPORT && !startShards()) {
+            // SO_REUSEPORT nélküli környezet: egyetlen listen socket, közös reaktor
+            backend = IngressBackend::EPOLL;
+        }
+
+        if (backend == IngressBackend::IO_URING && !UringReactor::supported()) {
+            backend = IngressBackend::EPOLL;
+        }
+
+        if (backend != IngressBackend::EPOLL_REUSEPORT) {
+            serverFd = openListener(false);
+            if (serverFd < 0) return;
+        }
+
+        if (backend == IngressBackend::IO_URING) {
+            ReactorOptions options;
+            options.workers = workerCount ? workerCount : std::max(1u, std::thread::hardware_concurrency());
+            options.maxConnections = maxConnections;
+            uringReactor = std::make_unique<UringReactor>(bus, sourceId, serverFd, counters, options);
+            if (!uringReactor->start()) {
+                uringReactor.reset();
+                backend = IngressBackend::EPOLL;
+            }
+        }
+
+        if (backend == IngressBackend::EPOLL) {
+            ReactorOptions options;
+            options.workers = workerCount ? workerCount : std::max(1u, std::thread::hardware_concurrency());
+            options.maxConnections = maxConnections;
+            reactor = std::make_unique<EpollReactor>(bus, sourceId, serverFd, counters, options);
+            if (!reactor->start()) {
+                // Nincs epoll (pl. régi kernel EPOLLEXCLUSIVE nélkül): vissza a régi ciklusra
+                reactor.reset();
+                backend = IngressBackend::LEGACY_ACCEPT;
+            }
+        }
 
         keepRunning = true;
-        workerThread = std::thread(&SocketProbe::listenLoop, this);
+        if (backend == IngressBackend::LEGACY_ACCEPT) {
+            workerThread = std::thread(&SocketProbe::listenLoop, this);
+        }
         
         if (currentLogLevel != LogLevel::SILENT) {
-            std::cout << "[SocketProbe] Vadászterület megnyitva a porton: " << port << std::endl;
+            std::cout << "[SocketProbe] Vadászterület megnyitva a porton: " << port;
+            if (!shards.empty()) std::cout << " (" << shards.size() << " SO_REUSEPORT shard)";
+            std::cout << std::endl;
         }
     }
 
+    IngressStats SocketProbe::stats() const {
+        IngressStats s;
+        auto add = [&s](const IngressCounters& c) {
+            s.accepted += c.accepted.load(std::memory_order_relaxed);
+            s.closed += c.closed.load(std::memory_order_relaxed);
+            s.bytes += c.bytes.load(std::memory_order_relaxed);
+            s.rejected += c.rejected.load(std::memory_order_relaxed);
+            s.shed += c.shed.load(std::memory_order_relaxed);
+        };
+        add(counters);
+        for (const auto& shard : shards) add(shard->counters);
+        s.shards = static_cast<uint32_t>(shards.size());
+        return s;
+    }
+
     void SocketProbe::listenLoop() {
         struct timeval tcpTimeout{1, 0}; 
 
@@ -70,27 +188,55 @@ namespace Venom::Core {
                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
                 continue;
             }
+            if (!bus.admitsConnections()) {
+                counters.shed.fetch_add(1, std::memory_order_relaxed);
+                close(clientFd);
+                continue;
+            }
+            counters.accepted.fetch_add(1, std::memory_order_relaxed);
 
             setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tcpTimeout, sizeof(tcpTimeout));
 
+            // A kapcsolat nyitva marad, amíg adat jön: minden darab a kapcsolat csúszóablakát
+            // frissíti, így a sok apró írásra bontott bináris payload is magas entrópiát mutat.
+            NetAddress peer = NetAddress::fromV4(clientAddr.sin_addr.s_addr);
+            streamEntropy.reset();
+            auto deadline = std::chrono::steady_clock::now() + STREAM_DEADLINE;
+
             char buffer[2048];
-            ssize_t valRead = read(clientFd, buffer, sizeof(buffer));
-            
-            if (valRead > 0) {
-                // Aszinkron beküldés, hogy ne akassza meg az accept() ciklust
-                std::string eventData(buffer, valRead);
-                std::thread([this, eventData]() {
-                    bus.pushEvent("NET_SOCKET_" + std::to_string(port), eventData);
-                }).detach();
+            ssize_t valRead;
+            while (keepRunning && (valRead = read(clientFd, buffer, sizeof(buffer))) > 0) {
+                std::string_view chunk(buffer, static_cast<size_t>(valRead));
+                streamEntropy.update(chunk);
+                counters.bytes.fetch_add(static_cast<uint64_t>(valRead), std::memory_order_relaxed);
+
+                // A lock-free ingress nem blokkol: közvetlen, másolás- és szálmentes beküldés
+                bus.pushEvent(sourceId, EventOrigin::NETWORK, chunk, EVENT_FLAG_STREAM, &peer,
+                              static_cast<float>(streamEntropy.entropy()));
+
+                if (streamEntropy.totalBytes() >= STREAM_BUDGET_BYTES ||
+                    std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
             }
             
             close(clientFd);
+            counters.closed.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
     void SocketProbe::stop() {
         if (!keepRunning) return;
         keepRunning = false;
+        if (reactor) {
+            reactor->stop();
+            reactor.reset();
+        }
+        if (uringReactor) {
+            uringReactor->stop();
+            uringReactor.reset();
+        }
+        stopShards();
         if (workerThread.joinable()) {
             workerThread.join();
         }
@@ -0,0 +1,37 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/SourceRegistry.hpp"
+
+namespace Venom::Core {
+
+    SourceId SourceRegistry::find(std::string_view name) const {
+        SourceId n = count.load(std::memory_order_acquire);
+        for (SourceId i = 0; i < n; ++i) {
+            if (names[i] == name) return i;
+        }
+        return INVALID;
+    }
+
+    SourceId SourceRegistry::intern(std::string_view name) {
+        SourceId id = find(name);
+        if (id != INVALID) return id;
+
+        std::lock_guard<std::mutex> lock(writeMutex);
+        id = find(name); // Újraellenőrzés: közben más szál is regisztrálhatta
+        if (id != INVALID) return id;
+
+        SourceId n = count.load(std::memory_order_relaxed);
+        if (n >= MAX_SOURCES) return INVALID;
+
+        names[n].assign(name.data(), name.size());
+        count.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    std::string_view SourceRegistry::name(SourceId id) const {
+        if (id >= count.load(std::memory_order_acquire)) return std::string_view("UNKNOWN");
+        return names[id];
+    }
+
+} // namespace Venom::Core
@@ -2,8 +2,7 @@
 // White-Venom Security Framework
 
 #include "core/StreamProbe.hpp"
-#include <map>
-#include <cmath>
+#include "core/EntropyEngine.hpp"
 #include <algorithm>
 
 namespace Venom::Core {
@@ -11,60 +10,83 @@ namespace Venom::Core {
     /**
      * @brief Shannon-entrópia számítása az adatfolyamon.
      * Segít megkülönböztetni a strukturált szöveget a titkosított/bináris zajtól.
+     * A számítást az EntropyEngine végzi (c*log2(c) tábla, egymásba fűzött al-hisztogramok).
      */
-    double StreamProbe::calculateEntropy(const std::string& data) {
-        if (data.empty()) {
-            return 0.0;
-        }
-
-        std::map<unsigned char, size_t> frequencies;
-        for (unsigned char c : data) {
-            frequencies[c]++;
-        }
-
-        double entropy = 0.0;
-        for (auto const& [val, count] : frequencies) {
-            double p = static_cast<double>(count) / data.size();
-            entropy -= p * std::log2(p);
-        }
-
-        return entropy;
+    double StreamProbe::calculateEntropy(std::string_view data) {
+        return EntropyEngine::compute(data);
     }
 
     /**
      * @brief Zero-Trust alapú típusdetektálás.
      * Ha az entrópia túl magas a profilhoz képest, az adatot gyanúsnak jelöljük.
      */
-    DataType StreamProbe::detectZeroTrust(const std::string& data, SecurityProfile profile) {
+    DataType StreamProbe::detectZeroTrust(std::string_view data, SecurityProfile profile) {
+        return classify(data, profile).type;
+    }
+
+    StreamVerdict StreamProbe::classify(std::string_view data, SecurityProfile profile) {
+        StreamVerdict verdict;
+        StreamFeatures& f = verdict.features;
+        f.length = data.size();
+
         if (data.empty()) {
-            return DataType::UNKNOWN;
+            return verdict; // UNKNOWN
         }
 
-        // 1. Bináris jelleg ellenőrzése (nem nyomtatható karakterek aránya)
-        size_t nonPrintable = 0;
+        // 1. Egyetlen bejárás: hisztogram + UTF-8 állapotgép
+        uint32_t hist[256] = {};
+        unsigned need = 0;
+        unsigned char lo = 0x80, hi = 0xBF;
+        bool utf8 = true;
+
         for (unsigned char c : data) {
-            if (c < 32 && c != '\n' && c != '\r' && c != '\t') {
-                nonPrintable++;
+            hist[c]++;
+            if (!utf8 || (need == 0 && c < 0x80)) continue;
+
+            if (need == 0) {
+                lo = 0x80; hi = 0xBF;
+                if (c >= 0xC2 && c <= 0xDF)      { need = 1; }
+                else if (c == 0xE0)              { need = 2; lo = 0xA0; }
+                else if (c == 0xED)              { need = 2; hi = 0x9F; }
+                else if (c >= 0xE1 && c <= 0xEF) { need = 2; }
+                else if (c == 0xF0)              { need = 3; lo = 0x90; }
+                else if (c >= 0xF1 && c <= 0xF3) { need = 3; }
+                else if (c == 0xF4)              { need = 3; hi = 0x8F; }
+                else                             { utf8 = false; }
+            } else if (c < lo || c > hi) {
+                utf8 = false;
+            } else {
+                --need;
+                lo = 0x80; hi = 0xBF;
             }
         }
+        f.utf8Valid = utf8 && need == 0;
+
+        // 2. Minden további jellemző a hisztogramból jön, nem a payloadból
+        size_t nonPrintable = 0;
+        for (unsigned c = 0; c < 32; ++c) {
+            if (!isControlCharacter(static_cast<unsigned char>(c))) continue;
+            nonPrintable += hist[c];
+        }
+        f.controlRatio = static_cast<double>(nonPrintable) / data.size();
+        f.hasOpenBrace = hist[static_cast<unsigned char>('{')] != 0;
+        f.hasCloseBrace = hist[static_cast<unsigned char>('}')] != 0;
+        f.hasColon = hist[static_cast<unsigned char>(':')] != 0;
+        f.entropy = EntropyEngine::fromHistogram(hist, data.size());
 
-        double entropy = calculateEntropy(data);
-        
         // Küszöbértékek a biztonsági profil alapján
         double threshold = (profile == SecurityProfile::HIGH) ? 5.8 : 6.8;
 
-        if (entropy > threshold || (static_cast<double>(nonPrintable) / data.size() > 0.3)) {
-            return DataType::BINARY;
-        }
-
-        // 2. Formátum felismerés (egyszerűsített JSON/Text döntés)
-        if (data.find('{') != std::string::npos && data.find('}') != std::string::npos) {
-            if (data.find(':') != std::string::npos) {
-                return DataType::JSON;
-            }
+        if (f.entropy > threshold || f.controlRatio > 0.3) {
+            verdict.type = DataType::BINARY;
+        } else if (f.hasOpenBrace && f.hasCloseBrace && f.hasColon) {
+            // Formátum felismerés (egyszerűsített JSON/Text döntés)
+            verdict.type = DataType::JSON;
+        } else {
+            verdict.type = DataType::TEXT;
         }
 
-        return DataType::TEXT;
+        return verdict;
     }
 
 } // namespace Venom::Core
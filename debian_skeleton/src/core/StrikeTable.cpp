@@ -0,0 +1,234 @@
+#include "core/StrikeTable.hpp"
+#include <algorithm>
+#include <thread>
+#include <time.h>
+
+namespace Venom::Core {
+
+namespace {
+    constexpr unsigned SHARD_SHIFT = 56;   // A hash felső 8 bitje a shard (SHARDS = 256)
+
+    constexpr uint32_t strikesOf(uint64_t state) { return static_cast<uint32_t>(state >> 40); }
+    constexpr uint32_t genOf(uint64_t state) { return static_cast<uint32_t>(state >> 32) & 0xff; }
+    constexpr StrikeTable::Tick stampOf(uint64_t state) { return static_cast<StrikeTable::Tick>(state); }
+    constexpr uint64_t pack(uint32_t strikes, uint32_t gen, StrikeTable::Tick stamp) {
+        return (static_cast<uint64_t>(strikes) << 40) | (static_cast<uint64_t>(gen & 0xff) << 32) | stamp;
+    }
+
+    // A slot-index a hash alsó, a tag a középső bitjeiből: a kettő független (0 = nincs tag)
+    uint32_t tagOf(uint64_t h) { return static_cast<uint32_t>(h >> 24) | 1u; }
+
+    size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+}
+
+    StrikeTable::StrikeTable(size_t capacity, std::chrono::milliseconds halfLifeMs)
+        : shardSlots(roundUpPow2(std::max<size_t>(EVICT_CANDIDATES, (capacity + SHARDS - 1) / SHARDS * 4 / 3))),
+          shardLimit(shardSlots * 3 / 4),
+          halfLife(halfLifeMs.count() > 0 ? std::max<Tick>(1, ticks(halfLifeMs)) : 0) {
+        slots.reset(new Slot[shardSlots * SHARDS]);
+        shards.reset(new Shard[SHARDS]);
+    }
+
+    StrikeTable::~StrikeTable() = default;
+
+    StrikeTable::Tick StrikeTable::now() {
+        // A COARSE óra a vDSO adatlapjából olvas (nincs rdtsc): a 100 ms-os Tick-hez bőven
+        // elég, és nem sorosítja a strike út egymást követő cache-miss-eit
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+        const uint64_t ms = static_cast<uint64_t>(ts.tv_sec) * 1000 + static_cast<uint64_t>(ts.tv_nsec) / 1000000;
+        return static_cast<Tick>(ms / static_cast<uint64_t>(TICK.count()));
+    }
+
+    uint64_t StrikeTable::decay(uint64_t state, Tick at) const {
+        if (halfLife == 0) return state;
+        const uint32_t n = strikesOf(state);
+        if (n == 0) return pack(0, genOf(state), at);
+        const Tick elapsed = at - stampOf(state);
+        // Egy másik szál kicsit korábbi "most"-ja (vagy explicit régebbi idő): nincs bomlás
+        if (static_cast<int32_t>(elapsed) <= 0) return state;
+        const uint32_t periods = elapsed / halfLife;
+        if (periods == 0) return state;
+        const uint32_t left = periods >= 24 ? 0 : n >> periods;
+        return pack(left, genOf(state), left ? stampOf(state) + periods * halfLife : at);
+    }
+
+    StrikeTable::Found StrikeTable::find(const NetAddress& addr, uint64_t h) const {
+        const size_t base = (h >> SHARD_SHIFT) * shardSlots;
+        const size_t mask = shardSlots - 1;
+        const uint32_t tag = tagOf(h);
+        const uint64_t khi = addr.hi();
+        const uint64_t klo = addr.lo();
+
+        // A töltöttségi korlát miatt mindig van üres slot, a próba ott véget ér
+        for (size_t p = 0; p < shardSlots; ++p) {
+            Slot& s = slots[base + ((h + p) & mask)];
+            for (;;) {
+                const uint32_t s1 = s.seq.load(std::memory_order_acquire);
+                if (s1 & 1) { std::this_thread::yield(); continue; }
+                const uint32_t t = s.tag.load(std::memory_order_relaxed);
+                const bool match = t == tag && s.hi.load(std::memory_order_relaxed) == khi &&
+                                   s.lo.load(std::memory_order_relaxed) == klo;
+                const uint64_t state = s.state.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != s1) continue;   // Közben átírták
+                if (t == 0) return {};   // Üres slot: a cím nincs bent
+                if (match) return {&s, s1, state};
+                break;
+            }
+        }
+        return {};
+    }
+
+    uint32_t StrikeTable::bump(Slot& s, uint32_t seq, uint64_t cur, Tick at) {
+        for (;;) {
+            // A slot közben más címé lett: a hívó újrakeres (a generáció miatt a CAS sem sikerülne)
+            if (s.seq.load(std::memory_order_acquire) != seq) return 0;
+            const uint64_t d = decay(cur, at);
+            uint32_t n = strikesOf(d);
+            if (n < MAX_STRIKES) n++;
+            const uint64_t next = pack(n, genOf(d), stampOf(d));
+            if (s.state.compare_exchange_weak(cur, next, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed)) {
+                return n;
+            }
+        }
+    }
+
+    uint32_t StrikeTable::strike(const NetAddress& addr, Tick at) {
+        if (addr.empty()) return 0;
+        const uint64_t h = addr.hash();
+        for (;;) {
+            Found f = find(addr, h);
+            if (!f.slot) return insert(addr, h, at);
+            if (uint32_t n = bump(*f.slot, f.seq, f.state, at)) return n;
+        }
+    }
+
+    uint64_t StrikeTable::lockSlot(Slot& s) {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        // A generáció léptetése: a régi tartalomra szánt CAS-ok innentől elbuknak
+        return s.state.fetch_add(uint64_t(1) << 32, std::memory_order_acq_rel);
+    }
+
+    void StrikeTable::unlockSlot(Slot& s) {
+        s.seq.store(s.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint32_t StrikeTable::insert(const NetAddress& addr, uint64_t h, Tick at) {
+        Shard& shard = shards[h >> SHARD_SHIFT];
+        std::lock_guard<std::mutex> lock(shard.insertMtx);
+
+        // Közben egy másik szál beszúrhatta; a zár alatt ebben a shardban nincs áthelyezés
+        Found f = find(addr, h);
+        if (f.slot) return bump(*f.slot, f.seq, f.state, at);
+
+        const size_t base = (h >> SHARD_SHIFT) * shardSlots;
+        const size_t mask = shardSlots - 1;
+        if (shard.entries.load(std::memory_order_relaxed) >= shardLimit) {
+            // Tele shard: a cím helyétől az első EVICT_CANDIDATES bejegyzés leggyengébbje megy
+            size_t victim = 0;
+            uint32_t weakest = UINT32_MAX;
+            size_t seen = 0;
+            for (size_t p = 0; p < shardSlots && seen < EVICT_CANDIDATES; ++p) {
+                const size_t idx = (h + p) & mask;
+                const Slot& s = slots[base + idx];
+                if (s.tag.load(std::memory_order_relaxed) == 0) continue;
+                seen++;
+                const uint32_t n = strikesOf(decay(s.state.load(std::memory_order_relaxed), at));
+                if (n < weakest) {
+                    weakest = n;
+                    victim = idx;
+                }
+            }
+            removeAt(base, victim);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        size_t p = 0;
+        while (slots[base + ((h + p) & mask)].tag.load(std::memory_order_relaxed) != 0) ++p;
+        Slot& target = slots[base + ((h + p) & mask)];
+
+        // Seqlock írás: páratlan seq alatt az olvasók újrapróbálnak
+        const uint64_t old = lockSlot(target);
+        target.tag.store(tagOf(h), std::memory_order_relaxed);
+        target.hi.store(addr.hi(), std::memory_order_relaxed);
+        target.lo.store(addr.lo(), std::memory_order_relaxed);
+        target.state.store(pack(1, genOf(old) + 1, at), std::memory_order_relaxed);
+        unlockSlot(target);
+
+        shard.entries.fetch_add(1, std::memory_order_relaxed);
+        shard.inserts.fetch_add(1, std::memory_order_relaxed);
+        return 1;
+    }
+
+    void StrikeTable::removeAt(size_t base, size_t index) {
+        const size_t mask = shardSlots - 1;
+        size_t hole = index;
+        uint64_t holeOld = lockSlot(slots[base + hole]);
+
+        for (size_t j = (hole + 1) & mask;; j = (j + 1) & mask) {
+            Slot& s = slots[base + j];
+            const uint32_t t = s.tag.load(std::memory_order_relaxed);
+            if (t == 0) break;
+            const uint64_t khi = s.hi.load(std::memory_order_relaxed);
+            const uint64_t klo = s.lo.load(std::memory_order_relaxed);
+            const size_t home = NetAddress::hashWords(khi, klo) & mask;
+            // Marad, ha a helye a (hole, j] körívre esik: a lyuk nem szakítja meg a próbasorát
+            const bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (stays) continue;
+
+            // j tartalma a lyukba; a közben futó CAS-ok a lezárt j-n elbuknak, a hívó újrakeres
+            const uint64_t moved = lockSlot(s);
+            Slot& d = slots[base + hole];
+            d.tag.store(t, std::memory_order_relaxed);
+            d.hi.store(khi, std::memory_order_relaxed);
+            d.lo.store(klo, std::memory_order_relaxed);
+            d.state.store(pack(strikesOf(moved), genOf(holeOld) + 1, stampOf(moved)), std::memory_order_relaxed);
+            unlockSlot(d);
+            hole = j;
+            holeOld = moved;
+        }
+
+        Slot& last = slots[base + hole];
+        last.tag.store(0, std::memory_order_relaxed);
+        unlockSlot(last);
+        shards[base / shardSlots].entries.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    uint32_t StrikeTable::strikes(const NetAddress& addr, Tick at) const {
+        if (addr.empty()) return 0;
+        Found f = find(addr, addr.hash());
+        return f.slot ? strikesOf(decay(f.state, at)) : 0;
+    }
+
+    void StrikeTable::clear() {
+        for (size_t i = 0; i < SHARDS; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i].insertMtx);
+            for (size_t j = 0; j < shardSlots; ++j) {
+                Slot& s = slots[i * shardSlots + j];
+                if (s.tag.load(std::memory_order_relaxed) == 0) continue;
+                lockSlot(s);
+                s.tag.store(0, std::memory_order_relaxed);
+                unlockSlot(s);
+            }
+            shards[i].entries.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    StrikeTableStats StrikeTable::stats() const {
+        StrikeTableStats st;
+        for (size_t i = 0; i < SHARDS; ++i) {
+            st.entries += shards[i].entries.load(std::memory_order_relaxed);
+            st.inserts += shards[i].inserts.load(std::memory_order_relaxed);
+            st.evictions += shards[i].evictions.load(std::memory_order_relaxed);
+        }
+        st.capacity = capacity();
+        return st;
+    }
+}
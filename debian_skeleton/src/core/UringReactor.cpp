@@ -0,0 +1,601 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/UringReactor.hpp"
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+// Multishot recv (6.0) a legújabb szükséges ABI-elem; régebbi fejlécnél a backend ki van kapcsolva
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+#define VENOM_HAVE_IO_URING 1
+#else
+#define VENOM_HAVE_IO_URING 0
+#endif
+
+namespace Venom::Core {
+
+#if VENOM_HAVE_IO_URING
+
+namespace {
+    constexpr unsigned SQ_ENTRIES = 1024;
+    constexpr unsigned CQ_ENTRIES = 8192;           // Multishot: egy SQE sok CQE-t szül
+    constexpr unsigned BUF_COUNT = 1024;            // Provided buffer ring (2^n)
+    constexpr unsigned BUF_SIZE = ConnectionLimits::READ_CHUNK;
+    constexpr uint16_t BUF_GROUP = 0;
+    constexpr int SWEEP_INTERVAL_MS = 250;
+    constexpr int ACCEPT_RETRY_MS = 10;
+
+    // user_data: [típus:8][generáció:24][index:32]
+    enum : uint64_t { OP_ACCEPT = 1, OP_RECV = 2, OP_CANCEL = 3, OP_CLOSE = 4, OP_WAKE = 5 };
+
+    uint64_t packUserData(uint64_t op, uint32_t generation, uint32_t index) {
+        return (op << 56) | (static_cast<uint64_t>(generation & 0xffffff) << 32) | index;
+    }
+    uint64_t opOf(uint64_t ud) { return ud >> 56; }
+    uint32_t generationOf(uint64_t ud) { return static_cast<uint32_t>((ud >> 32) & 0xffffff); }
+    uint32_t indexOf(uint64_t ud) { return static_cast<uint32_t>(ud); }
+
+    uint64_t nowMs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    int sysSetup(unsigned entries, io_uring_params* p) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+    }
+    int sysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, void* arg, size_t argSize) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+    int sysRegister(int fd, unsigned opcode, void* arg, unsigned nrArgs) {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+    }
+}
+
+    /**
+     * @brief Egy worker saját io_uring példánya: SQ/CQ leképezés + provided buffer ring.
+     * Csak a tulajdonos worker szál nyúl hozzá, ezért belül nincs zárolás.
+     */
+    struct UringReactor::Ring {
+        int fd = -1;
+
+        void* sqMap = MAP_FAILED;
+        size_t sqMapSize = 0;
+        void* cqMap = MAP_FAILED;
+        size_t cqMapSize = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqesSize = 0;
+
+        unsigned* sqHead = nullptr;
+        unsigned* sqTail = nullptr;
+        unsigned* sqArray = nullptr;
+        unsigned sqMask = 0;
+        unsigned sqEntries = 0;
+        unsigned localTail = 0;
+
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned cqMask = 0;
+        io_uring_cqe* cqes = nullptr;
+
+        io_uring_buf* bufRing = nullptr;
+        size_t bufRingSize = 0;
+        char* bufBase = nullptr;
+        uint16_t bufTail = 0;
+
+        bool setup() {
+            io_uring_params p{};
+            p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN;
+            p.cq_entries = CQ_ENTRIES;
+            fd = sysSetup(SQ_ENTRIES, &p);
+            if (fd < 0 && errno == EINVAL) {
+                // COOP_TASKRUN előtti kernel (< 5.19)
+                p = io_uring_params{};
+                p.flags = IORING_SETUP_CQSIZE;
+                p.cq_entries = CQ_ENTRIES;
+                fd = sysSetup(SQ_ENTRIES, &p);
+            }
+            if (fd < 0) return false;
+            if (!(p.features & IORING_FEAT_EXT_ARG)) return false; // időkorlátos várakozás kell
+
+            sqMapSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cqMapSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+            if (p.features & IORING_FEAT_SINGLE_MMAP) {
+                sqMapSize = cqMapSize = std::max(sqMapSize, cqMapSize);
+            }
+
+            sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sqMap == MAP_FAILED) return false;
+            if (p.features & IORING_FEAT_SINGLE_MMAP) {
+                cqMap = sqMap;
+            } else {
+                cqMap = mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+                if (cqMap == MAP_FAILED) return false;
+            }
+
+            sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+            void* sqeMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (sqeMap == MAP_FAILED) return false;
+            sqes = static_cast<io_uring_sqe*>(sqeMap);
+
+            char* sq = static_cast<char*>(sqMap);
+            sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+            sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+            sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+            sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+            sqEntries = p.sq_entries;
+            localTail = *sqTail;
+
+            char* cq = static_cast<char*>(cqMap);
+            cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+            return setupBuffers();
+        }
+
+        bool setupBuffers() {
+            bufRingSize = BUF_COUNT * sizeof(io_uring_buf);
+            void* ringMem = mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ringMem == MAP_FAILED) return false;
+            bufRing = static_cast<io_uring_buf*>(ringMem);
+
+            void* data = mmap(nullptr, static_cast<size_t>(BUF_COUNT) * BUF_SIZE, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (data == MAP_FAILED) return false;
+            bufBase = static_cast<char*>(data);
+
+            io_uring_buf_reg reg{};
+            reg.ring_addr = reinterpret_cast<uint64_t>(bufRing);
+            reg.ring_entries = BUF_COUNT;
+            reg.bgid = BUF_GROUP;
+            if (sysRegister(fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) return false;
+
+            for (unsigned i = 0; i < BUF_COUNT; ++i) recycle(static_cast<uint16_t>(i));
+            publishBuffers();
+            return true;
+        }
+
+        ~Ring() {
+            if (fd >= 0) close(fd); // A kernel minden függő kérést töröl
+            if (sqes) munmap(sqes, sqesSize);
+            if (cqMap != MAP_FAILED && cqMap != sqMap) munmap(cqMap, cqMapSize);
+            if (sqMap != MAP_FAILED) munmap(sqMap, sqMapSize);
+            if (bufBase) munmap(bufBase, static_cast<size_t>(BUF_COUNT) * BUF_SIZE);
+            if (bufRing) munmap(bufRing, bufRingSize);
+        }
+
+        unsigned unsubmitted() const {
+            return localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        }
+
+        io_uring_sqe* nextSqe() {
+            if (unsubmitted() >= sqEntries) {
+                // Tele az SQ: kötegelt beküldés várakozás nélkül
+                submitAndWait(0, 0);
+                if (unsubmitted() >= sqEntries) return nullptr;
+            }
+            unsigned idx = localTail & sqMask;
+            io_uring_sqe* sqe = &sqes[idx];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqArray[idx] = idx;
+            localTail++;
+            return sqe;
+        }
+
+        // Egyetlen io_uring_enter: az összes függő SQE beküldése + aratásra várás (időkorláttal)
+        void submitAndWait(unsigned waitNr, int timeoutMs) {
+            // A visszaadott pufferek a beküldés előtt láthatók legyenek: különben egy
+            // ENOBUFS után újraélesített recv azonnal újra ENOBUFS-ba futna
+            publishBuffers();
+            __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+            unsigned toSubmit = unsubmitted();
+            if (waitNr == 0) {
+                if (toSubmit) sysEnter(fd, toSubmit, 0, 0, nullptr, 0);
+                return;
+            }
+
+            __kernel_timespec ts{};
+            ts.tv_sec = timeoutMs / 1000;
+            ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000LL;
+            io_uring_getevents_arg arg{};
+            arg.sigmask = 0;
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+            sysEnter(fd, toSubmit, waitNr, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        }
+
+        const char* buffer(uint16_t bid) const {
+            return bufBase + static_cast<size_t>(bid) * BUF_SIZE;
+        }
+
+        void recycle(uint16_t bid) {
+            io_uring_buf& b = bufRing[bufTail & (BUF_COUNT - 1)];
+            b.addr = reinterpret_cast<uint64_t>(bufBase + static_cast<size_t>(bid) * BUF_SIZE);
+            b.len = BUF_SIZE;
+            b.bid = bid;
+            bufTail++;
+        }
+
+        void publishBuffers() {
+            // A ring tail-je az első bejegyzés resv mezőjén ül (io_uring_buf_ring ABI)
+            __atomic_store_n(&bufRing[0].resv, bufTail, __ATOMIC_RELEASE);
+        }
+    };
+
+    UringReactor::Worker::Worker() = default;
+    UringReactor::Worker::~Worker() = default;
+
+    bool UringReactor::supported() {
+        static const bool result = [] {
+            utsname u{};
+            int major = 0, minor = 0;
+            if (uname(&u) != 0 || std::sscanf(u.release, "%d.%d", &major, &minor) != 2) return false;
+            if (major < 6) return false; // multishot recv
+
+            // Valódi próba: a seccomp / io_uring_disabled is itt derül ki
+            Ring probe;
+            return probe.setup();
+        }();
+        return result;
+    }
+
+    UringReactor::UringReactor(VenomBus& vBus, SourceId source, int fd, IngressCounters& c,
+                               const ReactorOptions& options)
+        : bus(vBus), sourceId(source), listenFd(fd), wakeFd(-1),
+          lane(options.lane), cpu(options.cpu), counters(c) {
+        unsigned workerCount = options.workers ? options.workers : 1;
+        maxPerWorker = (options.maxConnections + workerCount - 1) / workerCount;
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    UringReactor::~UringReactor() {
+        stop();
+    }
+
+    bool UringReactor::start() {
+        if (running) return false;
+
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0) return false;
+
+        for (auto& w : workers) {
+            w->ring = std::make_unique<Ring>();
+            if (!w->ring->setup()) {
+                stop();
+                return false;
+            }
+        }
+
+        running = true;
+        for (auto& w : workers) {
+            Worker* wp = w.get();
+            wp->thread = std::thread([this, wp] { run(*wp); });
+        }
+        return true;
+    }
+
+    void UringReactor::stop() {
+        bool wasRunning = running.exchange(false);
+        if (wasRunning && wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+            // A gyűrű már nem fut: a maradék kapcsolatokat közvetlenül zárjuk
+            while (w->active) {
+                Connection* c = w->active;
+                if (c->fd >= 0) {
+                    close(c->fd);
+                    c->fd = -1;
+                    counters.closed.fetch_add(1, std::memory_order_relaxed);
+                }
+                c->recvArmed = false;
+                finishClose(*w, c);
+            }
+            w->ring.reset();
+            w->acceptArmed = w->wakeArmed = false;
+        }
+
+        if (wakeFd >= 0) { close(wakeFd); wakeFd = -1; }
+    }
+
+    void UringReactor::run(Worker& w) {
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+
+        Ring& ring = *w.ring;
+        armWake(w);
+        armAccept(w);
+        uint64_t lastSweep = nowMs();
+
+        while (running.load(std::memory_order_relaxed)) {
+            int timeout = w.acceptBackoff ? ACCEPT_RETRY_MS : SWEEP_INTERVAL_MS;
+            ring.submitAndWait(1, timeout);
+
+            // Aratás: a belépéskor látott CQ köteg, egyetlen head-frissítéssel. Az időközben
+            // érkezők a következő körre maradnak (az enter ilyenkor nem vár), így a stop-jelzés
+            // és az idle sweep sem éhezik ki tartós terhelés alatt.
+            unsigned head = *ring.cqHead;
+            const unsigned tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                const io_uring_cqe& cqe = ring.cqes[head & ring.cqMask];
+                uint64_t ud = cqe.user_data;
+                int res = cqe.res;
+                uint32_t flags = cqe.flags;
+                head++;
+
+                switch (opOf(ud)) {
+                    case OP_ACCEPT: onAccept(w, res, flags); break;
+                    case OP_RECV:   onRecv(w, ud, res, flags); break;
+                    case OP_WAKE:   w.wakeArmed = false; break;
+                    default: break; // CANCEL / CLOSE: nincs teendő
+                }
+            }
+            __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+
+            if (!w.wakeArmed && running.load(std::memory_order_relaxed)) armWake(w);
+            if (!w.acceptArmed) {
+                if (w.acceptBackoff) w.acceptBackoff = false; // egy várakozási kör kimaradt
+                else armAccept(w);
+            }
+
+            uint64_t now = nowMs();
+            if (now - lastSweep >= static_cast<uint64_t>(SWEEP_INTERVAL_MS)) {
+                sweepIdle(w, now);
+                lastSweep = now;
+            }
+        }
+    }
+
+    void UringReactor::armAccept(Worker& w) {
+        io_uring_sqe* sqe = w.ring->nextSqe();
+        if (!sqe) return;
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listenFd;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        sqe->user_data = packUserData(OP_ACCEPT, 0, 0);
+        w.acceptArmed = true;
+    }
+
+    void UringReactor::armWake(Worker& w) {
+        io_uring_sqe* sqe = w.ring->nextSqe();
+        if (!sqe) return;
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wakeFd;
+        sqe->poll32_events = POLLIN;
+        sqe->user_data = packUserData(OP_WAKE, 0, 0);
+        w.wakeArmed = true;
+    }
+
+    void UringReactor::armRecv(Worker& w, Connection* c) {
+        io_uring_sqe* sqe = w.ring->nextSqe();
+        if (!sqe) {
+            beginClose(w, c);
+            return;
+        }
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = c->fd;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUF_GROUP;
+        sqe->user_data = packUserData(OP_RECV, c->generation, c->index);
+        c->recvArmed = true;
+    }
+
+    UringReactor::Connection* UringReactor::obtain(Worker& w) {
+        if (!w.freeList.empty()) {
+            Connection* c = w.freeList.back();
+            w.freeList.pop_back();
+            return c;
+        }
+        w.storage.push_back(std::make_unique<Connection>());
+        w.storage.back()->index = static_cast<uint32_t>(w.storage.size() - 1);
+        w.freeList.reserve(w.storage.size());
+        return w.storage.back().get();
+    }
+
+    void UringReactor::onAccept(Worker& w, int res, uint32_t flags) {
+        if (!(flags & IORING_CQE_F_MORE)) {
+            // A multishot accept leállt (hiba vagy kernel-döntés): újraélesítés a kör végén
+            w.acceptArmed = false;
+            if (res == -EMFILE || res == -ENFILE || res == -ENOBUFS || res == -ENOMEM) {
+                w.acceptBackoff = true;
+            }
+        }
+        if (res < 0) return;
+
+        int fd = res;
+        const bool shed = !bus.admitsConnections();
+        if (!shed) {
+            counters.accepted.fetch_add(1, std::memory_order_relaxed);
+            bus.noteAccept(lane);
+        }
+
+        if (shed || w.live >= maxPerWorker) {
+            // NULL_ONLY alatt ugyanaz az azonnali zárás, mint a kapacitáson felüli kapcsolatnál
+            (shed ? counters.shed : counters.rejected).fetch_add(1, std::memory_order_relaxed);
+            io_uring_sqe* sqe = w.ring->nextSqe();
+            if (sqe) {
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = fd;
+                sqe->user_data = packUserData(OP_CLOSE, 0, 0);
+            } else {
+                close(fd);
+            }
+            return;
+        }
+
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        getpeername(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+        Connection* c = obtain(w);
+        c->fd = fd;
+        c->generation++;
+        c->state = ConnState::READING;
+        c->recvArmed = false;
+        c->peer = NetAddress::fromV4(addr.sin_addr.s_addr);
+        c->entropy.reset();
+        c->lastActivityMs = nowMs();
+
+        c->prev = nullptr;
+        c->next = w.active;
+        if (w.active) w.active->prev = c;
+        w.active = c;
+        w.live++;
+
+        armRecv(w, c);
+    }
+
+    void UringReactor::onRecv(Worker& w, uint64_t ud, int res, uint32_t flags) {
+        Ring& ring = *w.ring;
+        bool hasBuffer = (flags & IORING_CQE_F_BUFFER) != 0;
+        uint16_t bid = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+        uint32_t index = indexOf(ud);
+        Connection* c = (index < w.storage.size()) ? w.storage[index].get() : nullptr;
+        if (!c || c->generation != (generationOf(ud) & 0xffffff) || c->fd < 0) {
+            if (hasBuffer) ring.recycle(bid);
+            return;
+        }
+
+        if (res > 0 && hasBuffer) {
+            if (c->state == ConnState::READING) {
+                std::string_view chunk(ring.buffer(bid), static_cast<size_t>(res));
+                c->entropy.update(chunk);
+                c->lastActivityMs = nowMs();
+                counters.bytes.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+
+                // A pushEvent a pool-blokkba másol: a puffer azonnal visszaadható
+                bus.pushEvent(lane, sourceId, EventOrigin::NETWORK, chunk, EVENT_FLAG_STREAM, &c->peer,
+                              static_cast<float>(c->entropy.entropy()));
+            }
+            ring.recycle(bid);
+
+            if (c->state == ConnState::READING &&
+                c->entropy.totalBytes() >= ConnectionLimits::STREAM_BUDGET_BYTES) {
+                beginClose(w, c);
+            }
+        } else if (hasBuffer) {
+            ring.recycle(bid);
+        }
+
+        if (flags & IORING_CQE_F_MORE) return;
+
+        // A multishot recv befejeződött
+        c->recvArmed = false;
+        if (c->state == ConnState::READING && (res > 0 || res == -ENOBUFS)) {
+            armRecv(w, c); // Kifogyott / teli köteg: a kapcsolat él, újraélesítjük
+            return;
+        }
+        // EOF (0), hiba, vagy a mi cancel-ünk
+        c->state = ConnState::CLOSING;
+        finishClose(w, c);
+    }
+
+    void UringReactor::beginClose(Worker& w, Connection* c) {
+        if (c->state == ConnState::CLOSING && c->recvArmed) return; // cancel már úton
+        c->state = ConnState::CLOSING;
+
+        if (!c->recvArmed) {
+            finishClose(w, c);
+            return;
+        }
+
+        // A függő multishot recv hivatkozást tart a socketre: előbb törölni kell,
+        // a lezárás a recv utolsó (F_MORE nélküli) CQE-jénél történik
+        io_uring_sqe* sqe = w.ring->nextSqe();
+        if (!sqe) {
+            shutdown(c->fd, SHUT_RDWR); // Végső eset: a recv EOF-fal tér vissza
+            return;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = packUserData(OP_RECV, c->generation, c->index);
+        sqe->user_data = packUserData(OP_CANCEL, 0, 0);
+    }
+
+    void UringReactor::finishClose(Worker& w, Connection* c) {
+        if (c->fd >= 0) {
+            io_uring_sqe* sqe = w.ring ? w.ring->nextSqe() : nullptr;
+            if (sqe) {
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = c->fd;
+                sqe->user_data = packUserData(OP_CLOSE, 0, 0);
+            } else {
+                close(c->fd);
+            }
+            c->fd = -1;
+            counters.closed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (c->prev) c->prev->next = c->next;
+        else w.active = c->next;
+        if (c->next) c->next->prev = c->prev;
+        c->prev = c->next = nullptr;
+
+        w.live--;
+        w.freeList.push_back(c);
+    }
+
+    void UringReactor::sweepIdle(Worker& w, uint64_t now) {
+        Connection* c = w.active;
+        while (c) {
+            Connection* next = c->next;
+            if (c->state == ConnState::READING &&
+                now - c->lastActivityMs >= ConnectionLimits::IDLE_TIMEOUT_MS) {
+                beginClose(w, c);
+            }
+            c = next;
+        }
+    }
+
+#else // !VENOM_HAVE_IO_URING
+
+    // io_uring ABI nélküli fordítás: a SocketProbe mindig epollra esik vissza
+    struct UringReactor::Ring {};
+    UringReactor::Worker::Worker() = default;
+    UringReactor::Worker::~Worker() = default;
+
+    bool UringReactor::supported() { return false; }
+
+    UringReactor::UringReactor(VenomBus& vBus, SourceId source, int fd, IngressCounters& c,
+                               const ReactorOptions& options)
+        : bus(vBus), sourceId(source), listenFd(fd), wakeFd(-1), maxPerWorker(options.maxConnections),
+          lane(options.lane), cpu(options.cpu), counters(c) {}
+
+    UringReactor::~UringReactor() = default;
+    bool UringReactor::start() { return false; }
+    void UringReactor::stop() {}
+
+#endif // VENOM_HAVE_IO_URING
+
+} // namespace Venom::Core
@@ -1,65 +1,570 @@
 #include "core/VenomBus.hpp"
 #include "core/Scheduler.hpp"
-#include "core/StreamProbe.hpp"
 #include "core/NullScheduler.hpp"
+#include "core/StrikeTable.hpp"
+#include "core/WindowScorer.hpp"
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 
 namespace Venom::Core {
 
+    // Ennyi üres kör után parkol le a drain szál (yield-del pörög addig)
+    constexpr int DRAIN_SPIN_LIMIT = 64;
+    // A partícióválasztás saját hash-maggal: a partíción belüli StrikeTable shardjai (a
+    // NetAddress::hash felső bitjei) így nem csak a partíció címtartományát kapják
+    constexpr uint64_t PARTITION_SEED = 0x5851f42d4c957f2dull;
+
+    /**
+     * @brief Egy reaktív partíció: a forráscím-hash egy szelete. Minden tagját egyszerre csak
+     * egy szál írja (N = 1 esetén a drain szál, különben a vent scheduler egy rx workere, amely
+     * akciói soha nem futnak párhuzamosan); a számlálókat és az utolsó kiszűrt címet a
+     * pillanatkép fésüli össze.
+     */
+    struct VenomBus::Partition {
+        explicit Partition(size_t strikeCapacity, unsigned scoringWorkers)
+            : scorer(scoringWorkers), strikes(strikeCapacity) {}
+
+        rxcpp::subjects::subject<VentWindow> windows;
+        WindowScorer scorer;
+        StrikeTable strikes;    // Forrásonkénti strike-ok: csak a partíció ír bele
+
+        // N > 1: drain szál -> partíció gyűrű -> a vent workerre ütemezett drain-akció; a
+        // kritikus osztályok az urgent gyűrűben, amelyet az akció a hálózati ablak előtt ürít
+        MpscRing<VentEvent, PARTITION_RING_CAPACITY> ring;
+        MpscRing<VentEvent, PARTITION_URGENT_CAPACITY> urgent;
+        std::vector<VentEvent> window;
+        rxcpp::composite_subscription ventLifetime;   // A bus stop()-ja zárja, nem a hívó lifetime-ja
+        rxcpp::schedulers::worker vent;
+        rxcpp::schedulers::schedulable drainAction;   // Egyszer készül, újraütemezve nem allokál
+        std::atomic<bool> scheduled{false};           // A drain-akció sorban áll vagy fut
+        std::atomic<bool> busy{false};
+
+        // Ablakonként legfeljebb egyszer zárolva; a getLastFilteredIP olvassa
+        mutable std::mutex peerMutex;
+        NetAddress lastFiltered;
+        uint64_t lastFilteredNs = 0;
+
+        alignas(VENOM_CACHE_LINE) std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> accepted{0};
+        std::atomic<uint64_t> nullRouted{0};
+        std::atomic<uint64_t> windowCount{0};
+        std::atomic<uint64_t> sourceBlocks{0};
+        std::atomic<uint64_t> classEvents[QOS_CLASS_COUNT] = {};
+    };
+
     VenomBus::VenomBus() {
+        lanes[0] = std::make_unique<IngressRing>();
+        controlRing = std::make_unique<ControlRing>();
+        hostRing = std::make_unique<HostRing>();
+        buildPartitions(1);
         telemetry.reset_window();
-        last_filtered_ip = "";
     }
 
-    void VenomBus::pushEvent(const std::string& source, const std::string& data, bool isArp) {
+    VenomBus::~VenomBus() {
+        stop();
+    }
+
+    void VenomBus::buildPartitions(uint32_t count) {
+        for (auto& part : partitions) part.reset();
+        partitionCount = std::clamp<uint32_t>(count, 1, MAX_PARTITIONS);
+        // A strike-kapacitás a partíciók között oszlik meg (összesen a StrikeTable alapértéke)
+        const size_t strikeCapacity = StrikeTable::DEFAULT_CAPACITY / partitionCount;
+        for (uint32_t i = 0; i < partitionCount; ++i) {
+            partitions[i] = std::make_unique<Partition>(strikeCapacity, scoringWorkers);
+        }
+    }
+
+    void VenomBus::setScoringWorkers(unsigned workers) {
+        scoringWorkers = workers;
+        buildPartitions(partitionCount);
+    }
+
+    void VenomBus::setPartitions(unsigned count) {
+        buildPartitions(count);
+    }
+
+    uint32_t VenomBus::partitionOf(const NetAddress& peer) const {
+        if (partitionCount == 1) return 0;
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(peer.hash(PARTITION_SEED)) * partitionCount) >> 64);
+    }
+
+    rxcpp::observable<VentWindow> VenomBus::partitionStream(unsigned partition) const {
+        return partitions[std::min<unsigned>(partition, partitionCount - 1)]->windows.get_observable();
+    }
+
+    IngressLane VenomBus::openLane() {
+        std::lock_guard<std::mutex> lock(laneMutex);
+        uint32_t n = laneCount.load(std::memory_order_relaxed);
+        if (n >= MAX_LANES) return IngressLane{};
+
+        lanes[n] = std::make_unique<IngressRing>();
+        // A drain szál acquire-rel olvassa: a gyűrű már készen áll, mire látja
+        laneCount.store(n + 1, std::memory_order_release);
+        telemetry.shard_count.store(n);
+        return IngressLane{static_cast<uint8_t>(n)};
+    }
+
+    void VenomBus::noteAccept(IngressLane lane) {
+        if (lane.index == 0) return;
+        telemetry.shard_accepts[lane.index - 1].accepts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void VenomBus::noteKernelEvents(uint64_t received, uint64_t lostTotal) {
+        telemetry.kernel_events.fetch_add(received, std::memory_order_relaxed);
+        telemetry.kernel_events_lost.store(lostTotal, std::memory_order_relaxed);
+    }
+
+    bool VenomBus::ingressEmpty() const {
+        if (!controlRing->empty() || !hostRing->empty()) return false;
+        uint32_t n = laneCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < n; ++i) {
+            if (!lanes[i]->empty()) return false;
+        }
+        return true;
+    }
+
+    bool VenomBus::shedAtIngress(QosClass cls, BusState state) const {
+        // Csak a network osztály: a fájlrendszer- és cortex-események mindig bejutnak
+        if (cls != QosClass::NETWORK) return false;
+        if (state == BusState::NULL_ONLY) return true;
+        const OverloadPolicy& policy = overload.getPolicy();
+        const uint32_t keepOneIn = state == BusState::OVERLOAD ? policy.overloadKeepOneIn : policy.degradedKeepOneIn;
+        if (keepOneIn <= 1) return false;
+        // Szálanként számolt mintavétel: nincs közös számláló a producerek között
+        static thread_local uint32_t tick = 0;
+        return (++tick % keepOneIn) != 0;
+    }
+
+    bool VenomBus::reserveClass(QosClass cls) {
+        const size_t c = static_cast<size_t>(cls);
+        if (cls == QosClass::NETWORK) {
+            // A network kapacitása a pool foglaltságán mérve: egyetlen olvasás, nincs új közös
+            // számláló a hot path-on (a versengő producerek legfeljebb szálanként egyet lépnek túl)
+            return payloads.blocksInUse() < QOS_CAPACITY[c];
+        }
+        auto& q = telemetry.qos[c];
+        q.events.fetch_add(1, std::memory_order_relaxed);
+        if (q.inflight.fetch_add(1, std::memory_order_relaxed) < QOS_CAPACITY[c]) return true;
+        q.inflight.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void VenomBus::releaseClass(QosClass cls, uint32_t count) {
+        if (cls == QosClass::NETWORK || count == 0) return;
+        telemetry.qos[static_cast<size_t>(cls)].inflight.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    bool VenomBus::pushToClassRing(IngressLane lane, QosClass cls, VentEvent&& ev) {
+        switch (cls) {
+            case QosClass::CONTROL: return controlRing->tryPush(std::move(ev));
+            case QosClass::HOST_INTEGRITY: return hostRing->tryPush(std::move(ev));
+            case QosClass::NETWORK:
+            default: return lanes[lane.index]->tryPush(std::move(ev));
+        }
+    }
+
+    void VenomBus::pushEvent(IngressLane lane, SourceId source, EventOrigin origin,
+                             std::initializer_list<std::string_view> parts,
+                             uint8_t flags, const NetAddress* peer, float streamEntropy) {
         telemetry.total_events++;
+        const QosClass cls = qosOf(origin);
+        auto& qos = telemetry.qos[static_cast<size_t>(cls)];
+
+        // Tehermentesítés még a pool-blokk és a gyűrű előtt (a legolcsóbb ponton)
+        const BusState state = telemetry.state.load(std::memory_order_relaxed);
+        if (state != BusState::UP && shedAtIngress(cls, state)) {
+            telemetry.dropped_events++;
+            qos.shed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Elfogyott az osztály kapacitása: null-route, a többi osztály helye érintetlen
+        if (!reserveClass(cls)) {
+            telemetry.null_routed_events++;
+            qos.overflow.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        PayloadSlice payload = payloads.acquire(parts);
+        if (!payload.valid()) {
+            // Kimerült a pool plafonja: ez valódi eldobás, nem null-route
+            releaseClass(cls, 1);
+            telemetry.dropped_events++;
+            return;
+        }
+
+        VentEvent ev;
+        ev.header.timestampNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        ev.header.source = source;
+        ev.header.origin = origin;
+        ev.header.flags = flags;
+        if (peer) ev.header.peer = *peer;
+        ev.header.streamEntropy = streamEntropy;
+        ev.payload = std::move(payload);
+
         telemetry.queue_depth++;
-        
-        if (telemetry.queue_depth > 1000) {
+
+        // Tele gyűrű = null-route; a producer soha nem vár a consumerre
+        if (!pushToClassRing(lane, cls, std::move(ev))) {
+            releaseClass(cls, 1);
             telemetry.null_routed_events++;
             telemetry.queue_depth--;
+            qos.overflow.fetch_add(1, std::memory_order_relaxed);
             return;
         }
 
-        vent_bus.get_subscriber().on_next(VentEvent{source, data, isArp});
+        wakeDrain();
     }
 
-    void VenomBus::startReactive(rxcpp::composite_subscription& lifetime, const Scheduler& scheduler) {
-        (void)scheduler;
-        auto raw_stream = vent_bus.get_observable();
-
-        raw_stream
-            .window_with_time(std::chrono::milliseconds(200))
-            .subscribe_on(rxcpp::observe_on_new_thread())
-            .subscribe(lifetime, [this](rxcpp::observable<VentEvent> window) {
-                window.subscribe([this](VentEvent ev) {
-                    auto meta = telemetry.get_metabolism();
-                    double dynamicThreshold = 6.8 * (1.0 / (meta.loadFactor + 0.11));
-                    double entropy = StreamProbe::calculateEntropy(ev.payload);
-                    
-                    if (entropy > dynamicThreshold || ev.isArp) {
-                        NullScheduler::absorb(ev);
-                        telemetry.null_routed_events++;
-                        
-                        std::lock_guard<std::mutex> lock(ip_mutex);
-                        last_filtered_ip = ev.source;
-                    } else {
-                        telemetry.accepted_events++;
+    void VenomBus::pushEvent(const std::string& source, const std::string& data, bool isArp) {
+        pushEvent(sources.intern(source), EventOrigin::INTERNAL, std::string_view(data),
+                  isArp ? EVENT_FLAG_ARP : EVENT_FLAG_NONE);
+    }
+
+    void VenomBus::wakeDrain() {
+        // Dekker-párja a drainLoop parkolásának: push -> fence -> flag olvasás
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (drainParked.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(drainMutex);
+            drainCv.notify_one();
+        }
+    }
+
+    void VenomBus::drainLoop() {
+        // Az ablak puffere egyszer nő fel (sávonként DRAIN_BATCH), utána nem allokál
+        std::vector<VentEvent> window;
+        window.reserve(DRAIN_BATCH);
+        auto subscriber = partitions[0]->windows.get_subscriber();
+        const bool inline_ = partitionCount == 1;
+        int idleSpins = 0;
+        const uint64_t controlNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(OverloadController::CONTROL_INTERVAL).count());
+        uint64_t nextControlNs = 0;
+        uint32_t firstLane = 0;
+
+        while (draining.load(std::memory_order_relaxed)) {
+            const uint64_t nowNs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            if (nowNs >= nextControlNs) {
+                controlStep(nowNs);
+                nextControlNs = nowNs + controlNs;
+            }
+
+            auto collect = [&window](VentEvent&& ev) { window.push_back(std::move(ev)); };
+            // Kritikus osztályok elöl: N = 1 esetén az ablak elejére, különben közvetlenül a
+            // partíciók urgent gyűrűibe
+            const size_t urgent = inline_ ? drainCritical(collect) : 0;
+            bool moved = !inline_ && pumpCritical() > 0;
+
+            // Network: körbejárás a sávokon forgó kezdőponttal, a kvóta erejéig; egy forgalmas
+            // shard sem éheztetheti ki a többit
+            uint32_t n = laneCount.load(std::memory_order_acquire);
+            size_t budget = QOS_QUANTUM[static_cast<size_t>(QosClass::NETWORK)];
+            for (uint32_t k = 0; k < n && budget > 0; ++k) {
+                budget -= lanes[(firstLane + k) % n]->drainInto(collect, std::min(budget, DRAIN_BATCH));
+            }
+            firstLane = (firstLane + 1) % n;
+
+            if (!window.empty()) {
+                if (inline_) {
+                    // Egy partíció: a drain szál maga dolgozik; a kritikus osztályok külön, előbb
+                    // pontozott ablakban (a hálózati ablak nem késlelteti őket)
+                    if (urgent > 0) subscriber.on_next(VentWindow{window.data(), urgent});
+                    if (window.size() > urgent) {
+                        subscriber.on_next(VentWindow{window.data() + urgent, window.size() - urgent});
                     }
-                    
-                    if (telemetry.queue_depth > 0) telemetry.queue_depth--;
-                });
+                } else {
+                    // Sávon belüli sorrendben: egy forrás eseményei sorrendben érnek a partíciójába
+                    for (auto& ev : window) routeToPartition(std::move(ev), false);
+                }
+                window.clear();
+                moved = true;
+            }
+            if (moved) {
+                for (uint32_t p = 0; !inline_ && p < partitionCount; ++p) wakePartition(*partitions[p]);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < DRAIN_SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(drainMutex);
+            drainParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // Nem UP állapotban a vezérlőnek tétlenül is léptetnie kell (visszalépés)
+            const auto parkFor = telemetry.state.load(std::memory_order_relaxed) == BusState::UP
+                ? std::chrono::milliseconds(50) : OverloadController::CONTROL_INTERVAL;
+            drainCv.wait_for(lock, parkFor, [this] {
+                return !draining.load(std::memory_order_relaxed) || !ingressEmpty();
             });
-            
-        std::cout << "[VenomBus] Reaktív ablakozás élesítve (200ms Trixie-Sync). 🐍" << std::endl;
+            drainParked.store(false, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+    }
+
+    void VenomBus::controlStep(uint64_t nowNs) {
+        OverloadController::Sample sample;
+        sample.nowNs = nowNs;
+        sample.depth = telemetry.queue_depth.load(std::memory_order_relaxed);
+        sample.capacity = static_cast<uint32_t>(laneCount.load(std::memory_order_relaxed) * VENT_RING_CAPACITY +
+                                                CONTROL_RING_CAPACITY + HOST_RING_CAPACITY +
+                                                (partitionCount > 1 ? partitionCount * PARTITION_RING_CAPACITY : 0));
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            sample.drained += partitions[p]->events.load(std::memory_order_relaxed);
+        }
+        sample.maxSojournNs = telemetry.window_sojourn_ns.exchange(0, std::memory_order_relaxed);
+
+        const BusState before = overload.state();
+        const BusState after = overload.update(sample);
+        telemetry.overload_delay_us.store(static_cast<uint64_t>(overload.delayMs() * 1000.0), std::memory_order_relaxed);
+        telemetry.drain_rate.store(static_cast<uint64_t>(overload.drainRate()), std::memory_order_relaxed);
+        if (after == before) return;
+
+        telemetry.state.store(after, std::memory_order_relaxed);
+        telemetry.state_transitions.fetch_add(1, std::memory_order_relaxed);
+        if (on_state_change) on_state_change(after);
+    }
+
+    template<typename Sink>
+    size_t VenomBus::drainCritical(Sink&& sink) {
+        return controlRing->drainInto(sink, QOS_QUANTUM[static_cast<size_t>(QosClass::CONTROL)]) +
+               hostRing->drainInto(sink, QOS_QUANTUM[static_cast<size_t>(QosClass::HOST_INTEGRITY)]);
+    }
+
+    size_t VenomBus::pumpCritical() {
+        const size_t routed = drainCritical([this](VentEvent&& ev) { routeToPartition(std::move(ev), true); });
+        if (routed == 0) return 0;
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            if (!partitions[p]->urgent.empty()) wakePartition(*partitions[p]);
+        }
+        return routed;
+    }
+
+    void VenomBus::routeToPartition(VentEvent&& ev, bool urgent) {
+        Partition& part = *partitions[partitionOf(ev.header.peer)];
+        if (urgent) {
+            // Az urgent gyűrűt minden drain-akció elsőként üríti: a várakozás rövid
+            while (!part.urgent.tryPush(std::move(ev))) {
+                if (!draining.load(std::memory_order_relaxed)) return;
+                wakePartition(part);
+                std::this_thread::yield();
+            }
+            return;
+        }
+        // Tele partíció: nem dobunk (az ingress már befogadta), a drain szál vár; az ingress
+        // gyűrűk közben megtelnek, és a producerek oldalán null-route lesz belőle. A kritikus
+        // osztályok eközben is továbbjutnak
+        while (!part.ring.tryPush(std::move(ev))) {
+            if (!draining.load(std::memory_order_relaxed)) return;
+            wakePartition(part);
+            pumpCritical();
+            std::this_thread::yield();
+        }
+    }
+
+    void VenomBus::wakePartition(Partition& part) {
+        // Legfeljebb egy drain-akció áll sorban; a drainPartition a jelző törlése után újra
+        // megnézi a gyűrűt, így a közben érkezett esemény sem marad ott
+        if ((part.ring.empty() && part.urgent.empty()) || part.scheduled.load(std::memory_order_relaxed)) return;
+        if (!part.scheduled.exchange(true, std::memory_order_acq_rel)) {
+            part.vent.schedule(part.drainAction);
+        }
+    }
+
+    void VenomBus::drainPartition(Partition& part) {
+        part.busy.store(true, std::memory_order_relaxed);
+        // Akciónként legfeljebb két ablak (előbb a kritikus osztályoké, aztán egy hálózati kvóta):
+        // a pool közben a többi partíciót és a cortex feladatait is futtatja
+        auto collect = [&part](VentEvent&& ev) { part.window.push_back(std::move(ev)); };
+        auto emit = [&part] {
+            if (part.window.empty()) return;
+            part.windows.get_subscriber().on_next(VentWindow{part.window.data(), part.window.size()});
+            part.window.clear();
+        };
+        part.urgent.drainInto(collect, PARTITION_URGENT_CAPACITY);
+        emit();
+        part.ring.drainInto(collect, PARTITION_DRAIN_BATCH);
+        emit();
+
+        part.scheduled.store(false, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((!part.ring.empty() || !part.urgent.empty()) && !part.scheduled.exchange(true, std::memory_order_acq_rel)) {
+            part.vent.schedule(part.drainAction);
+        }
+        part.busy.store(false, std::memory_order_release);
+    }
+
+    void VenomBus::stop() {
+        if (!draining.exchange(false)) return;
+        {
+            std::lock_guard<std::mutex> lock(drainMutex);
+            drainCv.notify_all();
+        }
+        if (drainThread.joinable()) {
+            drainThread.join();
+        }
+        // A drain szál után a partíciók gyűrűibe már senki nem ír: a sorban álló és futó
+        // drain-akciók kifutnak, utána zárjuk a vent workereket
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            Partition& part = *partitions[p];
+            while (part.scheduled.load(std::memory_order_acquire) || part.busy.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            part.ventLifetime.unsubscribe();
+        }
+    }
+
+    void VenomBus::startReactive(rxcpp::composite_subscription& lifetime, const Scheduler& scheduler) {
+        // A window_with_time minden on_next-et a koordinátor workerére ütemezett (~5 heap
+        // allokáció/esemény), miközben az ablak-lambda csak továbbította az eseményt.
+        // Az ablakot a drain szál adja; N > 1 esetén a partíciók a vent scheduler (work-stealing
+        // pool, NORMAL osztály) egy-egy rx workerén futnak.
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            Partition* part = partitions[p].get();
+            part->windows.get_observable()
+                .subscribe(lifetime, [this, part](const VentWindow& window) { processWindow(*part, window); });
+        }
+
+        // A lánc él: indulhatnak a szálak (az addig gyűlt események sem vesznek el)
+        if (!draining.exchange(true)) {
+            if (partitionCount > 1) {
+                rxcpp::schedulers::scheduler ventScheduler = scheduler.getVentScheduler();
+                for (uint32_t p = 0; p < partitionCount; ++p) {
+                    Partition* part = partitions[p].get();
+                    part->window.reserve(PARTITION_RING_CAPACITY);
+                    part->vent = ventScheduler.create_worker(part->ventLifetime);
+                    part->drainAction = rxcpp::schedulers::make_schedulable(
+                        part->vent, [this, part](const rxcpp::schedulers::schedulable&) { drainPartition(*part); });
+                }
+            }
+            drainThread = std::thread(&VenomBus::drainLoop, this);
+        }
+
+        std::cout << "[VenomBus] Reaktív lánc élesítve (drain szál, " << partitionCount
+                  << " partíció a vent scheduleren, allokációmentes ingress). 🐍" << std::endl;
+    }
+
+    void VenomBus::processWindow(Partition& part, const VentWindow& window) {
+        // Ablakonként egyszer: a metabolizmus (óra + atomikus olvasások), a küszöb és az idő
+        auto meta = telemetry.get_metabolism();
+        double dynamicThreshold = 6.8 * (1.0 / (meta.loadFactor + 0.11));
+        // OVERLOAD felett nincs entrópia-pontozás: a küszöb a felső korlát, csak az ARP dönt
+        if (telemetry.state.load(std::memory_order_relaxed) >= BusState::OVERLOAD) {
+            dynamicThreshold = WindowScorer::MAX_ENTROPY;
+        }
+        const uint8_t* nullRoute = part.scorer.score(window, dynamicThreshold);
+        const StrikeTable::Tick now = StrikeTable::now();
+
+        // Ablak-késleltetés osztályonként: a legrégebbi esemény beküldése óta (a vezérlő a
+        // legnagyobbat figyeli)
+        const uint64_t nowNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        uint64_t classEvents[QOS_CLASS_COUNT] = {};
+        uint64_t classWaitNs[QOS_CLASS_COUNT] = {};
+        for (const VentEvent& ev : window) {
+            const size_t c = static_cast<size_t>(qosOf(ev.header.origin));
+            classEvents[c]++;
+            const uint64_t wait = nowNs > ev.header.timestampNs ? nowNs - ev.header.timestampNs : 0;
+            classWaitNs[c] = std::max(classWaitNs[c], wait);
+        }
+        const auto raiseMax = [](std::atomic<uint64_t>& slot, uint64_t value) {
+            uint64_t seen = slot.load(std::memory_order_relaxed);
+            while (value > seen && !slot.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+            }
+        };
+        uint64_t sojourn = 0;
+        for (size_t c = 0; c < QOS_CLASS_COUNT; ++c) {
+            if (classEvents[c] == 0) continue;
+            sojourn = std::max(sojourn, classWaitNs[c]);
+            raiseMax(telemetry.qos[c].max_wait_ns, classWaitNs[c]);
+            part.classEvents[c].fetch_add(classEvents[c], std::memory_order_relaxed);
+            releaseClass(static_cast<QosClass>(c), static_cast<uint32_t>(classEvents[c]));
+        }
+        raiseMax(telemetry.window_sojourn_ns, sojourn);
+
+        // Egymenetes könyvelés: helyi számlálók, az ablak végén egy-egy összeadás
+        uint64_t filtered = 0, blocks = 0;
+        const VentEvent* lastFiltered = nullptr;
+        for (size_t i = 0; i < window.size(); ++i) {
+            if (!nullRoute[i]) continue;
+            const VentEvent& ev = window[i];
+            NullScheduler::absorb(ev);
+            filtered++;
+            if (ev.header.peer.empty()) continue;
+            lastFiltered = &ev;
+            // Forrásonkénti strike: a forrás minden eseménye ebbe a partícióba jön, zár nélkül
+            if (part.strikes.strike(ev.header.peer, now) == SOURCE_STRIKE_LIMIT && on_source_block) {
+                on_source_block(ev.header.peer);
+                blocks++;
+            }
+        }
+        part.events.fetch_add(window.size(), std::memory_order_relaxed);
+        part.nullRouted.fetch_add(filtered, std::memory_order_relaxed);
+        part.accepted.fetch_add(window.size() - filtered, std::memory_order_relaxed);
+        part.windowCount.fetch_add(1, std::memory_order_relaxed);
+        if (blocks) part.sourceBlocks.fetch_add(blocks, std::memory_order_relaxed);
+
+        if (lastFiltered) {
+            std::lock_guard<std::mutex> lock(part.peerMutex);
+            part.lastFiltered = lastFiltered->header.peer;
+            part.lastFilteredNs = lastFiltered->header.timestampNs;
+        }
+
+        // A mélység nem fordulhat át (a null-route-olt push is csökkenti)
+        const uint32_t done = static_cast<uint32_t>(window.size());
+        uint32_t depth = telemetry.queue_depth.load(std::memory_order_relaxed);
+        while (!telemetry.queue_depth.compare_exchange_weak(depth, depth - std::min(depth, done),
+                                                            std::memory_order_relaxed)) {
+        }
     }
 
     TelemetrySnapshot VenomBus::getTelemetrySnapshot() const {
-        return telemetry.snapshot();
+        TelemetrySnapshot snap = telemetry.snapshot();
+        // Összefésülés: a partíciók csak a saját számlálóikat írják
+        snap.partition_count = partitionCount;
+        uint64_t sum = 0, max = 0;
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            const Partition& part = *partitions[p];
+            const uint64_t events = part.events.load(std::memory_order_relaxed);
+            snap.partition_events[p] = events;
+            sum += events;
+            max = std::max(max, events);
+            snap.accepted += part.accepted.load(std::memory_order_relaxed);
+            snap.null_routed += part.nullRouted.load(std::memory_order_relaxed);
+            snap.windows += part.windowCount.load(std::memory_order_relaxed);
+            snap.source_blocks += part.sourceBlocks.load(std::memory_order_relaxed);
+            for (size_t c = 0; c < QOS_CLASS_COUNT; ++c) {
+                snap.qos_delivered[c] += part.classEvents[c].load(std::memory_order_relaxed);
+            }
+        }
+        snap.partition_imbalance = sum > 0
+            ? static_cast<double>(max) * partitionCount / static_cast<double>(sum)
+            : 1.0;
+        return snap;
     }
 
     std::string VenomBus::getLastFilteredIP() const {
-        std::lock_guard<std::mutex> lock(ip_mutex);
-        return last_filtered_ip;
+        // A legfrissebb kiszűrt cím a partíciók közül
+        NetAddress peer;
+        uint64_t newest = 0;
+        for (uint32_t p = 0; p < partitionCount; ++p) {
+            const Partition& part = *partitions[p];
+            std::lock_guard<std::mutex> lock(part.peerMutex);
+            if (!part.lastFiltered.empty() && part.lastFilteredNs >= newest) {
+                peer = part.lastFiltered;
+                newest = part.lastFilteredNs;
+            }
+        }
+        // Csak valódi hálózati címet adunk ki (FS/CORTEX forrásnév nem blokkolható IP)
+        return peer.empty() ? std::string() : peer.toString();
     }
 }
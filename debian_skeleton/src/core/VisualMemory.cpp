@@ -1,61 +1,45 @@
 #include "core/VisualMemory.hpp"
-#include <arpa/inet.h> // IP konverzióhoz
 
 namespace Venom::Core {
 
-VisualMemory::VisualMemory() : bit_array(BIT_SIZE) {
-    for (size_t i = 0; i < BIT_SIZE; ++i) bit_array[i].store(false);
-}
-
-size_t VisualMemory::hash1(const std::string& key) const {
-    size_t h = 0;
-    for (char c : key) h = h * 31 + static_cast<unsigned char>(c);
-    return h % BIT_SIZE;
-}
+VisualMemory::VisualMemory() : wanted(WANTED_CAPACITY, WANTED_FPR) {}
 
-size_t VisualMemory::hash2(const std::string& key) const {
-    size_t h = 7;
-    for (char c : key) h = h * 37 + static_cast<unsigned char>(c);
-    return h % BIT_SIZE;
+void VisualMemory::mark_as_wanted(const std::string& ip) {
+    NetAddress addr;
+    if (NetAddress::parse(ip, addr)) mark_as_wanted(addr);
 }
 
-void VisualMemory::mark_as_wanted(const std::string& ip) {
+void VisualMemory::mark_as_wanted(const NetAddress& addr) {
     // 1. Bloom-filter jelölés (Gyors kereséshez)
-    bit_array[hash1(ip)].store(true, std::memory_order_release);
-    bit_array[hash2(ip)].store(true, std::memory_order_release);
+    wanted.insert(addr);
     
-    uint32_t current_strikes = 0;
-    {
-        std::lock_guard<std::mutex> lock(strike_mutex);
-        current_strikes = ++strike_count[ip];
-    }
+    // Meglévő címnél egyetlen CAS, új címnél a shard zárja (más shardok termelőit nem fogja)
+    uint32_t current_strikes = strikes.strike(addr);
 
     // 2. Összedrótozás: Ha eléri a küszöböt, küldjük a kernelnek (eBPF)
-    if (current_strikes >= 3 && on_kernel_block_request) {
-        struct in_addr addr;
-        if (inet_pton(AF_INET, ip.c_str(), &addr) == 1) {
-            // Itt repül az IP a kernel feketelistájába!
-            on_kernel_block_request(addr.s_addr);
-        }
+    if (current_strikes >= BLOCK_THRESHOLD && on_kernel_block_request) {
+        // Itt repül az IP a kernel feketelistájába!
+        on_kernel_block_request(addr);
     }
 }
 
 bool VisualMemory::is_on_wanted_list(const std::string& ip) const {
-    if (!bit_array[hash1(ip)].load(std::memory_order_acquire)) return false;
-    if (!bit_array[hash2(ip)].load(std::memory_order_acquire)) return false;
-    return true;
+    NetAddress addr;
+    return NetAddress::parse(ip, addr) && is_on_wanted_list(addr);
+}
+
+bool VisualMemory::is_on_wanted_list(const NetAddress& addr) const {
+    return wanted.contains(addr);
 }
 
-int VisualMemory::get_strike_count(const std::string& ip) {
-    std::lock_guard<std::mutex> lock(strike_mutex);
-    if (strike_count.find(ip) == strike_count.end()) return 0;
-    return strike_count[ip];
+int VisualMemory::get_strike_count(const std::string& ip) const {
+    NetAddress addr;
+    return NetAddress::parse(ip, addr) ? get_strike_count(addr) : 0;
 }
 
 void VisualMemory::clear_memory() {
-    for (size_t i = 0; i < BIT_SIZE; ++i) bit_array[i].store(false);
-    std::lock_guard<std::mutex> lock(strike_mutex);
-    strike_count.clear();
+    wanted.clear();
+    strikes.clear();
 }
 
 } // namespace Venom::Core
@@ -0,0 +1,100 @@
+#include "core/WindowScorer.hpp"
+#include "core/EntropyEngine.hpp"
+#include <algorithm>
+
+namespace Venom::Core {
+
+    WindowScorer::WindowScorer(unsigned workerCount) {
+        workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.emplace_back(&WindowScorer::workerLoop, this, i);
+        }
+    }
+
+    WindowScorer::~WindowScorer() {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobCv.notify_all();
+        for (auto& w : workers) {
+            if (w.joinable()) w.join();
+        }
+    }
+
+    bool WindowScorer::nullRoute(const VentEvent& ev, double threshold) {
+        if (ev.isArp()) return true;
+        if (threshold >= MAX_ENTROPY) return false;
+        double entropy = EntropyEngine::compute(ev.data());
+        // Hosszú életű kapcsolat: a csúszóablak entrópiája is számít (slow-drip ellen)
+        if (ev.header.flags & EVENT_FLAG_STREAM) {
+            entropy = std::max(entropy, static_cast<double>(ev.header.streamEntropy));
+        }
+        return entropy > threshold;
+    }
+
+    void WindowScorer::scoreRange(const VentEvent* events, size_t begin, size_t end, double threshold) {
+        uint8_t* out = verdicts.data();
+        if (threshold >= MAX_ENTROPY) {
+            // Az entrópia nem lépheti át a küszöböt: a ciklus csak a jelzőbitet nézi
+            for (size_t i = begin; i < end; ++i) out[i] = events[i].isArp() ? 1 : 0;
+            return;
+        }
+        for (size_t i = begin; i < end; ++i) out[i] = nullRoute(events[i], threshold) ? 1 : 0;
+    }
+
+    const uint8_t* WindowScorer::score(const VentWindow& window, double threshold) {
+        const size_t n = window.size();
+        if (verdicts.size() < n) verdicts.resize(n);
+
+        // Entrópia nélküli ablakban nincs mit szétosztani
+        if (workers.empty() || n < PARALLEL_MIN_WINDOW || threshold >= MAX_ENTROPY) {
+            scoreRange(window.begin(), 0, n, threshold);
+            return verdicts.data();
+        }
+
+        const unsigned slices = static_cast<unsigned>(
+            std::min<size_t>(workers.size() + 1, n / (PARALLEL_MIN_WINDOW / 2)));
+        const size_t slice = (n / slices + SLICE_ALIGN - 1) / SLICE_ALIGN * SLICE_ALIGN;
+        pending.store(slices - 1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            jobEvents = window.begin();
+            jobThreshold = threshold;
+            jobSlice = slice;
+            jobCount = n;
+            jobSlices = slices;
+            jobEpoch++;
+        }
+        jobCv.notify_all();
+
+        // A hívó az első szeletet maga pontozza, utána megvárja a segédeket
+        scoreRange(window.begin(), 0, std::min(slice, n), threshold);
+        while (pending.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        parallelCount.fetch_add(1, std::memory_order_relaxed);
+        return verdicts.data();
+    }
+
+    void WindowScorer::workerLoop(unsigned index) {
+        uint64_t seen = 0;
+        for (;;) {
+            const VentEvent* events;
+            double threshold;
+            size_t begin, end;
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobCv.wait(lock, [&] { return stopping || jobEpoch != seen; });
+                if (stopping) return;
+                seen = jobEpoch;
+                // Kisebb ablaknál nem jut minden segédnek szelet
+                if (index + 1 >= jobSlices) continue;
+                events = jobEvents;
+                threshold = jobThreshold;
+                begin = std::min(jobSlice * (index + 1), jobCount);
+                end = index + 2 == jobSlices ? jobCount : std::min(begin + jobSlice, jobCount);
+            }
+            scoreRange(events, begin, end, threshold);
+            pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+}
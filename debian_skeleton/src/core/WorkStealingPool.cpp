@@ -0,0 +1,339 @@
+#include "core/WorkStealingPool.hpp"
+#include <algorithm>
+
+namespace Venom::Core {
+
+    namespace {
+
+        using Priority = WorkStealingPool::Priority;
+        using rxcpp::schedulers::schedulable;
+
+        /**
+         * @brief Egy rx worker akciói: FIFO sor, egyszerre legfeljebb egy példányban beküldve.
+         * Sorban állás alatt a saját shared_ptr-ét tartja, így az rx worker eldobása után is
+         * lefut a már beküldött kör.
+         */
+        class Strand final : public WorkStealingPool::Task, public std::enable_shared_from_this<Strand> {
+        public:
+            Strand(WorkStealingPool& pool, Priority prio) : pool(pool), prio(prio) {}
+
+            void enqueue(const schedulable& what) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.push_back(what);
+                    if (queued) return;
+                    queued = true;
+                    self = shared_from_this();
+                }
+                pool.submit(this, prio);
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.clear();
+            }
+
+            void run() override {
+                for (unsigned i = 0; i < WorkStealingPool::STRAND_BATCH; ++i) {
+                    schedulable what;
+                    {
+                        std::shared_ptr<Strand> keep;   // A zár feloldása után engedjük el
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (queue.empty()) {
+                            queued = false;
+                            keep = std::move(self);
+                            return;
+                        }
+                        what = std::move(queue.front());
+                        queue.pop_front();
+                    }
+                    // Helyben ismétlés (tail-recursion) nincs: az újraütemezés a sor végére kerül,
+                    // így a kör korlátja a rekurzív akciókra is érvényes
+                    if (what.is_subscribed()) what(recursion.get_recurse());
+                }
+                // Maradt munka: vissza a poolba, a többi feladat és a tolvajok is sorra kerülnek
+                pool.submit(this, prio);
+            }
+
+        private:
+            WorkStealingPool& pool;
+            const Priority prio;
+            std::mutex mutex;
+            std::deque<schedulable> queue;
+            bool queued = false;
+            std::shared_ptr<Strand> self;
+            rxcpp::schedulers::recursion recursion{false};
+        };
+
+        // Időzített akció: lejáratkor a strand sorába kerül
+        class DelayedAction final : public WorkStealingPool::Task {
+        public:
+            DelayedAction(std::shared_ptr<Strand> strand, schedulable what)
+                : strand(std::move(strand)), what(std::move(what)) {}
+
+            void run() override {
+                if (what.is_subscribed()) strand->enqueue(what);
+                delete this;
+            }
+
+        private:
+            std::shared_ptr<Strand> strand;
+            schedulable what;
+        };
+
+        class StrandWorker final : public rxcpp::schedulers::worker_interface {
+        public:
+            StrandWorker(rxcpp::composite_subscription cs, WorkStealingPool& pool, Priority prio)
+                : pool(pool), prio(prio), strand(std::make_shared<Strand>(pool, prio)) {
+                std::weak_ptr<Strand> weak = strand;
+                cs.add([weak]() {
+                    if (auto s = weak.lock()) s->clear();
+                });
+            }
+
+            clock_type::time_point now() const override { return clock_type::now(); }
+
+            void schedule(const schedulable& scbl) const override {
+                if (scbl.is_subscribed()) strand->enqueue(scbl);
+            }
+
+            void schedule(clock_type::time_point when, const schedulable& scbl) const override {
+                if (!scbl.is_subscribed()) return;
+                if (when <= clock_type::now()) {
+                    strand->enqueue(scbl);
+                    return;
+                }
+                pool.submitAt(new DelayedAction(strand, scbl), prio, when);
+            }
+
+        private:
+            WorkStealingPool& pool;
+            const Priority prio;
+            std::shared_ptr<Strand> strand;
+        };
+
+        class PoolScheduler final : public rxcpp::schedulers::scheduler_interface {
+        public:
+            PoolScheduler(WorkStealingPool& pool, Priority prio) : pool(pool), prio(prio) {}
+
+            clock_type::time_point now() const override { return clock_type::now(); }
+
+            rxcpp::schedulers::worker create_worker(rxcpp::composite_subscription cs) const override {
+                return rxcpp::schedulers::worker(cs, std::make_shared<StrandWorker>(cs, pool, prio));
+            }
+
+        private:
+            WorkStealingPool& pool;
+            const Priority prio;
+        };
+    }
+
+    thread_local WorkStealingPool::Worker* WorkStealingPool::current = nullptr;
+
+    WorkStealingPool::WorkStealingPool(unsigned count) {
+        if (count == 0) count = std::max(1u, std::thread::hardware_concurrency());
+        workers.reserve(count);
+        for (unsigned i = 0; i < count; ++i) {
+            auto w = std::make_unique<Worker>();
+            w->pool = this;
+            w->index = i;
+            w->rng = 0x9e3779b9u * (i + 1);
+            workers.push_back(std::move(w));
+        }
+        // Minden deque a helyén van, mielőtt bárki lopni kezdene
+        for (auto& w : workers) {
+            w->thread = std::thread(&WorkStealingPool::workerLoop, this, std::ref(*w));
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        // Az időzítő leáll; a függő időzített feladatok most futnak le (lejárt feliratkozásnál üresen)
+        {
+            std::lock_guard<std::mutex> lock(timerMutex);
+            timerStopping = true;
+        }
+        timerCv.notify_all();
+        if (timerThread.joinable()) timerThread.join();
+        while (!timers.empty()) {
+            submit(timers.top().task, timers.top().prio);
+            timers.pop();
+        }
+
+        stopping.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            parkCv.notify_all();
+        }
+        for (auto& w : workers) {
+            if (w->thread.joinable()) w->thread.join();
+        }
+        // A leállással versenyző külső beküldés a hívó szálán fut le
+        for (auto& inj : injection) {
+            while (!inj.tasks.empty()) {
+                Task* task = inj.tasks.front();
+                inj.tasks.pop_front();
+                task->run();
+            }
+        }
+    }
+
+    void WorkStealingPool::submit(Task* task, Priority prio) {
+        const size_t cls = static_cast<size_t>(prio);
+        Worker* self = current;
+        if (self && self->pool == this) {
+            self->deques[cls].push(task);
+        } else if (stopping.load(std::memory_order_acquire)) {
+            // Leállás után nincs, aki felvegye
+            task->run();
+            return;
+        } else {
+            Injection& inj = injection[cls];
+            {
+                std::lock_guard<std::mutex> lock(inj.mutex);
+                inj.tasks.push_back(task);
+                inj.size.fetch_add(1, std::memory_order_relaxed);
+            }
+            injectedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        wakeOne();
+    }
+
+    void WorkStealingPool::submitAt(Task* task, Priority prio, std::chrono::steady_clock::time_point when) {
+        {
+            std::lock_guard<std::mutex> lock(timerMutex);
+            if (!timerStopping) {
+                if (!timerThread.joinable()) timerThread = std::thread(&WorkStealingPool::timerLoop, this);
+                timers.push(Timed{when, timerSeq++, task, prio});
+                timerCv.notify_one();
+                return;
+            }
+        }
+        submit(task, prio);
+    }
+
+    rxcpp::schedulers::scheduler WorkStealingPool::scheduler(Priority prio) {
+        return rxcpp::schedulers::make_scheduler<PoolScheduler>(*this, prio);
+    }
+
+    WorkStealingPool::Stats WorkStealingPool::stats() const {
+        Stats s;
+        for (const auto& w : workers) {
+            s.executed += w->executed.load(std::memory_order_relaxed);
+            s.stolen += w->stolen.load(std::memory_order_relaxed);
+            s.parks += w->parks.load(std::memory_order_relaxed);
+        }
+        s.injected = injectedCount.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void WorkStealingPool::wakeOne() {
+        // Dekker-párja a workerLoop parkolásának: beküldés -> fence -> sleepers olvasás
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            parkCv.notify_one();
+        }
+    }
+
+    bool WorkStealingPool::hasWork() const {
+        for (const auto& inj : injection) {
+            if (inj.size.load(std::memory_order_relaxed) > 0) return true;
+        }
+        for (const auto& w : workers) {
+            for (const auto& d : w->deques) {
+                if (!d.empty()) return true;
+            }
+        }
+        return false;
+    }
+
+    WorkStealingPool::Task* WorkStealingPool::findInClass(Worker& w, size_t cls) {
+        Task* task = nullptr;
+        if (w.deques[cls].pop(task)) return task;
+
+        Injection& inj = injection[cls];
+        if (inj.size.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(inj.mutex);
+            if (!inj.tasks.empty()) {
+                task = inj.tasks.front();
+                inj.tasks.pop_front();
+                inj.size.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        // Lopás véletlen kezdőponttól (xorshift), hogy a tolvajok ne ugyanazt az áldozatot célozzák
+        const size_t n = workers.size();
+        if (n < 2) return nullptr;
+        w.rng ^= w.rng << 13;
+        w.rng ^= w.rng >> 17;
+        w.rng ^= w.rng << 5;
+        const size_t start = w.rng % n;
+        for (size_t i = 0; i < n; ++i) {
+            Worker& victim = *workers[(start + i) % n];
+            if (&victim == &w) continue;
+            if (victim.deques[cls].steal(task)) {
+                w.stolen.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    WorkStealingPool::Task* WorkStealingPool::findTask(Worker& w) {
+        const bool reverse = (++w.lookups % STARVATION_GUARD) == 0;
+        for (size_t i = 0; i < PRIORITY_CLASSES; ++i) {
+            const size_t cls = reverse ? PRIORITY_CLASSES - 1 - i : i;
+            if (Task* task = findInClass(w, cls)) return task;
+        }
+        return nullptr;
+    }
+
+    void WorkStealingPool::workerLoop(Worker& w) {
+        current = &w;
+        int idleSpins = 0;
+        for (;;) {
+            if (Task* task = findTask(w)) {
+                task->run();
+                w.executed.fetch_add(1, std::memory_order_relaxed);
+                idleSpins = 0;
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire) && !hasWork()) break;
+
+            if (++idleSpins < IDLE_SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(parkMutex);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (!stopping.load(std::memory_order_relaxed) && !hasWork()) {
+                w.parks.fetch_add(1, std::memory_order_relaxed);
+                parkCv.wait_for(lock, std::chrono::milliseconds(50));
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+        current = nullptr;
+    }
+
+    void WorkStealingPool::timerLoop() {
+        std::unique_lock<std::mutex> lock(timerMutex);
+        while (!timerStopping) {
+            if (timers.empty()) {
+                timerCv.wait(lock);
+                continue;
+            }
+            const Timed next = timers.top();
+            if (std::chrono::steady_clock::now() < next.when) {
+                timerCv.wait_until(lock, next.when);
+                continue;
+            }
+            timers.pop();
+            lock.unlock();
+            submit(next.task, next.prio);
+            lock.lock();
+        }
+    }
+}
@@ -0,0 +1,234 @@
+// © 2026 Beatrix Zselezny. All rights reserved.
+// White-Venom Security Framework
+
+#include "core/XskSocket.hpp"
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#if __has_include(<linux/if_xdp.h>)
+#include <linux/if_xdp.h>
+#endif
+
+// A need_wakeup (5.4) a legújabb szükséges ABI-elem
+#if defined(XDP_USE_NEED_WAKEUP) && defined(XDP_PGOFF_RX_RING)
+#define VENOM_HAVE_AF_XDP 1
+#else
+#define VENOM_HAVE_AF_XDP 0
+#endif
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+namespace Venom::Core {
+
+    XskSocket::XskSocket() = default;
+
+    XskSocket::~XskSocket() {
+        close();
+    }
+
+#if VENOM_HAVE_AF_XDP
+
+namespace {
+    constexpr int BIND_BUSY_RETRIES = 50;
+    constexpr int BIND_BUSY_WAIT_MS = 20;
+}
+
+    bool XskSocket::mapRing(Ring& ring, uint64_t pgoff, size_t descSize, uint32_t entries,
+                            uint64_t producerOff, uint64_t consumerOff, uint64_t descOff, uint64_t flagsOff) {
+        ring.mapLen = descOff + static_cast<size_t>(entries) * descSize;
+        void* map = mmap(nullptr, ring.mapLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         sock, static_cast<off_t>(pgoff));
+        if (map == MAP_FAILED) {
+            ring.mapLen = 0;
+            return false;
+        }
+        auto* base = static_cast<uint8_t*>(map);
+        ring.map = map;
+        ring.producer = reinterpret_cast<uint32_t*>(base + producerOff);
+        ring.consumer = reinterpret_cast<uint32_t*>(base + consumerOff);
+        ring.flags = reinterpret_cast<uint32_t*>(base + flagsOff);
+        ring.descs = base + descOff;
+        ring.mask = entries - 1;
+        return true;
+    }
+
+    void XskSocket::unmapRing(Ring& ring) {
+        if (ring.map) munmap(ring.map, ring.mapLen);
+        ring = Ring{};
+    }
+
+    bool XskSocket::open(int ifindex, uint32_t queue) {
+        close();
+
+        sock = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+        if (sock < 0) {
+            std::cerr << "[XskSocket] AF_XDP socket: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        umemLen = static_cast<size_t>(FRAME_SIZE) * FRAME_COUNT;
+        void* mem = mmap(nullptr, umemLen, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if (mem == MAP_FAILED) {
+            umemLen = 0;
+            close();
+            return false;
+        }
+        umem = static_cast<uint8_t*>(mem);
+
+        xdp_umem_reg reg{};
+        reg.addr = reinterpret_cast<uint64_t>(umem);
+        reg.len = umemLen;
+        reg.chunk_size = FRAME_SIZE;
+        reg.headroom = 0;
+        int fillSize = FILL_RING_SIZE;
+        int compSize = COMPLETION_RING_SIZE;
+        int rxSize = RX_RING_SIZE;
+        if (setsockopt(sock, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) != 0 ||
+            setsockopt(sock, SOL_XDP, XDP_UMEM_FILL_RING, &fillSize, sizeof(fillSize)) != 0 ||
+            setsockopt(sock, SOL_XDP, XDP_UMEM_COMPLETION_RING, &compSize, sizeof(compSize)) != 0 ||
+            setsockopt(sock, SOL_XDP, XDP_RX_RING, &rxSize, sizeof(rxSize)) != 0) {
+            std::cerr << "[XskSocket] UMEM setup: " << std::strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+
+        xdp_mmap_offsets off{};
+        socklen_t optlen = sizeof(off);
+        if (getsockopt(sock, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) != 0 ||
+            !mapRing(fill, XDP_UMEM_PGOFF_FILL_RING, sizeof(uint64_t), FILL_RING_SIZE,
+                     off.fr.producer, off.fr.consumer, off.fr.desc, off.fr.flags) ||
+            !mapRing(completion, XDP_UMEM_PGOFF_COMPLETION_RING, sizeof(uint64_t), COMPLETION_RING_SIZE,
+                     off.cr.producer, off.cr.consumer, off.cr.desc, off.cr.flags) ||
+            !mapRing(rx, XDP_PGOFF_RX_RING, sizeof(xdp_desc), RX_RING_SIZE,
+                     off.rx.producer, off.rx.consumer, off.rx.desc, off.rx.flags)) {
+            std::cerr << "[XskSocket] ring mmap: " << std::strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+
+        // Minden UMEM keret a kernelé, mielőtt az első csomag megérkezik
+        auto* fillAddrs = static_cast<uint64_t*>(fill.descs);
+        for (uint32_t i = 0; i < FRAME_COUNT; ++i) {
+            fillAddrs[i & fill.mask] = static_cast<uint64_t>(i) * FRAME_SIZE;
+        }
+        __atomic_store_n(fill.producer, FRAME_COUNT, __ATOMIC_RELEASE);
+
+        sockaddr_xdp addr{};
+        addr.sxdp_family = AF_XDP;
+        addr.sxdp_ifindex = static_cast<uint32_t>(ifindex);
+        addr.sxdp_queue_id = queue;
+        for (int attempt = 0;; ++attempt) {
+            addr.sxdp_flags = XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP;
+            zeroCopyBound = true;
+            if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return true;
+
+            // A meghajtó nem támogat zero-copy-t (veth / generic XDP): másoló mód
+            addr.sxdp_flags = XDP_COPY | XDP_USE_NEED_WAKEUP;
+            zeroCopyBound = false;
+            if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return true;
+
+            // Az előző socket UMEM-jét a kernel késleltetve engedi el a sorról: EBUSY-nál várunk
+            if (errno != EBUSY || attempt >= BIND_BUSY_RETRIES) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(BIND_BUSY_WAIT_MS));
+        }
+        std::cerr << "[XskSocket] bind queue " << queue << ": " << std::strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    void XskSocket::close() {
+        unmapRing(rx);
+        unmapRing(completion);
+        unmapRing(fill);
+        if (sock >= 0) {
+            ::close(sock);
+            sock = -1;
+        }
+        if (umem) {
+            munmap(umem, umemLen);
+            umem = nullptr;
+            umemLen = 0;
+        }
+        zeroCopyBound = false;
+    }
+
+    size_t XskSocket::receive(XskFrame* out, size_t max) {
+        const uint32_t cons = *rx.consumer;   // A consumer index a miénk
+        const uint32_t prod = __atomic_load_n(rx.producer, __ATOMIC_ACQUIRE);
+        size_t ready = prod - cons;
+        if (ready > max) ready = max;
+
+        const auto* descs = static_cast<const xdp_desc*>(rx.descs);
+        for (size_t i = 0; i < ready; ++i) {
+            const xdp_desc& d = descs[(cons + i) & rx.mask];
+            out[i].addr = d.addr;
+            out[i].len = d.len;
+            out[i].data = umem + d.addr;
+        }
+        return ready;
+    }
+
+    void XskSocket::release(const XskFrame* frames, size_t count) {
+        if (count == 0) return;
+
+        // A fill ring mérete = UMEM keretszám, így a visszaadott kereteknek mindig van helye
+        const uint32_t fillProd = *fill.producer;
+        auto* fillAddrs = static_cast<uint64_t*>(fill.descs);
+        for (size_t i = 0; i < count; ++i) {
+            // Igazított módban a kernel a chunk elejét várja (a headroom nélkül)
+            fillAddrs[(fillProd + i) & fill.mask] = frames[i].addr & ~static_cast<uint64_t>(FRAME_SIZE - 1);
+        }
+        __atomic_store_n(fill.producer, fillProd + static_cast<uint32_t>(count), __ATOMIC_RELEASE);
+        __atomic_store_n(rx.consumer, *rx.consumer + static_cast<uint32_t>(count), __ATOMIC_RELEASE);
+
+        // need_wakeup: a kernel jelzi, ha a fill ring feltöltéséről értesíteni kell
+        if (__atomic_load_n(fill.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP) {
+            recvfrom(sock, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        }
+    }
+
+    XskKernelStats XskSocket::kernelStats() const {
+        XskKernelStats s;
+        xdp_statistics st{};
+        socklen_t len = sizeof(st);
+        if (sock < 0 || getsockopt(sock, SOL_XDP, XDP_STATISTICS, &st, &len) != 0) return s;
+        s.rxDropped = st.rx_dropped;
+        s.rxInvalidDescs = st.rx_invalid_descs;
+        // A régebbi kernelek csak az első három mezőt töltik
+        if (len >= offsetof(xdp_statistics, rx_fill_ring_empty_descs) + sizeof(uint64_t)) {
+            s.rxRingFull = st.rx_ring_full;
+            s.fillRingEmpty = st.rx_fill_ring_empty_descs;
+        }
+        return s;
+    }
+
+#else // !VENOM_HAVE_AF_XDP
+
+    bool XskSocket::mapRing(Ring&, uint64_t, size_t, uint32_t, uint64_t, uint64_t, uint64_t, uint64_t) { return false; }
+    void XskSocket::unmapRing(Ring& ring) { ring = Ring{}; }
+
+    bool XskSocket::open(int, uint32_t) {
+        std::cerr << "[XskSocket] AF_XDP support not compiled in (linux/if_xdp.h too old)" << std::endl;
+        return false;
+    }
+
+    void XskSocket::close() {}
+    size_t XskSocket::receive(XskFrame*, size_t) { return 0; }
+    void XskSocket::release(const XskFrame*, size_t) {}
+    XskKernelStats XskSocket::kernelStats() const { return {}; }
+
+#endif // VENOM_HAVE_AF_XDP
+
+} // namespace Venom::Core
@@ -0,0 +1,215 @@
+#include "core/ebpf/BlockQueue.hpp"
+#include <bpf/bpf.h>
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+#include "core/ebpf/venom_ebpf_common.h"
+
+namespace Venom::Core {
+
+namespace {
+    constexpr int ENOTSUPP_KERNEL = 524;   // A kernel belső ENOTSUPP-je (nincs a libc errno.h-ban)
+
+    // A map típusa nem ismeri a batch műveletet (régi kernel): egyenkénti tartalék
+    bool batchUnsupported(int err) {
+        return err == -EINVAL || err == -ENOTSUP || err == -EOPNOTSUPP ||
+               err == -ENOSYS || err == -ENOTSUPP_KERNEL;
+    }
+
+    struct Tally {
+        uint64_t applied = 0;
+        uint64_t failed = 0;
+        uint64_t syscalls = 0;
+    };
+
+    /**
+     * @brief Kulcsok írása (value = 1) MAX_BATCH-es darabokban. Hibánál a kernel a
+     * count-ban a sikeresen feldolgozott elemek számát adja: a hibás elem kimarad,
+     * a többi a következő hívással megy.
+     */
+    void updateKeys(int fd, const uint8_t* keys, size_t keySize, size_t n, Tally& t) {
+        const std::vector<uint8_t> values(n, 1);
+        size_t done = 0;
+        while (done < n) {
+            uint32_t count = static_cast<uint32_t>(std::min(n - done, BlockQueue::MAX_BATCH));
+            LIBBPF_OPTS(bpf_map_batch_opts, opts, .elem_flags = BPF_ANY);
+            int err = bpf_map_update_batch(fd, keys + done * keySize, values.data() + done, &count, &opts);
+            t.syscalls++;
+            if (err == 0) {
+                t.applied += count;
+                done += count;
+                continue;
+            }
+            if (batchUnsupported(err)) {
+                // A count ilyenkor nem megbízható: a maradék egyenként (az update idempotens)
+                for (; done < n; ++done) {
+                    t.syscalls++;
+                    if (bpf_map_update_elem(fd, keys + done * keySize, &values[done], BPF_ANY) == 0) {
+                        t.applied++;
+                    } else {
+                        t.failed++;
+                    }
+                }
+                return;
+            }
+            count = std::min<uint32_t>(count, static_cast<uint32_t>(n - done - 1));
+            t.applied += count;
+            t.failed++;
+            done += count + 1;
+        }
+    }
+
+    // Kulcsok törlése; a nem létező kulcs (ENOENT) nem hiba, csak átlépjük
+    void deleteKeys(int fd, const uint8_t* keys, size_t keySize, size_t n, Tally& t) {
+        size_t done = 0;
+        while (done < n) {
+            uint32_t count = static_cast<uint32_t>(std::min(n - done, BlockQueue::MAX_BATCH));
+            LIBBPF_OPTS(bpf_map_batch_opts, opts);
+            int err = bpf_map_delete_batch(fd, keys + done * keySize, &count, &opts);
+            t.syscalls++;
+            if (err == 0) {
+                t.applied += count;
+                done += count;
+                continue;
+            }
+            if (batchUnsupported(err)) {
+                for (; done < n; ++done) {
+                    t.syscalls++;
+                    int r = bpf_map_delete_elem(fd, keys + done * keySize);
+                    if (r == 0) {
+                        t.applied++;
+                    } else if (errno != ENOENT) {
+                        t.failed++;
+                    }
+                }
+                return;
+            }
+            count = std::min<uint32_t>(count, static_cast<uint32_t>(n - done - 1));
+            t.applied += count;
+            if (err != -ENOENT) t.failed++;
+            done += count + 1;
+        }
+    }
+}
+
+    BlockQueue::~BlockQueue() { stop(); }
+
+    bool BlockQueue::start(int v4, int v6, std::chrono::milliseconds flushDeadline) {
+        if (running) return false;
+        if (v4 < 0 && v6 < 0) return false;
+        v4Fd.store(v4, std::memory_order_relaxed);
+        v6Fd.store(v6, std::memory_order_relaxed);
+        deadline = flushDeadline;
+        running.store(true, std::memory_order_release);
+        flusher = std::thread(&BlockQueue::flusherLoop, this);
+        return true;
+    }
+
+    void BlockQueue::stop() {
+        if (!running.exchange(false)) return;
+        {
+            std::lock_guard<std::mutex> lock(mtx);   // A várakozó predikátum ne maradjon le róla
+        }
+        cv.notify_all();
+        if (flusher.joinable()) flusher.join();
+        flush();
+        v4Fd.store(-1, std::memory_order_relaxed);
+        v6Fd.store(-1, std::memory_order_relaxed);
+    }
+
+    bool BlockQueue::enqueue(const NetAddress& addr, bool block) {
+        // acquire: a start() által beállított leírók látszanak
+        if (!running.load(std::memory_order_acquire) || addr.empty()) return false;
+        if ((addr.isV4() ? v4Fd : v6Fd).load(std::memory_order_relaxed) < 0) return false;
+
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (pending_.empty()) due = std::chrono::steady_clock::now() + deadline;
+            auto [it, inserted] = pending_.insert_or_assign(addr, block);
+            (void)it;
+            if (!inserted) coalesced.fetch_add(1, std::memory_order_relaxed);
+            // Az első bejegyzés indítja a határidőt, a MAX_BATCH azonnal üríti a sort
+            wake = pending_.size() == 1 || pending_.size() >= MAX_BATCH;
+        }
+        queued.fetch_add(1, std::memory_order_relaxed);
+        if (wake) cv.notify_one();
+        return true;
+    }
+
+    void BlockQueue::flusherLoop() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (running.load(std::memory_order_relaxed)) {
+            cv.wait(lock, [this] { return !running.load(std::memory_order_relaxed) || !pending_.empty(); });
+            if (!running.load(std::memory_order_relaxed)) break;
+            // Az üres sor azt jelzi, hogy közben egy flush() már kiírta
+            cv.wait_until(lock, due, [this] {
+                return !running.load(std::memory_order_relaxed) || pending_.empty() ||
+                       pending_.size() >= MAX_BATCH;
+            });
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    void BlockQueue::flush() {
+        std::lock_guard<std::mutex> order(applyMtx);
+        Pending batch;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            batch.swap(pending_);
+        }
+        if (batch.empty()) return;
+        apply(batch);
+    }
+
+    void BlockQueue::apply(const Pending& batch) {
+        std::vector<uint32_t> add4, del4;
+        std::vector<venom_in6> add6, del6;
+        for (const auto& [addr, block] : batch) {
+            if (addr.isV4()) {
+                (block ? add4 : del4).push_back(addr.v4());
+            } else {
+                venom_in6 k{};
+                std::memcpy(k.addr, addr.bytes, sizeof(k.addr));
+                (block ? add6 : del6).push_back(k);
+            }
+        }
+
+        Tally t;
+        auto bytesOf = [](const auto& v) { return reinterpret_cast<const uint8_t*>(v.data()); };
+        const int fd4 = v4Fd.load(std::memory_order_relaxed);
+        const int fd6 = v6Fd.load(std::memory_order_relaxed);
+        if (fd4 >= 0) {
+            if (!add4.empty()) updateKeys(fd4, bytesOf(add4), sizeof(uint32_t), add4.size(), t);
+            if (!del4.empty()) deleteKeys(fd4, bytesOf(del4), sizeof(uint32_t), del4.size(), t);
+        }
+        if (fd6 >= 0) {
+            if (!add6.empty()) updateKeys(fd6, bytesOf(add6), sizeof(venom_in6), add6.size(), t);
+            if (!del6.empty()) deleteKeys(fd6, bytesOf(del6), sizeof(venom_in6), del6.size(), t);
+        }
+
+        applied.fetch_add(t.applied, std::memory_order_relaxed);
+        failed.fetch_add(t.failed, std::memory_order_relaxed);
+        syscalls.fetch_add(t.syscalls, std::memory_order_relaxed);
+        flushes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t BlockQueue::pending() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return pending_.size();
+    }
+
+    BlockQueueStats BlockQueue::stats() const {
+        BlockQueueStats s;
+        s.queued = queued.load(std::memory_order_relaxed);
+        s.coalesced = coalesced.load(std::memory_order_relaxed);
+        s.applied = applied.load(std::memory_order_relaxed);
+        s.failed = failed.load(std::memory_order_relaxed);
+        s.syscalls = syscalls.load(std::memory_order_relaxed);
+        s.flushes = flushes.load(std::memory_order_relaxed);
+        return s;
+    }
+}
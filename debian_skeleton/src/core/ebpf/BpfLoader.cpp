@@ -4,39 +4,498 @@
 #include <bpf/bpf.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <net/if.h>
+#include <linux/if_link.h>
+#include <linux/if_ether.h>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/NetAddress.hpp"
+#include "core/VenomBus.hpp"
+#include "core/ebpf/venom_ebpf_common.h"
+
+// A Makefile / CMake a bpftool-lal generálja (obj/core/ebpf, ill. <build>/ebpf), ha elérhető
+#ifdef VENOM_BPF_SKELETON
+#include "venom_shield.skel.h"
+#endif
 
 namespace Venom::Core {
-    BpfLoader::BpfLoader() : obj(nullptr), link(nullptr), attached(false) {}
+
+namespace {
+    constexpr int EVENT_POLL_MS = 100;
+    // Ennyi időnként frissül a busz telemetriája (kiolvasott / elveszett rekordok)
+    constexpr auto EVENT_REPORT_INTERVAL = std::chrono::milliseconds(250);
+    // Egy poll körön belül ennyi különböző forrás IP DROP-ja vonható össze
+    constexpr size_t DROP_TALLY_SLOTS = 64;
+
+    // Pinelt módban a folyamatot túlélő mapek: csak a tanult állapot. A futásidejű konfiguráció
+    // (rate/xsk/event config), a statisztika és a folyamat saját erőforrásai (xsks_map,
+    // events_rb) minden indításkor frissek: egy átmeneti korlát nem marad a kernelben.
+    constexpr const char* PINNED_MAPS[] = {
+        "blacklist_map", "blacklist6_map", "cidr_blacklist_map", "cidr6_blacklist_map",
+        "watch_map", "rate_map", "router_identity_map",
+    };
+
+    // A pinelt map definíciója (típus, kulcs/érték méret, kapacitás, flagek) egyezik az objektuméval?
+    bool pinCompatible(int pinFd, const struct bpf_map* map) {
+        bpf_map_info info{};
+        __u32 len = sizeof(info);
+        if (bpf_obj_get_info_by_fd(pinFd, &info, &len) != 0) return false;
+        return info.type == static_cast<__u32>(bpf_map__type(map)) &&
+               info.key_size == bpf_map__key_size(map) &&
+               info.value_size == bpf_map__value_size(map) &&
+               info.max_entries == bpf_map__max_entries(map) &&
+               info.map_flags == bpf_map__map_flags(map);
+    }
+
+    size_t possibleCpus() {
+        static const int n = libbpf_num_possible_cpus();
+        return n > 0 ? static_cast<size_t>(n) : 1;
+    }
+
+    // Egy PERCPU slot összege (a kernel CPU-nként 8 bájtra igazított értéket ad vissza)
+    bool sumPerCpuSlot(int fd, uint32_t slot, uint64_t& out) {
+        std::vector<uint64_t> perCpu(possibleCpus());
+        if (bpf_map_lookup_elem(fd, &slot, perCpu.data()) != 0) return false;
+        out = 0;
+        for (uint64_t v : perCpu) out += v;
+        return true;
+    }
+
+    /**
+     * @brief "cím[/len]" mindkét családra: a címbájtok hálózati sorrendben, a host-bitek
+     * nullázva. "/len" nélkül teljes hossz (/32 vagy /128).
+     */
+    struct CidrKey {
+        NetAddress addr;        // IPv4-nél IPv4-mapped (a v4() adja a 4 bájtot)
+        uint32_t prefixlen = 0;
+        bool hasPrefix = false;
+    };
+
+    bool parseCidr(const std::string& str, CidrKey& key) {
+        size_t slash = str.find('/');
+        if (!NetAddress::parse(str.substr(0, slash), key.addr)) return false;
+
+        const unsigned long maxLen = key.addr.isV4() ? 32 : 128;
+        unsigned long len = maxLen;
+        key.hasPrefix = slash != std::string::npos;
+        if (key.hasPrefix) {
+            const char* first = str.data() + slash + 1;
+            const char* last = str.data() + str.size();
+            auto res = std::from_chars(first, last, len);
+            if (res.ec != std::errc() || res.ptr != last || first == last || len > maxLen) return false;
+        }
+        key.prefixlen = static_cast<uint32_t>(len);
+
+        // A host-bitek nullázása (az IPv4 a 12. bájttól ül)
+        uint8_t* bytes = key.addr.bytes + (key.addr.isV4() ? 12 : 0);
+        const size_t total = maxLen / 8;
+        for (size_t b = 0; b < total; ++b) {
+            size_t bitStart = b * 8;
+            if (bitStart >= len) {
+                bytes[b] = 0;
+            } else if (bitStart + 8 > len) {
+                bytes[b] &= static_cast<uint8_t>(0xff << (8 - (len - bitStart)));
+            }
+        }
+        return true;
+    }
+
+    venom_lpm_v4 lpmV4(const CidrKey& key) {
+        venom_lpm_v4 k{};
+        k.prefixlen = key.prefixlen;
+        k.addr = key.addr.v4();
+        return k;
+    }
+
+    venom_lpm_v6 lpmV6(const CidrKey& key) {
+        venom_lpm_v6 k{};
+        k.prefixlen = key.prefixlen;
+        std::memcpy(k.addr, key.addr.bytes, sizeof(k.addr));
+        return k;
+    }
+}
+
+    bool readStatsMap(int mapFd, BpfStats& out) {
+        if (mapFd < 0) return false;
+
+        const size_t cpus = possibleCpus();
+        uint64_t sums[VENOM_STAT_SLOTS] = {};
+        uint32_t keys[VENOM_STAT_SLOTS];
+        std::vector<uint64_t> values(VENOM_STAT_SLOTS * cpus);
+        uint32_t nextKey = 0;
+        uint32_t count = VENOM_STAT_SLOTS;
+
+        // in_batch = NULL: az elejéről; a tömb végén ENOENT jön, a count akkor is érvényes
+        int err = bpf_map_lookup_batch(mapFd, nullptr, &nextKey, keys, values.data(), &count, nullptr);
+        if (err == 0 || errno == ENOENT) {
+            for (uint32_t i = 0; i < count; ++i) {
+                if (keys[i] >= VENOM_STAT_SLOTS) continue;
+                for (size_t c = 0; c < cpus; ++c) sums[keys[i]] += values[i * cpus + c];
+            }
+        } else {
+            // Batch nélküli kernel (< 5.6): slotonkénti lookup
+            for (uint32_t slot = 0; slot < VENOM_STAT_SLOTS; ++slot) {
+                if (!sumPerCpuSlot(mapFd, slot, sums[slot])) return false;
+            }
+        }
+
+        out.inspected_packets = sums[VENOM_STAT_INSPECTED];
+        out.dropped_packets = sums[VENOM_STAT_DROPPED];
+        out.passed_packets = sums[VENOM_STAT_PASSED];
+        out.redirected_packets = sums[VENOM_STAT_REDIRECTED];
+        out.events_lost = sums[VENOM_STAT_EVENTS_LOST];
+        out.arp_packets = sums[VENOM_STAT_PROTO_ARP];
+        out.ipv4_packets = sums[VENOM_STAT_PROTO_IPV4];
+        out.ipv6_packets = sums[VENOM_STAT_PROTO_IPV6];
+        out.other_packets = sums[VENOM_STAT_PROTO_OTHER];
+        out.blacklist_drops = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_BLACKLIST];
+        out.untrusted_arp = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_ARP_UNTRUSTED];
+        out.router_arp = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_ROUTER_ARP];
+        out.fragments = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_FRAGMENT];
+        out.watched = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_WATCHED];
+        out.sampled = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_RANDOM];
+        out.cidr_drops = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_CIDR];
+        out.untrusted_ra = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_RA_UNTRUSTED];
+        out.rate_limited = sums[VENOM_STAT_REASON_BASE + VENOM_REASON_RATE_LIMIT];
+        return true;
+    }
+
+    /**
+     * @brief Az events_rb fogyasztó állapota. Csak az eventThread írja, a számlálókat
+     * az eventStats() bármely szálról olvashatja.
+     */
+    struct BpfLoader::EventChannel {
+        struct DropTally {
+            NetAddress peer;
+            uint8_t reason;
+            uint64_t count;
+        };
+
+        VenomBus& bus;
+        SourceId source;
+        ring_buffer* rb = nullptr;
+        int statsFd = -1;
+        uint32_t dropEvery = 1;   // A DROP darabszám becslése a mintavétel visszaszorzásával
+
+        DropTally drops[DROP_TALLY_SLOTS];
+        size_t dropCount = 0;
+
+        std::atomic<uint64_t> received{0};
+        std::atomic<uint64_t> dropRecords{0};
+        std::atomic<uint64_t> suspects{0};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> busEvents{0};
+        std::atomic<uint64_t> lost{0};
+        uint64_t reportedReceived = 0;
+
+        EventChannel(VenomBus& b, SourceId src) : bus(b), source(src) {}
+
+        static int onRecord(void* ctx, void* data, size_t size) {
+            auto* self = static_cast<EventChannel*>(ctx);
+            if (size < sizeof(venom_event)) return 0;
+            self->handle(*static_cast<const venom_event*>(data));
+            return 0;
+        }
+
+        void handle(const venom_event& e) {
+            received.fetch_add(1, std::memory_order_relaxed);
+
+            if (e.kind == VENOM_EVT_DROP) {
+                dropRecords.fetch_add(1, std::memory_order_relaxed);
+                tallyDrop(sourceOf(e), e.reason);
+                return;
+            }
+
+            if (e.kind == VENOM_EVT_SUSPECT) {
+                suspects.fetch_add(1, std::memory_order_relaxed);
+            } else if (e.kind == VENOM_EVT_SAMPLE) {
+                samples.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                return;
+            }
+
+            // Gyanús / minta keret: egyenként, a keret elejével mint payload
+            uint8_t flags = EVENT_FLAG_KERNEL;
+            if (e.reason == VENOM_REASON_ARP_UNTRUSTED) flags |= EVENT_FLAG_ARP;
+            size_t headLen = e.head_len < VENOM_EVT_HEAD_LEN ? e.head_len : VENOM_EVT_HEAD_LEN;
+            NetAddress peer = sourceOf(e);
+            bus.pushEvent(source, EventOrigin::RAW_PACKET,
+                          std::string_view(reinterpret_cast<const char*>(e.head), headLen),
+                          flags, peer.empty() ? nullptr : &peer);
+            busEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static NetAddress sourceOf(const venom_event& e) {
+            if (e.eth_proto == htons(ETH_P_IPV6)) return NetAddress::fromV6(e.saddr6);
+            return e.saddr ? NetAddress::fromV4(e.saddr) : NetAddress{};
+        }
+
+        void tallyDrop(const NetAddress& peer, uint8_t reason) {
+            for (size_t i = 0; i < dropCount; ++i) {
+                if (drops[i].peer == peer && drops[i].reason == reason) {
+                    drops[i].count++;
+                    return;
+                }
+            }
+            if (dropCount == DROP_TALLY_SLOTS) flushDrops();   // Szétszórt forrás (pl. spoofolt árvíz)
+            drops[dropCount++] = DropTally{peer, reason, 1};
+        }
+
+        // Forrás IP-nként (és okonként) egy esemény: "XDP_DROP blacklist count=N" (heap nélkül)
+        void flushDrops() {
+            static constexpr std::string_view HOST = "XDP_DROP blacklist count=";
+            static constexpr std::string_view PREFIX = "XDP_DROP cidr count=";
+            static constexpr std::string_view RATE = "XDP_DROP ratelimit count=";
+            for (size_t i = 0; i < dropCount; ++i) {
+                char num[24];
+                auto res = std::to_chars(num, num + sizeof(num), drops[i].count * dropEvery);
+                const NetAddress& peer = drops[i].peer;
+                const uint8_t reason = drops[i].reason;
+                bus.pushEvent(source, EventOrigin::RAW_PACKET,
+                              {reason == VENOM_REASON_CIDR ? PREFIX : reason == VENOM_REASON_RATE_LIMIT ? RATE : HOST,
+                               std::string_view(num, static_cast<size_t>(res.ptr - num))},
+                              EVENT_FLAG_KERNEL, &peer);
+            }
+            busEvents.fetch_add(dropCount, std::memory_order_relaxed);
+            dropCount = 0;
+        }
+
+        void report() {
+            uint64_t kernelLost = 0;
+            if (statsFd >= 0 && sumPerCpuSlot(statsFd, VENOM_STAT_EVENTS_LOST, kernelLost)) {
+                lost.store(kernelLost, std::memory_order_relaxed);
+            }
+            uint64_t total = received.load(std::memory_order_relaxed);
+            bus.noteKernelEvents(total - reportedReceived, lost.load(std::memory_order_relaxed));
+            reportedReceived = total;
+        }
+    };
+
+    int attachXdpLink(int progFd, int ifindex, XdpAttachMode mode, const std::string& pinPath, bool* reused) {
+        if (reused) *reused = false;
+        if (!pinPath.empty()) {
+            int fd = bpf_obj_get(pinPath.c_str());
+            if (fd >= 0) {
+                if (bpf_link_update(fd, progFd, nullptr) == 0) {
+                    if (reused) *reused = true;
+                    return fd;
+                }
+                // Elárvult link: a pin törlésével az utolsó hivatkozás is elengedi
+                close(fd);
+                unlink(pinPath.c_str());
+            }
+        }
+
+        // NATIVE: flag nélkül a kernel a meghajtó útját választja (mint a bpf_program__attach_xdp),
+        // GENERIC: SKB mode
+        LIBBPF_OPTS(bpf_link_create_opts, opts,
+                    .flags = mode == XdpAttachMode::GENERIC ? static_cast<uint32_t>(XDP_FLAGS_SKB_MODE) : 0u);
+        int fd = bpf_link_create(progFd, ifindex, BPF_XDP, &opts);
+        if (fd < 0) return -1;
+        if (!pinPath.empty() && bpf_obj_pin(fd, pinPath.c_str()) != 0) {
+            std::cerr << "[BpfLoader] link pin " << pinPath << ": " << std::strerror(errno) << std::endl;
+        }
+        return fd;
+    }
+
+    BpfLoader::BpfLoader() : obj(nullptr), linkFd(-1), attached(false) {}
     BpfLoader::~BpfLoader() { detach(); }
 
-    bool BpfLoader::deploy(const std::string& objPath, const std::string& iface) {
+    bool BpfLoader::setPinRoot(const std::string& dir) {
         if (attached) return false;
-        obj = bpf_object__open(objPath.c_str());
-        if (!obj) return false;
-        if (bpf_object__load(obj)) { bpf_object__close(obj); obj = nullptr; return false; }
+        pinRoot.clear();
+        if (dir.empty()) return true;
+        if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+            std::cerr << "[BpfLoader] pin root " << dir << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        pinRoot = dir;
+        return true;
+    }
+
+    bool BpfLoader::hasEmbeddedObject() {
+#ifdef VENOM_BPF_SKELETON
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool BpfLoader::openObject(const std::string& objPath) {
+        if (!objPath.empty()) {
+            obj = bpf_object__open(objPath.c_str());
+            return obj != nullptr;
+        }
+#ifdef VENOM_BPF_SKELETON
+        // Az ELF a skeletonban (a .rodata-ban): nincs fájlrendszer-hozzáférés és útvonalfüggés
+        skel = venom_shield__open();
+        if (!skel) return false;
+        obj = skel->obj;
+        return true;
+#else
+        std::cerr << "[BpfLoader] built without venom_shield.skel.h, an object path is required" << std::endl;
+        return false;
+#endif
+    }
+
+    void BpfLoader::closeObject() {
+#ifdef VENOM_BPF_SKELETON
+        if (skel) {
+            venom_shield__destroy(skel);   // Az obj-t is bezárja
+            skel = nullptr;
+            obj = nullptr;
+            return;
+        }
+#endif
+        if (obj) { bpf_object__close(obj); obj = nullptr; }
+    }
 
+    bool BpfLoader::loadObject(const std::string& objPath) {
+        if (!openObject(objPath)) return false;
+        // Pin útvonallal a libbpf a meglévő mapet veszi át, vagy létrehozza és pineli. A
+        // definíciót mapenként nézzük: egy eltérő (pl. bővített) map újra létrejön, a többi
+        // tanult állapota megmarad
+        warm = false;
+        if (!pinRoot.empty()) {
+            for (const char* name : PINNED_MAPS) {
+                struct bpf_map* map = bpf_object__find_map_by_name(obj, name);
+                if (!map) continue;
+                const std::string path = pinRoot + "/" + name;
+                const int pinFd = bpf_obj_get(path.c_str());
+                if (pinFd >= 0) {
+                    if (pinCompatible(pinFd, map)) {
+                        if (std::strcmp(name, "blacklist_map") == 0) warm = true;
+                    } else {
+                        std::cerr << "[BpfLoader] pinned " << name << " incompatible, recreated" << std::endl;
+                        unlink(path.c_str());
+                    }
+                    close(pinFd);
+                }
+                bpf_map__set_pin_path(map, path.c_str());
+            }
+        }
+        int err;
+#ifdef VENOM_BPF_SKELETON
+        err = skel ? venom_shield__load(skel) : bpf_object__load(obj);
+#else
+        err = bpf_object__load(obj);
+#endif
+        if (err) { closeObject(); return false; }
+        return true;
+    }
+
+    bool BpfLoader::deploy(const std::string& objPath, const std::string& iface, XdpAttachMode mode) {
+        if (attached) return false;
         int ifindex = if_nametoindex(iface.c_str());
         if (ifindex == 0) return false;
 
-        // A SEC("xdp") alatti függvény neve a .c fájlban!
-        struct bpf_program* prog = bpf_object__find_program_by_name(obj, "venom_router_guard");
-        if (!prog) return false;
+        if (!loadObject(objPath)) return false;
+        resolveMaps();
+        if (maps.guardProg < 0) {
+            closeObject();
+            maps = ShieldFds{};
+            return false;
+        }
+        // A friss rate_config_map az alapprofillal indul: a link cseréje után sincs üres korlát
+        applyProfile(SecurityProfile::NORMAL);
 
-        link = bpf_program__attach_xdp(prog, ifindex);
-        if (!link) return false;
+        bool reused = false;
+        const std::string linkPin = pinRoot.empty() ? std::string() : pinRoot + "/link_" + iface;
+        linkFd = attachXdpLink(maps.guardProg, ifindex, mode, linkPin, &reused);
+        if (linkFd < 0) {
+            linkFd = -1;
+            closeObject();
+            maps = ShieldFds{};
+            return false;
+        }
+        if (warm || reused) {
+            std::cout << "[BpfLoader] warm restart: " << (warm ? "pinned maps reused" : "fresh maps")
+                      << ", " << (reused ? "program swapped in the live link" : "new link") << std::endl;
+        }
 
         attached = true;
+        blockQueue.start(maps.blacklist, maps.blacklist6);
+        return true;
+    }
+
+    void BpfLoader::resolveMaps() {
+#ifdef VENOM_BPF_SKELETON
+        if (skel) {
+            // A mezőneveket a fordító ellenőrzi: átnevezett map a skeleton újragenerálásakor hiba
+            maps.blacklist = bpf_map__fd(skel->maps.blacklist_map);
+            maps.blacklist6 = bpf_map__fd(skel->maps.blacklist6_map);
+            maps.cidr = bpf_map__fd(skel->maps.cidr_blacklist_map);
+            maps.cidr6 = bpf_map__fd(skel->maps.cidr6_blacklist_map);
+            maps.routerIdentity = bpf_map__fd(skel->maps.router_identity_map);
+            maps.watch = bpf_map__fd(skel->maps.watch_map);
+            maps.xsks = bpf_map__fd(skel->maps.xsks_map);
+            maps.xskConfig = bpf_map__fd(skel->maps.xsk_config_map);
+            maps.eventConfig = bpf_map__fd(skel->maps.event_config_map);
+            maps.events = bpf_map__fd(skel->maps.events_rb);
+            maps.stats = bpf_map__fd(skel->maps.stats_map);
+            maps.rate = bpf_map__fd(skel->maps.rate_map);
+            maps.rateConfig = bpf_map__fd(skel->maps.rate_config_map);
+            maps.guardProg = bpf_program__fd(skel->progs.venom_router_guard);
+            return;
+        }
+#endif
+        maps.blacklist = get_map_fd("blacklist_map");
+        maps.blacklist6 = get_map_fd("blacklist6_map");
+        maps.cidr = get_map_fd("cidr_blacklist_map");
+        maps.cidr6 = get_map_fd("cidr6_blacklist_map");
+        maps.routerIdentity = get_map_fd("router_identity_map");
+        maps.watch = get_map_fd("watch_map");
+        maps.xsks = get_map_fd("xsks_map");
+        maps.xskConfig = get_map_fd("xsk_config_map");
+        maps.eventConfig = get_map_fd("event_config_map");
+        maps.events = get_map_fd("events_rb");
+        maps.stats = get_map_fd("stats_map");
+        maps.rate = get_map_fd("rate_map");
+        maps.rateConfig = get_map_fd("rate_config_map");
+        // A SEC("xdp") alatti függvény neve a .c fájlban!
+        maps.guardProg = get_prog_fd("venom_router_guard");
+    }
+
+    void BpfLoader::unpinMaps() {
+        for (const char* name : PINNED_MAPS) unlink((pinRoot + "/" + name).c_str());
+    }
+
+    bool BpfLoader::removePinned(const std::string& iface) {
+        if (pinRoot.empty()) return false;
+        detach();
+        // A saját leírónk már zárva: a pin törlése az utolsó hivatkozás, a program lecsatol
+        unlink((pinRoot + "/link_" + iface).c_str());
+        unpinMaps();
+        rmdir(pinRoot.c_str());   // Csak ha üres (más interfész linkje maradhat)
+        warm = false;
         return true;
     }
 
+    bool BpfLoader::hasRouterIdentity() {
+        if (maps.routerIdentity < 0) return false;
+        uint32_t key = 0;
+        router_identity ident{};
+        return bpf_map_lookup_elem(maps.routerIdentity, &key, &ident) == 0 && ident.trust_level != 0;
+    }
+
     int BpfLoader::get_map_fd(const std::string& map_name) {
         return (obj) ? bpf_object__find_map_fd_by_name(obj, map_name.c_str()) : -1;
     }
 
+    int BpfLoader::get_prog_fd(const std::string& prog_name) {
+        if (!obj) return -1;
+        struct bpf_program* prog = bpf_object__find_program_by_name(obj, prog_name.c_str());
+        return prog ? bpf_program__fd(prog) : -1;
+    }
+
     bool BpfLoader::setRouterMAC(const std::string& mac_str) {
-        int fd = get_map_fd("router_identity_map");
+        int fd = maps.routerIdentity;
         if (fd < 0) return false;
 
         router_identity ident = {};
@@ -55,7 +514,78 @@ namespace Venom::Core {
     }
 
     bool BpfLoader::blockIP(const std::string& ip_str) {
-        int fd = get_map_fd("blacklist_map");
+        NetAddress addr;
+        if (!NetAddress::parse(ip_str, addr)) return false;
+        // A sorban várakozó műveletek előbb: egy korábbi queueUnblock ne írja felül
+        blockQueue.flush();
+        uint8_t value = 1;
+        if (addr.isV4()) {
+            int fd = maps.blacklist;
+            uint32_t ip_addr = addr.v4();
+            return fd >= 0 && bpf_map_update_elem(fd, &ip_addr, &value, BPF_ANY) == 0;
+        }
+        int fd = maps.blacklist6;
+        venom_in6 key{};
+        std::memcpy(key.addr, addr.bytes, sizeof(key.addr));
+        return fd >= 0 && bpf_map_update_elem(fd, &key, &value, BPF_ANY) == 0;
+    }
+
+    bool BpfLoader::blockCIDR(const std::string& cidr_str) {
+        CidrKey key;
+        if (!parseCidr(cidr_str, key)) return false;
+        uint8_t value = 1;
+        if (key.addr.isV4()) {
+            int fd = maps.cidr;
+            venom_lpm_v4 k = lpmV4(key);
+            return fd >= 0 && bpf_map_update_elem(fd, &k, &value, BPF_ANY) == 0;
+        }
+        int fd = maps.cidr6;
+        venom_lpm_v6 k = lpmV6(key);
+        return fd >= 0 && bpf_map_update_elem(fd, &k, &value, BPF_ANY) == 0;
+    }
+
+    bool BpfLoader::unblock(const std::string& str) {
+        CidrKey key;
+        if (!parseCidr(str, key)) return false;
+
+        const bool v4 = key.addr.isV4();
+        bool removed = false;
+        int cidrFd = v4 ? maps.cidr : maps.cidr6;
+        if (cidrFd >= 0) {
+            if (v4) {
+                venom_lpm_v4 k = lpmV4(key);
+                removed |= bpf_map_delete_elem(cidrFd, &k) == 0;
+            } else {
+                venom_lpm_v6 k = lpmV6(key);
+                removed |= bpf_map_delete_elem(cidrFd, &k) == 0;
+            }
+        }
+        if (!key.hasPrefix) {
+            blockQueue.flush();
+            int hostFd = v4 ? maps.blacklist : maps.blacklist6;
+            if (hostFd >= 0) {
+                if (v4) {
+                    uint32_t ip_addr = key.addr.v4();
+                    removed |= bpf_map_delete_elem(hostFd, &ip_addr) == 0;
+                } else {
+                    venom_in6 k{};
+                    std::memcpy(k.addr, key.addr.bytes, sizeof(k.addr));
+                    removed |= bpf_map_delete_elem(hostFd, &k) == 0;
+                }
+            }
+        }
+        return removed;
+    }
+
+    bool BpfLoader::setXskRedirect(uint32_t mask) {
+        int fd = maps.xskConfig;
+        if (fd < 0) return false;
+        uint32_t key = 0;
+        return bpf_map_update_elem(fd, &key, &mask, BPF_ANY) == 0;
+    }
+
+    bool BpfLoader::watchIP(const std::string& ip_str) {
+        int fd = maps.watch;
         if (fd < 0) return false;
         uint32_t ip_addr;
         if (inet_pton(AF_INET, ip_str.c_str(), &ip_addr) != 1) return false;
@@ -63,22 +593,114 @@ namespace Venom::Core {
         return bpf_map_update_elem(fd, &ip_addr, &value, BPF_ANY) == 0;
     }
 
-    BpfStats BpfLoader::getStats() {
-        BpfStats stats{0};
-        int fd = get_map_fd("stats_map");
-        if (fd < 0) return stats;
+    bool BpfLoader::setRateLimit(const RateLimit& limit) {
+        int fd = maps.rateConfig;
+        if (fd < 0) return false;
+        venom_rate_config cfg{};
+        if (limit.packetsPerSec > 0) {
+            cfg.cost_ns = 1000000000ULL / limit.packetsPerSec;
+            cfg.burst_ns = cfg.cost_ns * (limit.burst ? limit.burst : 1);
+        }
+        uint32_t key = 0;
+        return bpf_map_update_elem(fd, &key, &cfg, BPF_ANY) == 0;
+    }
 
-        uint32_t key = 0; // STAT_DROPPED index
-        uint64_t val = 0;
-        if (bpf_map_lookup_elem(fd, &key, &val) == 0) {
-            stats.dropped_packets = val;
+    bool BpfLoader::setEventSampling(const EventSampling& sampling) {
+        int fd = maps.eventConfig;
+        if (fd < 0) return false;
+        venom_event_config cfg{};
+        cfg.drop_every = sampling.dropEvery;
+        cfg.suspect_every = sampling.suspectEvery;
+        cfg.sample_every = sampling.sampleEvery;
+        uint32_t key = 0;
+        if (bpf_map_update_elem(fd, &key, &cfg, BPF_ANY) != 0) return false;
+        if (events) events->dropEvery = sampling.dropEvery ? sampling.dropEvery : 1;
+        return true;
+    }
+
+    bool BpfLoader::startEventChannel(VenomBus& bus, const EventSampling& sampling) {
+        if (eventsRunning) return false;
+        int rbFd = maps.events;
+        if (rbFd < 0) return false;
+
+        events = std::make_unique<EventChannel>(bus, bus.registerSource("XDP"));
+        events->statsFd = maps.stats;
+        // A ring_buffer belül epoll-on várja a kernel értesítését (nincs busy-poll)
+        events->rb = ring_buffer__new(rbFd, &EventChannel::onRecord, events.get(), nullptr);
+        if (!events->rb) {
+            std::cerr << "[BpfLoader] ring_buffer__new: " << std::strerror(errno) << std::endl;
+            events.reset();
+            return false;
         }
+        if (!setEventSampling(sampling)) {
+            ring_buffer__free(events->rb);
+            events.reset();
+            return false;
+        }
+
+        eventsRunning = true;
+        eventThread = std::thread(&BpfLoader::eventLoop, this);
+        return true;
+    }
+
+    void BpfLoader::eventLoop() {
+        EventChannel& ch = *events;
+        auto lastReport = std::chrono::steady_clock::now();
+
+        while (eventsRunning.load(std::memory_order_relaxed)) {
+            int n = ring_buffer__poll(ch.rb, EVENT_POLL_MS);
+            if (n < 0 && n != -EINTR) {
+                std::cerr << "[BpfLoader] ring_buffer__poll: " << std::strerror(-n) << std::endl;
+                break;
+            }
+            // Egy poll kör = egy köteg: az összevont DROP-ok itt mennek ki
+            ch.flushDrops();
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastReport >= EVENT_REPORT_INTERVAL) {
+                ch.report();
+                lastReport = now;
+            }
+        }
+        ch.flushDrops();
+        ch.report();
+    }
+
+    void BpfLoader::stopEventChannel() {
+        if (!eventsRunning.exchange(false)) return;
+        if (eventThread.joinable()) eventThread.join();
+        ring_buffer__free(events->rb);
+        events->rb = nullptr;
+    }
+
+    EventChannelStats BpfLoader::eventStats() const {
+        EventChannelStats s;
+        if (!events) return s;
+        s.received = events->received.load(std::memory_order_relaxed);
+        s.drops = events->dropRecords.load(std::memory_order_relaxed);
+        s.suspects = events->suspects.load(std::memory_order_relaxed);
+        s.samples = events->samples.load(std::memory_order_relaxed);
+        s.busEvents = events->busEvents.load(std::memory_order_relaxed);
+        s.lost = events->lost.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    BpfStats BpfLoader::getStats() {
+        BpfStats stats;
+        readStatsMap(maps.stats, stats);
         return stats;
     }
 
     void BpfLoader::detach() {
-        if (link) { bpf_link__destroy(link); link = nullptr; }
-        if (obj) { bpf_object__close(obj); obj = nullptr; }
+        stopEventChannel();
+        blockQueue.stop();   // A függő tiltások még a map bezárása előtt kiíródnak
+        // Pinelt módban a program csatolva marad vezérlő nélkül: egy NULL_ONLY / LOCKDOWN alatti
+        // átmeneti korlát ne maradjon érvényben, az alapprofilra állunk vissza
+        if (attached) applyProfile(SecurityProfile::NORMAL);
+        // Pin nélkül ez az utolsó hivatkozás (lecsatol); pinelt módban a bpffs tartja tovább
+        if (linkFd >= 0) { close(linkFd); linkFd = -1; }
+        closeObject();
+        maps = ShieldFds{};
         attached = false;
     }
 }
@@ -1,55 +1,404 @@
 #include <linux/bpf.h>
 #include <linux/if_ether.h>
 #include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <linux/icmpv6.h>
 #include <bpf/bpf_helpers.h>
 #include <linux/in.h>
+#include <linux/in6.h>
 
-// Blacklist tábla az automatikus blokkoláshoz
+#include "venom_ebpf_common.h"
+
+// IPv6 Fragment fejléc (a kernelben net/ipv6.h, nem uapi)
+struct venom_frag_hdr {
+    __u8   nexthdr;
+    __u8   reserved;
+    __be16 frag_off;
+    __be32 identification;
+};
+
+// Blacklist tábla az automatikus blokkoláshoz (LRU: tele táblánál a legrégebbi megy)
 struct {
-    __uint(type, BPF_MAP_TYPE_HASH);
-    __uint(max_entries, 1024);
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
+    __uint(max_entries, VENOM_BLACKLIST_MAX);
     __type(key, __be32);
     __type(value, __u8);
 } blacklist_map SEC(".maps");
 
-// Statisztikai tábla a Dashboardhoz
+// Tiltott prefixek (BpfLoader::blockCIDR); az LPM trie csak prealloc nélkül létezik
 struct {
-    __uint(type, BPF_MAP_TYPE_ARRAY);
-    __uint(max_entries, 2);
+    __uint(type, BPF_MAP_TYPE_LPM_TRIE);
+    __uint(max_entries, VENOM_CIDR_MAX);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, struct venom_lpm_v4);
+    __type(value, __u8);
+} cidr_blacklist_map SEC(".maps");
+
+// Statisztikai tábla a Dashboardhoz: CPU-nként saját számlálók (VENOM_STAT_*)
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, VENOM_STAT_SLOTS);
     __type(key, __u32);
     __type(value, __u64);
 } stats_map SEC(".maps");
 
+// IPv6 megfelelők: egyedi hostok (LRU) és prefixek (LPM trie)
+struct {
+    __uint(type, BPF_MAP_TYPE_LRU_HASH);
+    __uint(max_entries, VENOM_BLACKLIST6_MAX);
+    __type(key, struct venom_in6);
+    __type(value, __u8);
+} blacklist6_map SEC(".maps");
+
+struct {
+    __uint(type, BPF_MAP_TYPE_LPM_TRIE);
+    __uint(max_entries, VENOM_CIDR6_MAX);
+    __uint(map_flags, BPF_F_NO_PREALLOC);
+    __type(key, struct venom_lpm_v6);
+    __type(value, __u8);
+} cidr6_blacklist_map SEC(".maps");
+
+// A megbízható router (BpfLoader::setRouterMAC tölti)
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct router_identity);
+} router_identity_map SEC(".maps");
+
+// Gyanús, de (még) nem blokkolt források: mély vizsgálatra mennek
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, 1024);
+    __type(key, __be32);
+    __type(value, __u8);
+} watch_map SEC(".maps");
+
+// RX sor -> AF_XDP socket (a RawPacketProbe regisztrálja a saját socketjeit)
+struct {
+    __uint(type, BPF_MAP_TYPE_XSKMAP);
+    __uint(max_entries, VENOM_XSK_MAX_QUEUES);
+    __type(key, __u32);
+    __type(value, __u32);
+} xsks_map SEC(".maps");
+
+// Átirányítási maszk (VENOM_XSK_REDIRECT_*)
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, __u32);
+} xsk_config_map SEC(".maps");
+
+// Kernel -> user-space eseménycsatorna (drop / gyanús / minta rekordok)
+struct {
+    __uint(type, BPF_MAP_TYPE_RINGBUF);
+    __uint(max_entries, VENOM_EVENTS_RB_BYTES);
+} events_rb SEC(".maps");
+
+// Mintavételi arányok fajtánként (a BpfLoader::startEventChannel tölti)
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct venom_event_config);
+} event_config_map SEC(".maps");
+
+// Forrásonkénti token bucket (CPU-nként); tele táblánál a legrégebben látott forrás megy
+struct {
+    __uint(type, BPF_MAP_TYPE_LRU_PERCPU_HASH);
+    __uint(max_entries, VENOM_RATE_MAX);
+    __type(key, struct venom_in6);
+    __type(value, struct venom_rate_bucket);
+} rate_map SEC(".maps");
+
+// Csomag ár és vödörméret (BpfLoader::setRateLimit / applyProfile tölti)
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct venom_rate_config);
+} rate_config_map SEC(".maps");
+
 static __always_inline void update_stat(__u32 slot) {
     __u64 *count = bpf_map_lookup_elem(&stats_map, &slot);
     if (count) {
-        __sync_fetch_and_add(count, 1);
+        *count += 1; // Saját CPU példánya: az XDP nem fut egymásba ugyanazon a CPU-n
     }
 }
 
-SEC("xdp")
-int venom_router_guard(struct xdp_md *ctx) {
+static __always_inline void count_reason(__u8 reason) {
+    update_stat(VENOM_STAT_REASON_BASE + reason);
+}
+
+static __always_inline int is_trusted_router(const unsigned char *mac) {
+    __u32 key = 0;
+    struct router_identity *ident = bpf_map_lookup_elem(&router_identity_map, &key);
+    if (!ident || ident->trust_level == 0) return 0;
+    // Bájtonként, kifejtve: a __builtin_memcmp-et nem minden LLVM BPF backend inline-olja
+    // (hívás marad, a betöltő elutasítja), a csomagbeli h_source pedig nem 4-re igazított
+    __u8 diff = 0;
+#pragma unroll
+    for (int i = 0; i < ETH_ALEN; i++) diff |= ident->mac[i] ^ mac[i];
+    return diff == 0;
+}
+
+// "Minden N-edik" (véletlen) mintavétel: 0 = soha, 1 = mindig
+static __always_inline int sampled(__u32 every) {
+    if (every <= 1) return every == 1;
+    return (bpf_get_prandom_u32() % every) == 0;
+}
+
+static __always_inline void emit_event(struct xdp_md *ctx, __u8 kind, __u8 reason, __u32 saddr,
+                                       const struct venom_in6 *saddr6, __u16 eth_proto, int with_head) {
+    void *data_end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+
+    struct venom_event *e = bpf_ringbuf_reserve(&events_rb, sizeof(*e), 0);
+    if (!e) {
+        update_stat(VENOM_STAT_EVENTS_LOST); // Tele ring: a fogyasztó lemaradt
+        return;
+    }
+    e->ts_ns = bpf_ktime_get_ns();
+    e->saddr = saddr;
+    if (saddr6) {
+        __builtin_memcpy(e->saddr6, saddr6->addr, sizeof(e->saddr6));
+    } else {
+        __builtin_memset(e->saddr6, 0, sizeof(e->saddr6));
+    }
+    e->eth_proto = eth_proto;
+    e->kind = kind;
+    e->reason = reason;
+    e->pkt_len = (__u16)(data_end - data);
+    e->rx_queue = ctx->rx_queue_index;
+    e->head_len = 0;
+    if (with_head) {
+        // Fix méretű másolatok: a verifier konstans hosszt vár a csomagból olvasáshoz
+        if (data + VENOM_EVT_HEAD_LEN <= data_end) {
+            __builtin_memcpy(e->head, data, VENOM_EVT_HEAD_LEN);
+            e->head_len = VENOM_EVT_HEAD_LEN;
+        } else if (data + ETH_HLEN + 28 <= data_end) {      // Ethernet + ARP / IPv4+UDP fejléc
+            __builtin_memcpy(e->head, data, ETH_HLEN + 28);
+            e->head_len = ETH_HLEN + 28;
+        } else if (data + ETH_HLEN <= data_end) {
+            __builtin_memcpy(e->head, data, ETH_HLEN);
+            e->head_len = ETH_HLEN;
+        }
+    }
+    bpf_ringbuf_submit(e, 0);
+}
+
+/**
+ * Token bucket: a kredit az eltelt idővel nő (burst_ns-ig), a csomag cost_ns-t von le.
+ * Új forrás teli vödörrel indul. 1 = a forrás túllépte a keretet (eldobandó).
+ */
+static __always_inline int rate_exceeded(const struct venom_rate_config *rate, const struct venom_in6 *src) {
+    __u64 now = bpf_ktime_get_ns();
+    struct venom_rate_bucket *b = bpf_map_lookup_elem(&rate_map, src);
+    if (!b) {
+        struct venom_rate_bucket fresh = { .credit_ns = rate->burst_ns - rate->cost_ns, .last_ns = now };
+        bpf_map_update_elem(&rate_map, src, &fresh, BPF_ANY);
+        return 0;
+    }
+
+    __u64 credit = b->credit_ns + (now - b->last_ns);
+    if (credit > rate->burst_ns) credit = rate->burst_ns;
+    b->last_ns = now;
+    if (credit < rate->cost_ns) {
+        b->credit_ns = credit;
+        return 1;
+    }
+    b->credit_ns = credit - rate->cost_ns;
+    return 0;
+}
+
+static __always_inline int to_xsk(struct xdp_md *ctx) {
+    // Ha ezen a soron nincs AF_XDP socket, a keret a normál úton megy tovább
+    return bpf_redirect_map(&xsks_map, ctx->rx_queue_index, XDP_PASS);
+}
+
+// IPv6: tiltólisták, majd a kiterjesztett fejlécek korlátos átlépése (Fragment, RA)
+static __always_inline int guard_ipv6(struct xdp_md *ctx, struct ethhdr *eth, __u32 redirect,
+                                      struct venom_event_config *ev, struct venom_rate_config *rate) {
+    void *data_end = (void *)(long)ctx->data_end;
+
+    struct ipv6hdr *ip6 = (void *)(eth + 1);
+    if ((void *)(ip6 + 1) > data_end) return XDP_PASS;
+
+    struct venom_in6 src;
+    __builtin_memcpy(src.addr, &ip6->saddr, sizeof(src.addr));
+
+    __u8 reason = 0;
+    __u8 *blocked = bpf_map_lookup_elem(&blacklist6_map, &src);
+    if (blocked && *blocked == 1) {
+        reason = VENOM_REASON_BLACKLIST;
+    } else {
+        struct venom_lpm_v6 key = { .prefixlen = 128 };
+        __builtin_memcpy(key.addr, src.addr, sizeof(key.addr));
+        __u8 *prefix = bpf_map_lookup_elem(&cidr6_blacklist_map, &key);
+        if (prefix && *prefix == 1) reason = VENOM_REASON_CIDR;
+    }
+    if (!reason && rate && rate->cost_ns && rate_exceeded(rate, &src)) reason = VENOM_REASON_RATE_LIMIT;
+    if (reason) {
+        count_reason(reason);
+        if (ev && sampled(ev->drop_every)) {
+            emit_event(ctx, VENOM_EVT_DROP, reason, 0, &src, eth->h_proto, 0);
+        }
+        return XDP_DROP;
+    }
+
+    __u8 next = ip6->nexthdr;
+    void *cur = ip6 + 1;
+    int frag = 0;
+
+#pragma unroll
+    for (int i = 0; i < VENOM_IPV6_MAX_EXT_HDRS; i++) {
+        if (next == IPPROTO_HOPOPTS || next == IPPROTO_ROUTING || next == IPPROTO_DSTOPTS) {
+            struct ipv6_opt_hdr *opt = cur;
+            if ((void *)(opt + 1) > data_end) return XDP_PASS;
+            next = opt->nexthdr;
+            cur += (opt->hdrlen + 1) * 8;
+        } else if (next == IPPROTO_FRAGMENT) {
+            struct venom_frag_hdr *fh = cur;
+            if ((void *)(fh + 1) > data_end) return XDP_PASS;
+            frag = 1;
+            next = fh->nexthdr;
+            cur = fh + 1;
+        } else {
+            break;
+        }
+    }
+
+    int ra = 0;
+    if (next == IPPROTO_ICMPV6) {
+        struct icmp6hdr *icmp = cur;
+        if ((void *)(icmp + 1) <= data_end && icmp->icmp6_type == 134 &&   // Router Advertisement
+            !is_trusted_router(eth->h_source)) {
+            ra = 1;
+        }
+    }
+
+    if (frag || ra) {
+        __u8 why = ra ? VENOM_REASON_RA_UNTRUSTED : VENOM_REASON_FRAGMENT;
+        count_reason(why);
+        if (ev && sampled(ev->suspect_every)) {
+            emit_event(ctx, VENOM_EVT_SUSPECT, why, 0, &src, eth->h_proto, 1);
+        }
+        if ((frag && (redirect & VENOM_XSK_REDIRECT_FRAG)) ||
+            (ra && (redirect & VENOM_XSK_REDIRECT_RA))) {
+            return to_xsk(ctx);
+        }
+    } else if (ev && sampled(ev->sample_every)) {
+        count_reason(VENOM_REASON_RANDOM);
+        emit_event(ctx, VENOM_EVT_SAMPLE, VENOM_REASON_RANDOM, 0, &src, eth->h_proto, 1);
+    }
+    return XDP_PASS;
+}
+
+static __always_inline int guard(struct xdp_md *ctx) {
     void *data_end = (void *)(long)ctx->data_end;
     void *data = (void *)(long)ctx->data;
 
     struct ethhdr *eth = data;
     if ((void *)(eth + 1) > data_end) return XDP_PASS;
 
+    update_stat(VENOM_STAT_INSPECTED);
+
+    __u32 cfg_key = 0;
+    __u32 *cfg = bpf_map_lookup_elem(&xsk_config_map, &cfg_key);
+    __u32 redirect = cfg ? *cfg : 0;
+    struct venom_event_config *ev = bpf_map_lookup_elem(&event_config_map, &cfg_key);
+    struct venom_rate_config *rate = bpf_map_lookup_elem(&rate_config_map, &cfg_key);
+
+    if (eth->h_proto == __constant_htons(ETH_P_ARP)) {
+        update_stat(VENOM_STAT_PROTO_ARP);
+        if (is_trusted_router(eth->h_source)) {
+            count_reason(VENOM_REASON_ROUTER_ARP);
+            return XDP_PASS;
+        }
+        count_reason(VENOM_REASON_ARP_UNTRUSTED);
+
+        if (ev && sampled(ev->suspect_every)) {
+            __u32 sender = 0;
+            if (data + ETH_HLEN + 18 <= data_end) {
+                __builtin_memcpy(&sender, data + ETH_HLEN + 14, 4); // ARP: küldő IP
+            }
+            emit_event(ctx, VENOM_EVT_SUSPECT, VENOM_REASON_ARP_UNTRUSTED, sender, 0, eth->h_proto, 1);
+        }
+        if (redirect & VENOM_XSK_REDIRECT_ARP) return to_xsk(ctx);
+        return XDP_PASS;
+    }
+
     if (eth->h_proto == __constant_htons(ETH_P_IP)) {
+        update_stat(VENOM_STAT_PROTO_IPV4);
         struct iphdr *iph = (void *)(eth + 1);
         if ((void *)(iph + 1) > data_end) return XDP_PASS;
 
-        update_stat(0); // Összes vizsgált IP csomag
-
         __u32 src_ip = iph->saddr;
         __u8 *blocked = bpf_map_lookup_elem(&blacklist_map, &src_ip);
-        
+
+        __u8 reason = 0;
         if (blocked && *blocked == 1) {
-            update_stat(1); // Kernel szinten eldobott (Flushed Bit)
+            reason = VENOM_REASON_BLACKLIST; // Kernel szinten eldobott (Flushed Bit)
+        } else {
+            // Host-találat nélkül a prefixek: a trie a leghosszabb egyezőt adja
+            struct venom_lpm_v4 key = { .prefixlen = 32, .addr = src_ip };
+            __u8 *prefix = bpf_map_lookup_elem(&cidr_blacklist_map, &key);
+            if (prefix && *prefix == 1) reason = VENOM_REASON_CIDR;
+        }
+        if (!reason && rate && rate->cost_ns) {
+            // A vödör kulcsa IPv4-mapped (::ffff:a.b.c.d), a v6 forrásokkal közös táblában
+            struct venom_in6 mapped = {};
+            mapped.addr[10] = 0xff;
+            mapped.addr[11] = 0xff;
+            __builtin_memcpy(&mapped.addr[12], &src_ip, 4);
+            if (rate_exceeded(rate, &mapped)) reason = VENOM_REASON_RATE_LIMIT;
+        }
+        if (reason) {
+            count_reason(reason);
+            if (ev && sampled(ev->drop_every)) {
+                emit_event(ctx, VENOM_EVT_DROP, reason, src_ip, 0, eth->h_proto, 0);
+            }
             return XDP_DROP;
         }
+
+        int frag = (iph->frag_off & __constant_htons(0x3fff)) != 0;   // MF | fragment offset
+        int watched = bpf_map_lookup_elem(&watch_map, &src_ip) != 0;
+
+        if (frag || watched) {
+            count_reason(frag ? VENOM_REASON_FRAGMENT : VENOM_REASON_WATCHED);
+            if (ev && sampled(ev->suspect_every)) {
+                emit_event(ctx, VENOM_EVT_SUSPECT, frag ? VENOM_REASON_FRAGMENT : VENOM_REASON_WATCHED,
+                           src_ip, 0, eth->h_proto, 1);
+            }
+            if ((frag && (redirect & VENOM_XSK_REDIRECT_FRAG)) ||
+                (watched && (redirect & VENOM_XSK_REDIRECT_WATCH))) {
+                return to_xsk(ctx);
+            }
+        } else if (ev && sampled(ev->sample_every)) {
+            count_reason(VENOM_REASON_RANDOM);
+            emit_event(ctx, VENOM_EVT_SAMPLE, VENOM_REASON_RANDOM, src_ip, 0, eth->h_proto, 1);
+        }
+        return XDP_PASS;
     }
+
+    if (eth->h_proto == __constant_htons(ETH_P_IPV6)) {
+        update_stat(VENOM_STAT_PROTO_IPV6);
+        return guard_ipv6(ctx, eth, redirect, ev, rate);
+    }
+
+    update_stat(VENOM_STAT_PROTO_OTHER);
     return XDP_PASS;
 }
 
+SEC("xdp")
+int venom_router_guard(struct xdp_md *ctx) {
+    // Egyetlen kilépési pont: a verdikt-számlálók itt, nem a döntési ágakban
+    int action = guard(ctx);
+    if (action == XDP_DROP) update_stat(VENOM_STAT_DROPPED);
+    else if (action == XDP_REDIRECT) update_stat(VENOM_STAT_REDIRECTED);
+    else update_stat(VENOM_STAT_PASSED);
+    return action;
+}
+
 char _license[] SEC("license") = "GPL";
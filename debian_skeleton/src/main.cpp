@@ -5,6 +5,7 @@
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
 #include <map>
 #include <regex>
 #include <fstream>
@@ -14,6 +15,7 @@
 #include "core/VenomBus.hpp"
 #include "core/Scheduler.hpp"
 #include "core/SocketProbe.hpp"
+#include "core/NetAddress.hpp"
 #include "core/ebpf/BpfLoader.hpp"
 #include "core/VisualMemory.hpp"
 #include "modules/InitSecurityModule.hpp"
@@ -121,8 +123,10 @@ std::string getHeartbeat(int tick) {
 
 int main(int argc, char* argv[]) {
     bool serviceMode = false;
+    bool unload = false;
     for (int i = 1; i < argc; ++i) {
         if (std::string(argv[i]) == "--service") serviceMode = true;
+        if (std::string(argv[i]) == "--unload") unload = true;
     }
 
     std::signal(SIGINT, signalHandler);
@@ -135,35 +139,66 @@ int main(int argc, char* argv[]) {
     Venom::Modules::FilesystemModule fsModule(bus);
     Venom::Core::SocketProbe socketProbe(bus, 8888, Venom::Core::LogLevel::SECURITY_ONLY);
 
+    // A pinelt állapot túléli a folyamatot: leállás után is véd, újraindításkor átvesszük
+    bpfLoader.setPinRoot(Venom::Core::BpfLoader::DEFAULT_PIN_ROOT);
+    if (unload) {
+        bpfLoader.removePinned("wlo1");
+        std::cout << "[+] SHIELD UNLOADED." << std::endl;
+        return 0;
+    }
+
     try {
         { Venom::Modules::InitSecurityModule initMod; initMod.execute(); }
         
         clearScreen();
         drawHeader();
-        secureSetupRouter(bpfLoader);
         
-        if (!bpfLoader.deploy("obj/core/ebpf/venom_shield.bpf.o", "wlo1")) {
+        // A skeletonnal épült binárisban az objektum beágyazva; enélkül a build kimenete
+        const bool deployed = Venom::Core::BpfLoader::hasEmbeddedObject()
+            ? bpfLoader.deployEmbedded("wlo1")
+            : bpfLoader.deploy("obj/core/ebpf/venom_shield.bpf.o", "wlo1");
+        if (!deployed) {
             matrixRed();
             std::cerr << "[!] BPF DEPLOYMENT FAILED!" << std::endl;
             resetColor();
         }
+        // Meleg újraindításnál a router-identitás a pinelt mapben már megvan
+        if (!bpfLoader.isWarmStart() || !bpfLoader.hasRouterIdentity()) {
+            secureSetupRouter(bpfLoader);
+        }
 
+        // Magonként fél partíció: a másik fele a probe-oké és a drain szálé
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        bus.setPartitions(std::clamp<unsigned>(hw / 2, 1, Venom::Core::VenomBus::MAX_PARTITIONS));
         scheduler.start(bus, bpfLoader, vMem);
         bus.startReactive(engine_lifetime, scheduler);
 
         if (serviceMode) {
             socketProbe.start();
+            bpfLoader.startEventChannel(bus);
             int frameCounter = 0;
             uint64_t last_filtered = 0;
+            // A forrásonkénti XDP sebességkorlát a biztonsági profilt és a bus állapotát követi.
+            // Egyetlen író: ez a ciklus, így a rate_config_map írása a detach() előtt véget ér
+            SecurityProfile ratedProfile = bus.getTelemetrySnapshot().current_profile;
+            BusState ratedState = bus.getState();
+            bpfLoader.applyProfile(ratedProfile, ratedState);
 
             while (keepRunning && engine_lifetime.is_subscribed()) {
                 auto snap = bus.getTelemetrySnapshot();
                 auto bpfStats = bpfLoader.getStats();
 
+                if (snap.current_profile != ratedProfile || snap.state != ratedState) {
+                    ratedProfile = snap.current_profile;
+                    ratedState = snap.state;
+                    bpfLoader.applyProfile(ratedProfile, ratedState);
+                }
+
                 if (snap.null_routed > last_filtered) {
                     std::string bad_ip = bus.getLastFilteredIP();
-                    if (!bad_ip.empty()) {
-                        bpfLoader.blockIP(bad_ip);
+                    Venom::Core::NetAddress addr;
+                    if (!bad_ip.empty() && Venom::Core::NetAddress::parse(bad_ip, addr)) {
+                        bpfLoader.queueBlock(addr);
                     }
                     last_filtered = snap.null_routed;
                 }
@@ -174,7 +209,8 @@ int main(int argc, char* argv[]) {
                 std::cout << "\n 💀 "; matrixRed();
                 std::cout << "TOTAL KERNEL DROPS: ";
                 boldWhite();
-                std::cout << bpfStats.dropped_packets << " PKTS" << std::endl;
+                std::cout << bpfStats.dropped_packets << " PKTS";
+                stealthGray(); std::cout << " (rate-limited " << bpfStats.rate_limited << ")" << std::endl;
                 resetColor();
 
                 std::cout << "\n 📡 "; cyberCyan();
@@ -183,6 +219,9 @@ int main(int argc, char* argv[]) {
                 std::cout << "  > ACCEPTED_NODES: "; neonGreen(); std::cout << snap.accepted << std::endl;
                 stealthGray();
                 std::cout << "  > FILTERED_ENTRY: "; matrixRed(); std::cout << snap.null_routed << std::endl;
+                stealthGray();
+                std::cout << "  > KERNEL_EVENTS:  "; cyberCyan(); std::cout << snap.kernel_events;
+                stealthGray(); std::cout << " (lost " << snap.kernel_events_lost << ")" << std::endl;
                 resetColor();
                 
                 std::cout << "\n 💓 HEARTBEAT: "; neonGreen(); 
@@ -18,8 +18,14 @@ constexpr size_t BUF_LEN = 1024 * (EVENT_SIZE + 16);
 
 namespace Venom::Modules {
 
+using Venom::Core::EventOrigin;
+
 FilesystemModule::FilesystemModule(Venom::Core::VenomBus& busRef) 
     : bus(busRef), inotifyFd(-1), keepMonitoring(false) {
+
+    auditSource = bus.registerSource("FS_AUDIT");
+    watchSource = bus.registerSource("FS_WATCH");
+    errorSource = bus.registerSource("FS_ERROR");
     
     // Policy-k definiálása (most már watch flaggel)
     policies = {
@@ -50,13 +56,13 @@ void FilesystemModule::auditPath(const FilesystemPathPolicy& policy) {
     // Események "push"-olása ahelyett, hogy std::cerr-re írnánk
     if (!fs::exists(p)) {
         if (policy.mustExist) {
-            bus.pushEvent("FS_AUDIT", "MISSING_PATH: " + policy.path);
+            bus.pushEvent(auditSource, EventOrigin::FILESYSTEM, {"MISSING_PATH: ", policy.path});
         }
         return;
     }
 
     if (policy.mustBeDirectory && !fs::is_directory(p)) {
-        bus.pushEvent("FS_AUDIT", "TYPE_MISMATCH: " + policy.path);
+        bus.pushEvent(auditSource, EventOrigin::FILESYSTEM, {"TYPE_MISMATCH: ", policy.path});
         return;
     }
 
@@ -64,7 +70,7 @@ void FilesystemModule::auditPath(const FilesystemPathPolicy& policy) {
     bool worldWritable = (perms & fs::perms::others_write) != fs::perms::none;
 
     if (!policy.allowWorldWrite && worldWritable) {
-        bus.pushEvent("FS_AUDIT", "WORLD_WRITABLE: " + policy.path);
+        bus.pushEvent(auditSource, EventOrigin::FILESYSTEM, {"WORLD_WRITABLE: ", policy.path});
     }
 }
 
@@ -73,7 +79,7 @@ void FilesystemModule::startMonitoring() {
 
     inotifyFd = inotify_init();
     if (inotifyFd < 0) {
-        bus.pushEvent("FS_ERROR", "Inotify init failed");
+        bus.pushEvent(errorSource, EventOrigin::FILESYSTEM, "Inotify init failed");
         return;
     }
 
@@ -132,16 +138,16 @@ void FilesystemModule::monitorLoop() {
                 struct inotify_event* event = (struct inotify_event*)&buffer[i];
                 
                 if (event->len) {
-                    std::string filename = event->name;
-                    std::string type;
+                    std::string_view filename(event->name);
+                    std::string_view type;
                     
                     if (event->mask & IN_CREATE) type = "CREATED";
                     else if (event->mask & IN_DELETE) type = "DELETED";
                     else if (event->mask & IN_MODIFY) type = "MODIFIED";
                     else type = "UNKNOWN";
 
-                    // BEDOBJUK A VENT BUS-BA! 👁️ -> 🧠
-                    bus.pushEvent("FS_WATCH", type + ": " + filename);
+                    // BEDOBJUK A VENT BUS-BA! 👁️ -> 🧠 (összefűzés a pool-blokkban, heap nélkül)
+                    bus.pushEvent(watchSource, EventOrigin::FILESYSTEM, {type, ": ", filename});
                 }
                 i += EVENT_SIZE + event->len;
             }
@@ -12,6 +12,7 @@ BusTelemetry::BusTelemetry()
 
 void BusTelemetry::reset_window() {
     peak_queue_depth.store(queue_depth.load());
+    for (auto& q : qos) q.max_wait_ns.store(0, std::memory_order_relaxed);
     window_start = std::chrono::steady_clock::now();
 }
 
@@ -46,8 +47,41 @@ TelemetrySnapshot BusTelemetry::snapshot() const {
     snap.queue_peak    = peak_queue_depth.load();
 
     snap.state = state.load();
+    snap.overload_delay_ms = static_cast<double>(overload_delay_us.load(std::memory_order_relaxed)) / 1000.0;
+    snap.drain_rate = drain_rate.load(std::memory_order_relaxed);
+    snap.state_transitions = state_transitions.load(std::memory_order_relaxed);
     snap.current_profile = current_profile.load();
 
+    // Shard eloszlás: a leglassabb mag határozza meg a skálázást, ezért max/átlag
+    snap.shard_count = shard_count.load();
+    uint64_t shardSum = 0, shardMax = 0;
+    for (uint32_t i = 0; i < snap.shard_count; ++i) {
+        uint64_t a = shard_accepts[i].accepts.load(std::memory_order_relaxed);
+        snap.shard_accepts[i] = a;
+        shardSum += a;
+        if (a > shardMax) shardMax = a;
+    }
+    snap.shard_imbalance = (shardSum > 0)
+        ? static_cast<double>(shardMax) * snap.shard_count / static_cast<double>(shardSum)
+        : 1.0;
+
+    // A network beküldött száma a maradék: a hot path nem számol osztályonként
+    uint64_t critical = 0;
+    for (uint32_t c = 0; c < TELEMETRY_QOS_CLASSES; ++c) {
+        const QosCounter& q = qos[c];
+        if (c + 1 < TELEMETRY_QOS_CLASSES) {
+            snap.qos_events[c] = q.events.load(std::memory_order_relaxed);
+            critical += snap.qos_events[c];
+        }
+        snap.qos_shed[c] = q.shed.load(std::memory_order_relaxed);
+        snap.qos_overflow[c] = q.overflow.load(std::memory_order_relaxed);
+        snap.qos_max_wait_ms[c] = static_cast<double>(q.max_wait_ns.load(std::memory_order_relaxed)) / 1e6;
+    }
+    snap.qos_events[TELEMETRY_QOS_CLASSES - 1] = snap.total > critical ? snap.total - critical : 0;
+
+    snap.kernel_events = kernel_events.load(std::memory_order_relaxed);
+    snap.kernel_events_lost = kernel_events_lost.load(std::memory_order_relaxed);
+
     snap.window_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - window_start